@@ -0,0 +1,5 @@
+#!/bin/bash
+
+# Runs the seed corpus through the fuzz target. Pass a directory of saved findings to check them instead.
+python3 utils/make_fuzz_corpus.py build/fuzz_corpus
+./build/fuzz_parse_program "${@:-build/fuzz_corpus}"
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <string>
 
@@ -14,8 +15,12 @@ namespace ast {
 
 namespace x3 = boost::spirit::x3;
 
+// Id of a command, environment or macro name in the SymbolTable the program was parsed with (see symbol_table.h).
+using SymbolId = std::uint32_t;
+
 struct Program;
 struct PlainText;
+struct HtmlEntity;
 struct Paragraph;
 struct ParagraphBreaker;
 struct Argument;
@@ -45,6 +50,7 @@ struct ProgramNode : x3::variant<x3::forward_ast<ParagraphBreaker>,
 };
 
 struct ParagraphNode : x3::variant<x3::forward_ast<PlainText>,
+                                   x3::forward_ast<HtmlEntity>,
                                    x3::forward_ast<InlinedMathText>,
                                    x3::forward_ast<Command>,
                                    x3::forward_ast<UnescapedCommand>,
@@ -54,6 +60,7 @@ struct ParagraphNode : x3::variant<x3::forward_ast<PlainText>,
 };
 
 struct ArgumentNode : x3::variant<x3::forward_ast<PlainText>,
+                                  x3::forward_ast<HtmlEntity>,
                                   x3::forward_ast<InlinedMathText>,
                                   x3::forward_ast<Command>,
                                   x3::forward_ast<UnescapedCommand>,
@@ -64,6 +71,9 @@ struct ArgumentNode : x3::variant<x3::forward_ast<PlainText>,
   using base_type::operator=;
 };
 
+// For every node parsed by grammar::program, id_first and id_last of x3::position_tagged hold the byte offsets of
+// the node in the input: [id_first, id_last). Workspaces parse the input after line ending normalization (see
+// utils/utf8_utils.h), so the offsets refer to the normalized input.
 struct Program : x3::position_tagged {
   std::list<ProgramNode> nodes;
 };
@@ -72,6 +82,12 @@ struct PlainText : x3::position_tagged {
   std::string text;
 };
 
+// Named character reference of HTML5, e.g. "&mdash;", whose name has been checked by the grammar. Text producing the
+// same characters otherwise, e.g. "\&lt;", is plain text.
+struct HtmlEntity : x3::position_tagged {
+  std::string text;
+};
+
 struct Paragraph : x3::position_tagged {
   std::list<ParagraphNode> nodes;
 };
@@ -99,14 +115,14 @@ struct MathText : x3::position_tagged {
 };
 
 struct CommandMacro : x3::position_tagged {
-  std::string name;
+  SymbolId name;
   boost::optional<int> arguments_num;
   std::list<Argument> default_arguments;
   Argument body;
 };
 
 struct EnvironmentMacro : x3::position_tagged {
-  std::string name;
+  SymbolId name;
   boost::optional<int> arguments_num;
   std::list<Argument> default_arguments;
   Program pre_program;
@@ -114,7 +130,7 @@ struct EnvironmentMacro : x3::position_tagged {
 };
 
 struct Command : x3::position_tagged {
-  std::string name;
+  SymbolId name;
   std::list<Argument> default_arguments;
   std::list<Argument> arguments;
 };
@@ -128,11 +144,11 @@ struct NparagraphCommand : x3::position_tagged {
 };
 
 struct Environment : x3::position_tagged {
-  std::string name;
+  SymbolId name;
   std::list<Argument> default_arguments;
   std::list<Argument> arguments;
   Program program;
-  std::string end_name;
+  SymbolId end_name;
 };
 
 struct VerbatimEnvironment : x3::position_tagged {
@@ -12,6 +12,8 @@ BOOST_FUSION_ADAPT_STRUCT(lightex::ast::Program, (std::list<lightex::ast::Progra
 
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::PlainText, (std::string, text))
 
+BOOST_FUSION_ADAPT_STRUCT(lightex::ast::HtmlEntity, (std::string, text))
+
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::Paragraph, (std::list<lightex::ast::ParagraphNode>, nodes))
 
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::ParagraphBreaker)
@@ -27,20 +29,20 @@ BOOST_FUSION_ADAPT_STRUCT(lightex::ast::InlinedMathText, (std::string, text))
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::MathText, (std::string, text))
 
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::CommandMacro,
-                          (std::string, name),
+                          (lightex::ast::SymbolId, name),
                           (boost::optional<int>, arguments_num),
                           (std::list<lightex::ast::Argument>, default_arguments),
                           (lightex::ast::Argument, body))
 
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::EnvironmentMacro,
-                          (std::string, name),
+                          (lightex::ast::SymbolId, name),
                           (boost::optional<int>, arguments_num),
                           (std::list<lightex::ast::Argument>, default_arguments),
                           (lightex::ast::Program, pre_program),
                           (lightex::ast::Program, post_program))
 
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::Command,
-                          (std::string, name),
+                          (lightex::ast::SymbolId, name),
                           (std::list<lightex::ast::Argument>, default_arguments),
                           (std::list<lightex::ast::Argument>, arguments))
 
@@ -49,10 +51,10 @@ BOOST_FUSION_ADAPT_STRUCT(lightex::ast::UnescapedCommand, (lightex::ast::Argumen
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::NparagraphCommand, (lightex::ast::Argument, body))
 
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::Environment,
-                          (std::string, name),
+                          (lightex::ast::SymbolId, name),
                           (std::list<lightex::ast::Argument>, default_arguments),
                           (std::list<lightex::ast::Argument>, arguments),
                           (lightex::ast::Program, program),
-                          (std::string, end_name))
+                          (lightex::ast::SymbolId, end_name))
 
 BOOST_FUSION_ADAPT_STRUCT(lightex::ast::VerbatimEnvironment, (std::string, content))
@@ -0,0 +1,47 @@
+#include <lightex/ast/symbol_table.h>
+
+namespace lightex {
+namespace ast {
+
+SymbolTable::SymbolTable(const SymbolTable* base)
+    : base_(base), first_id_(base ? static_cast<SymbolId>(base->GetSize()) : 0) {}
+
+SymbolTable::SymbolTable(const SymbolTable& other) : base_(other.base_), first_id_(other.first_id_) {
+  std::unique_lock<std::mutex> lock(other.mtx_);
+  ids_ = other.ids_;
+  names_.resize(ids_.size());
+  for (const auto& id : ids_) {
+    names_[id.second - first_id_] = &id.first;
+  }
+}
+
+SymbolId SymbolTable::Intern(const std::string& name) {
+  for (const SymbolTable* base = base_; base; base = base->base_) {
+    const auto base_id = base->ids_.find(name);
+    if (base_id != base->ids_.end()) {
+      return base_id->second;
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(mtx_);
+  const auto inserted = ids_.emplace(name, static_cast<SymbolId>(first_id_ + names_.size()));
+  if (inserted.second) {
+    names_.push_back(&inserted.first->first);
+  }
+  return inserted.first->second;
+}
+
+const std::string& SymbolTable::GetName(SymbolId id) const {
+  if (id < first_id_) {
+    return base_->GetName(id);
+  }
+  return *names_.at(id - first_id_);
+}
+
+std::size_t SymbolTable::GetSize() const {
+  std::unique_lock<std::mutex> lock(mtx_);
+  return first_id_ + names_.size();
+}
+
+}  // namespace ast
+}  // namespace lightex
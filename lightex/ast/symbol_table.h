@@ -0,0 +1,43 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <lightex/ast/ast.h>
+
+namespace lightex {
+namespace ast {
+
+// Names of commands, environments and macros, stored once and referred to from the AST by SymbolId. A table made on
+// top of a base table gives the names of the base the same ids and stores only the other ones, so that parsing a
+// request doesn't grow the table of the style it's rendered with.
+class SymbolTable {
+ public:
+  SymbolTable() = default;
+  // |base| must outlive the table, and no names may be interned into it anymore.
+  explicit SymbolTable(const SymbolTable* base);
+  // Copies have the same ids.
+  SymbolTable(const SymbolTable& other);
+  SymbolTable& operator=(const SymbolTable&) = delete;
+
+  // Safe to call from several threads.
+  SymbolId Intern(const std::string& name);
+  // Doesn't lock, so it must not be called while names are interned into the table.
+  const std::string& GetName(SymbolId id) const;
+
+  std::size_t GetSize() const;
+
+ private:
+  const SymbolTable* base_ = nullptr;
+  // Ids of the table start after those of the base.
+  SymbolId first_id_ = 0;
+
+  mutable std::mutex mtx_;
+  std::unordered_map<std::string, SymbolId> ids_;
+  std::vector<const std::string*> names_;  // Point to the keys of |ids_|.
+};
+
+}  // namespace ast
+}  // namespace lightex
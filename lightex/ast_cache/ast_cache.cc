@@ -0,0 +1,218 @@
+#include <lightex/ast_cache/ast_cache.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <lightex/ast_exporter/ast_exporter.h>
+#include <lightex/ast_exporter/ast_reader.h>
+#include <lightex/grammar/grammar_version.h>
+#include <lightex/utils/sha256.h>
+
+namespace lightex {
+namespace ast_cache {
+namespace {
+
+const char kEntryExtension[] = ".ast";
+bool HasEntryExtension(const std::string& file_name) {
+  const std::size_t extension_size = sizeof(kEntryExtension) - 1;
+  return file_name.size() > extension_size &&
+         file_name.compare(file_name.size() - extension_size, extension_size, kEntryExtension) == 0;
+}
+
+struct EntryInfo {
+  std::string path;
+  std::uint64_t size_bytes;
+  time_t last_used_time;
+};
+
+std::vector<EntryInfo> ListEntries(const std::string& directory) {
+  std::vector<EntryInfo> entries;
+
+  DIR* dir = opendir(directory.c_str());
+  if (!dir) {
+    return entries;
+  }
+
+  while (dirent* entry = readdir(dir)) {
+    const std::string file_name = entry->d_name;
+    if (!HasEntryExtension(file_name)) {
+      continue;
+    }
+
+    const std::string path = directory + "/" + file_name;
+    struct stat entry_stat;
+    if (stat(path.c_str(), &entry_stat) == 0 && S_ISREG(entry_stat.st_mode)) {
+      entries.push_back({path, static_cast<std::uint64_t>(entry_stat.st_size), entry_stat.st_mtime});
+    }
+  }
+  closedir(dir);
+
+  return entries;
+}
+}  // namespace
+
+AstCache::AstCache(const std::string& directory, std::uint64_t max_size_bytes)
+    : directory_(directory), max_size_bytes_(max_size_bytes) {}
+
+bool AstCache::Initialize(std::string* error_message) {
+  if (mkdir(directory_.c_str(), 0755) != 0 && errno != EEXIST) {
+    if (error_message) {
+      *error_message = "Failed to create AST cache directory " + directory_ + ": " + std::strerror(errno);
+    }
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(mtx_);
+  size_bytes_ = 0;
+  for (const auto& entry : ListEntries(directory_)) {
+    size_bytes_ += entry.size_bytes;
+  }
+  TrimToMaxSize();
+
+  return true;
+}
+
+bool AstCache::Load(const std::string& input, ast::SymbolTable* symbol_table, ast::Program* output) {
+  if (!output) {
+    return false;
+  }
+
+  const std::string path = GetEntryPath(input);
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  bool is_loaded = false;
+  struct stat entry_stat;
+  if (fstat(fd, &entry_stat) == 0 && entry_stat.st_size > 0) {
+    const std::size_t size = static_cast<std::size_t>(entry_stat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      ast::Program program;
+      if (ast_exporter::ReadBinaryAst(static_cast<const char*>(data), size, symbol_table, &program)) {
+        *output = std::move(program);
+        is_loaded = true;
+      }
+      munmap(data, size);
+    }
+  }
+  close(fd);
+
+  if (is_loaded) {
+    // Refreshes modification time, which serves as the last use time for eviction.
+    utime(path.c_str(), nullptr);
+  }
+  return is_loaded;
+}
+
+void AstCache::Store(const std::string& input, const ast::SymbolTable& symbol_table, const ast::Program& program) {
+  static std::atomic<unsigned> temporary_files_num(0);
+
+  const std::string path = GetEntryPath(input);
+  const std::string temporary_path =
+      path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(temporary_files_num++);
+
+  std::uint64_t entry_size_bytes;
+  {
+    std::ofstream out(temporary_path, std::ios::binary);
+    if (!out) {
+      return;
+    }
+
+    ast_exporter::AstExporter exporter(ast_exporter::Format::kBinary, ast_exporter::kUnlimitedDepth, &symbol_table,
+                                       &out);
+    exporter(program);
+    entry_size_bytes = static_cast<std::uint64_t>(out.tellp());
+    if (!out) {
+      out.close();
+      std::remove(temporary_path.c_str());
+      return;
+    }
+  }
+
+  // Renaming is atomic, so concurrent readers never see a partially written entry.
+  if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    std::remove(temporary_path.c_str());
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mtx_);
+  size_bytes_ += entry_size_bytes;
+  if (size_bytes_ > max_size_bytes_) {
+    TrimToMaxSize();
+  }
+}
+
+bool AstCache::Clear(std::string* error_message) {
+  std::unique_lock<std::mutex> lock(mtx_);
+
+  bool is_successful = true;
+  for (const auto& entry : ListEntries(directory_)) {
+    if (std::remove(entry.path.c_str()) != 0 && errno != ENOENT) {
+      if (error_message) {
+        *error_message = "Failed to remove AST cache entry " + entry.path + ": " + std::strerror(errno);
+      }
+      is_successful = false;
+    }
+  }
+  size_bytes_ = 0;
+
+  return is_successful;
+}
+
+std::uint64_t AstCache::GetSizeBytes() const {
+  std::unique_lock<std::mutex> lock(mtx_);
+  return size_bytes_;
+}
+
+std::string AstCache::GetEntryPath(const std::string& input) const {
+  // Entries of different documents may share the directory, so the name must not collide even for crafted inputs.
+  std::ostringstream key;
+  key << grammar::kGrammarVersion << '.' << static_cast<int>(ast_exporter::kBinaryVersion) << '.' << input.size()
+      << '.';
+
+  utils::Sha256 hasher;
+  hasher.Update(key.str());
+  hasher.Update(input);
+  return directory_ + "/" + hasher.FinishHex() + kEntryExtension;
+}
+
+void AstCache::TrimToMaxSize() {
+  // Other processes may share the directory, so the actual state of the directory is the source of truth.
+  std::vector<EntryInfo> entries = ListEntries(directory_);
+  std::sort(entries.begin(), entries.end(),
+            [](const EntryInfo& a, const EntryInfo& b) { return a.last_used_time < b.last_used_time; });
+
+  size_bytes_ = 0;
+  for (const auto& entry : entries) {
+    size_bytes_ += entry.size_bytes;
+  }
+
+  for (const auto& entry : entries) {
+    if (size_bytes_ <= max_size_bytes_) {
+      break;
+    }
+    if (std::remove(entry.path.c_str()) == 0) {
+      size_bytes_ -= entry.size_bytes;
+    }
+  }
+}
+
+}  // namespace ast_cache
+}  // namespace lightex
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <lightex/ast/ast.h>
+#include <lightex/ast/symbol_table.h>
+
+namespace lightex {
+namespace ast_cache {
+
+// On-disk cache of parsed programs. Every entry is the binary AST export of an input (see
+// ast_exporter/ast_exporter.h), stored in a file named after the SHA-256 digest of the input content and the grammar
+// version. Entries are memory mapped on load. Once the total size of the entries exceeds the limit, the least recently
+// used ones are removed.
+//
+// The cache is safe to use from several threads and processes at once: entries are written atomically and a broken
+// or missing entry is just a cache miss.
+class AstCache {
+ public:
+  AstCache(const std::string& directory, std::uint64_t max_size_bytes);
+
+  // Creates the cache directory if needed and computes the current size of the cache.
+  bool Initialize(std::string* error_message);
+
+  // Names in the programs are ids in |symbol_table|, entries store them as strings.
+  bool Load(const std::string& input, ast::SymbolTable* symbol_table, ast::Program* output);
+  void Store(const std::string& input, const ast::SymbolTable& symbol_table, const ast::Program& program);
+
+  // Removes every entry of the cache.
+  bool Clear(std::string* error_message);
+
+  std::uint64_t GetSizeBytes() const;
+
+ private:
+  std::string GetEntryPath(const std::string& input) const;
+  void TrimToMaxSize();
+
+  std::string directory_;
+  std::uint64_t max_size_bytes_;
+
+  mutable std::mutex mtx_;
+  std::uint64_t size_bytes_ = 0;
+};
+
+}  // namespace ast_cache
+}  // namespace lightex
@@ -0,0 +1,285 @@
+#include <lightex/ast_exporter/ast_exporter.h>
+
+#include <lightex/utils/json_utils.h>
+
+// Binary format:
+//   file := kBinaryMagic (4 bytes) kBinaryVersion (1 byte) node
+//   node := tag (1 byte) varint(id_first + 1) varint(id_last + 1) payload | kTruncatedTag (1 byte)
+//   list := varint(size) node*
+//   string := varint(size) bytes
+//   int := zigzag encoded varint
+//   optional int := varint(0) | varint(1) int
+// Payloads hold the string and int fields of the node in the order of ast_adapted.h, followed by its children (lists
+// of nodes as lists, single child nodes as nodes), again in the order of ast_adapted.h.
+
+namespace lightex {
+namespace ast_exporter {
+namespace {
+
+template <typename Visitor, typename Node>
+void Visit(Visitor& visitor, const Node& node) {
+  visitor(node);
+}
+
+template <typename Visitor>
+void Visit(Visitor& visitor, const ast::ProgramNode& node) {
+  boost::apply_visitor(visitor, node);
+}
+
+template <typename Visitor>
+void Visit(Visitor& visitor, const ast::ParagraphNode& node) {
+  boost::apply_visitor(visitor, node);
+}
+
+template <typename Visitor>
+void Visit(Visitor& visitor, const ast::ArgumentNode& node) {
+  boost::apply_visitor(visitor, node);
+}
+}  // namespace
+
+AstExporter::AstExporter(Format format,
+                         int max_depth,
+                         const ast::SymbolTable* symbol_table,
+                         std::ostream* output)
+    : format_(format), max_depth_(max_depth), symbol_table_(symbol_table), output_(output) {}
+
+void AstExporter::operator()(const ast::Program& program) {
+  if (BeginNode(kProgramTag, "PROGRAM", program)) {
+    WriteChildren("node", program.nodes);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::PlainText& plain_text) {
+  if (BeginNode(kPlainTextTag, "PLAIN_TEXT", plain_text)) {
+    WriteString("text", plain_text.text);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::HtmlEntity& html_entity) {
+  if (BeginNode(kHtmlEntityTag, "HTML_ENTITY", html_entity)) {
+    WriteString("text", html_entity.text);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::Paragraph& paragraph) {
+  if (BeginNode(kParagraphTag, "PARAGRAPH", paragraph)) {
+    WriteChildren("node", paragraph.nodes);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::ParagraphBreaker& paragraph_breaker) {
+  if (BeginNode(kParagraphBreakerTag, "PARAGRAPH_BREAKER", paragraph_breaker)) {
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::Argument& argument) {
+  if (BeginNode(kArgumentTag, "ARGUMENT", argument)) {
+    WriteChildren("node", argument.nodes);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::ArgumentRef& argument_ref) {
+  if (BeginNode(kArgumentRefTag, "ARGUMENT_REF", argument_ref)) {
+    WriteInt("argument_id", argument_ref.argument_id);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::OuterArgumentRef& outer_argument_ref) {
+  if (BeginNode(kOuterArgumentRefTag, "OUTER_ARGUMENT_REF", outer_argument_ref)) {
+    WriteInt("argument_id", outer_argument_ref.argument_id);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::InlinedMathText& math_text) {
+  if (BeginNode(kInlinedMathTextTag, "INLINED_MATH_TEXT", math_text)) {
+    WriteString("text", math_text.text);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::MathText& math_text) {
+  if (BeginNode(kMathTextTag, "MATH_TEXT", math_text)) {
+    WriteString("text", math_text.text);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::CommandMacro& command_macro) {
+  if (BeginNode(kCommandMacroTag, "COMMAND_MACRO", command_macro)) {
+    WriteSymbol("name", command_macro.name);
+    WriteOptionalInt("arguments_num", command_macro.arguments_num);
+    WriteChildren("default_argument", command_macro.default_arguments);
+    WriteChild("body", command_macro.body);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::EnvironmentMacro& environment_macro) {
+  if (BeginNode(kEnvironmentMacroTag, "ENVIRONMENT_MACRO", environment_macro)) {
+    WriteSymbol("name", environment_macro.name);
+    WriteOptionalInt("arguments_num", environment_macro.arguments_num);
+    WriteChildren("default_argument", environment_macro.default_arguments);
+    WriteChild("pre_program", environment_macro.pre_program);
+    WriteChild("post_program", environment_macro.post_program);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::Command& command) {
+  if (BeginNode(kCommandTag, "COMMAND", command)) {
+    WriteSymbol("name", command.name);
+    WriteChildren("default_argument", command.default_arguments);
+    WriteChildren("argument", command.arguments);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::UnescapedCommand& unescaped_command) {
+  if (BeginNode(kUnescapedCommandTag, "UNESCAPED_COMMAND", unescaped_command)) {
+    WriteChild("body", unescaped_command.body);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::NparagraphCommand& nparagraph_command) {
+  if (BeginNode(kNparagraphCommandTag, "NPARAGRAPH_COMMAND", nparagraph_command)) {
+    WriteChild("body", nparagraph_command.body);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::Environment& environment) {
+  if (BeginNode(kEnvironmentTag, "ENVIRONMENT", environment)) {
+    WriteSymbol("name", environment.name);
+    WriteSymbol("end_name", environment.end_name);
+    WriteChildren("default_argument", environment.default_arguments);
+    WriteChildren("argument", environment.arguments);
+    WriteChild("program", environment.program);
+    EndNode();
+  }
+}
+
+void AstExporter::operator()(const ast::VerbatimEnvironment& verbatim_environment) {
+  if (BeginNode(kVerbatimEnvironmentTag, "VERBATIM_ENVIRONMENT", verbatim_environment)) {
+    WriteString("content", verbatim_environment.content);
+    EndNode();
+  }
+}
+
+bool AstExporter::BeginNode(std::uint8_t tag, const char* type, const ast::x3::position_tagged& node) {
+  const int depth = static_cast<int>(parent_ids_.size());
+  if (max_depth_ != kUnlimitedDepth && depth > max_depth_) {
+    if (format_ == Format::kBinary) {
+      output_->put(static_cast<char>(kTruncatedTag));
+    }
+    return false;
+  }
+
+  const int node_id = next_node_id_++;
+  if (format_ == Format::kJson) {
+    CloseJsonLine();
+    *output_ << "{\"id\":" << node_id << ",\"parent\":" << (parent_ids_.empty() ? -1 : parent_ids_.back())
+             << ",\"role\":\"" << role_ << "\",\"type\":\"" << type << '"';
+    if (node.id_first >= 0) {
+      *output_ << ",\"first\":" << node.id_first << ",\"last\":" << node.id_last;
+    }
+    json_line_is_open_ = true;
+  } else {
+    if (node_id == 0) {
+      output_->write(kBinaryMagic, sizeof(kBinaryMagic) - 1);
+      output_->put(static_cast<char>(kBinaryVersion));
+    }
+    output_->put(static_cast<char>(tag));
+    WriteVarint(static_cast<std::uint64_t>(node.id_first + 1));
+    WriteVarint(static_cast<std::uint64_t>(node.id_last + 1));
+  }
+
+  parent_ids_.push_back(node_id);
+  return true;
+}
+
+void AstExporter::EndNode() {
+  CloseJsonLine();
+  parent_ids_.pop_back();
+}
+
+void AstExporter::WriteString(const char* key, const std::string& value) {
+  if (format_ == Format::kJson) {
+    *output_ << ",\"" << key << "\":";
+    utils::WriteJsonString(value, output_);
+  } else {
+    WriteVarint(value.size());
+    output_->write(value.data(), value.size());
+  }
+}
+
+// Symbol ids are local to a symbol table, so names are written as strings, which keeps the format self-contained.
+void AstExporter::WriteSymbol(const char* key, ast::SymbolId value) {
+  WriteString(key, symbol_table_->GetName(value));
+}
+
+void AstExporter::WriteInt(const char* key, int value) {
+  if (format_ == Format::kJson) {
+    *output_ << ",\"" << key << "\":" << value;
+  } else {
+    // Zigzag encoding keeps small negative values short.
+    const std::int64_t extended = value;
+    WriteVarint((static_cast<std::uint64_t>(extended) << 1) ^ static_cast<std::uint64_t>(extended >> 63));
+  }
+}
+
+void AstExporter::WriteOptionalInt(const char* key, const boost::optional<int>& value) {
+  if (format_ == Format::kJson) {
+    if (value) {
+      WriteInt(key, *value);
+    }
+  } else {
+    WriteVarint(value ? 1 : 0);
+    if (value) {
+      WriteInt(key, *value);
+    }
+  }
+}
+
+template <typename Node>
+void AstExporter::WriteChild(const char* role, const Node& node) {
+  role_ = role;
+  Visit(*this, node);
+}
+
+template <typename Node>
+void AstExporter::WriteChildren(const char* role, const std::list<Node>& nodes) {
+  if (format_ == Format::kBinary) {
+    WriteVarint(nodes.size());
+  }
+
+  for (const auto& node : nodes) {
+    WriteChild(role, node);
+  }
+}
+
+void AstExporter::CloseJsonLine() {
+  if (json_line_is_open_) {
+    *output_ << "}\n";
+    json_line_is_open_ = false;
+  }
+}
+
+void AstExporter::WriteVarint(std::uint64_t value) {
+  while (value >= 0x80) {
+    output_->put(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  output_->put(static_cast<char>(value));
+}
+
+}  // namespace ast_exporter
+}  // namespace lightex
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <lightex/ast/ast.h>
+#include <lightex/ast/symbol_table.h>
+
+#include <boost/variant/static_visitor.hpp>
+
+namespace lightex {
+namespace ast_exporter {
+
+enum class Format {
+  // One JSON object per line and per node:
+  //   {"id":1,"parent":0,"role":"node","type":"PLAIN_TEXT","first":0,"last":5,"text":"hello"}
+  // Node ids are pre-order indices, the root has "parent":-1. "first" and "last" are byte offsets of the node in
+  // the input and are omitted if unknown.
+  kJson,
+
+  // Pre-order binary encoding, see the comment in ast_exporter.cc. It is lossless unless depth limited, so it can
+  // be read back into an ast::Program.
+  kBinary,
+};
+
+const int kUnlimitedDepth = -1;
+
+// Node tags of the binary format.
+enum BinaryTag : std::uint8_t {
+  kTruncatedTag = 0,
+  kProgramTag,
+  kPlainTextTag,
+  kParagraphTag,
+  kParagraphBreakerTag,
+  kArgumentTag,
+  kArgumentRefTag,
+  kOuterArgumentRefTag,
+  kInlinedMathTextTag,
+  kMathTextTag,
+  kCommandMacroTag,
+  kEnvironmentMacroTag,
+  kCommandTag,
+  kUnescapedCommandTag,
+  kNparagraphCommandTag,
+  kEnvironmentTag,
+  kVerbatimEnvironmentTag,
+  kHtmlEntityTag,
+};
+
+const char kBinaryMagic[] = "LTXA";
+const std::uint8_t kBinaryVersion = 2;
+
+// Streams the AST into |output| node by node, without building the whole representation in memory. Nodes deeper
+// than |max_depth| (the root has depth 0) are not exported. Names are exported as strings from |symbol_table|.
+class AstExporter : public boost::static_visitor<void> {
+ public:
+  AstExporter(Format format, int max_depth, const ast::SymbolTable* symbol_table, std::ostream* output);
+
+  void operator()(const ast::Program& program);
+  void operator()(const ast::PlainText& plain_text);
+  void operator()(const ast::HtmlEntity& html_entity);
+  void operator()(const ast::Paragraph& paragraph);
+  void operator()(const ast::ParagraphBreaker& paragraph_breaker);
+  void operator()(const ast::Argument& argument);
+  void operator()(const ast::ArgumentRef& argument_ref);
+  void operator()(const ast::OuterArgumentRef& outer_argument_ref);
+  void operator()(const ast::InlinedMathText& inlined_math_text);
+  void operator()(const ast::MathText& math_text);
+  void operator()(const ast::CommandMacro& command_macro);
+  void operator()(const ast::EnvironmentMacro& environment_macro);
+  void operator()(const ast::Command& command);
+  void operator()(const ast::UnescapedCommand& unescaped_command);
+  void operator()(const ast::NparagraphCommand& nparagraph_command);
+  void operator()(const ast::Environment& environment);
+  void operator()(const ast::VerbatimEnvironment& verbatim_environment);
+
+ private:
+  // Returns false if the node is too deep to be exported; nothing but a truncation marker is written then.
+  bool BeginNode(std::uint8_t tag, const char* type, const ast::x3::position_tagged& node);
+  void EndNode();
+
+  void WriteString(const char* key, const std::string& value);
+  void WriteSymbol(const char* key, ast::SymbolId value);
+  void WriteInt(const char* key, int value);
+  void WriteOptionalInt(const char* key, const boost::optional<int>& value);
+
+  template <typename Node>
+  void WriteChild(const char* role, const Node& node);
+  template <typename Node>
+  void WriteChildren(const char* role, const std::list<Node>& nodes);
+
+  void CloseJsonLine();
+  void WriteVarint(std::uint64_t value);
+
+  Format format_;
+  int max_depth_;
+  const ast::SymbolTable* symbol_table_;  // Not owned.
+  std::ostream* output_;                  // Not owned.
+
+  int next_node_id_ = 0;
+  const char* role_ = "root";
+  std::vector<int> parent_ids_;
+  bool json_line_is_open_ = false;
+};
+
+}  // namespace ast_exporter
+}  // namespace lightex
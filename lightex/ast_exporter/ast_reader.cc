@@ -0,0 +1,296 @@
+#include <lightex/ast_exporter/ast_reader.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <string>
+
+#include <lightex/ast_exporter/ast_exporter.h>
+
+namespace lightex {
+namespace ast_exporter {
+namespace {
+
+class BinaryReader {
+ public:
+  BinaryReader(const char* data, std::size_t size, ast::SymbolTable* symbol_table)
+      : data_(data), size_(size), symbol_table_(symbol_table) {}
+
+  bool ReadHeader() {
+    const std::size_t magic_size = sizeof(kBinaryMagic) - 1;
+    if (size_ < magic_size + 1 || std::memcmp(data_, kBinaryMagic, magic_size) != 0 ||
+        static_cast<std::uint8_t>(data_[magic_size]) != kBinaryVersion) {
+      return false;
+    }
+
+    position_ = magic_size + 1;
+    return true;
+  }
+
+  bool IsAtEnd() const { return position_ == size_; }
+
+  template <typename Node>
+  bool ReadNode(BinaryTag expected_tag, Node* node) {
+    std::uint8_t tag;
+    return ReadTag(&tag) && tag == expected_tag && ReadPosition(node) && ReadPayload(node);
+  }
+
+  bool ReadNode(ast::Program* node) { return ReadNode(kProgramTag, node); }
+  bool ReadNode(ast::Argument* node) { return ReadNode(kArgumentTag, node); }
+
+  bool ReadNode(ast::ProgramNode* node) {
+    std::uint8_t tag;
+    if (!ReadTag(&tag)) {
+      return false;
+    }
+
+    switch (tag) {
+      case kParagraphBreakerTag:
+        return ReadAlternative<ast::ParagraphBreaker>(node);
+      case kParagraphTag:
+        return ReadAlternative<ast::Paragraph>(node);
+      case kMathTextTag:
+        return ReadAlternative<ast::MathText>(node);
+      case kEnvironmentTag:
+        return ReadAlternative<ast::Environment>(node);
+      case kVerbatimEnvironmentTag:
+        return ReadAlternative<ast::VerbatimEnvironment>(node);
+      case kCommandMacroTag:
+        return ReadAlternative<ast::CommandMacro>(node);
+      case kEnvironmentMacroTag:
+        return ReadAlternative<ast::EnvironmentMacro>(node);
+      case kArgumentRefTag:
+        return ReadAlternative<ast::ArgumentRef>(node);
+      case kOuterArgumentRefTag:
+        return ReadAlternative<ast::OuterArgumentRef>(node);
+      default:
+        return false;
+    }
+  }
+
+  bool ReadNode(ast::ParagraphNode* node) {
+    std::uint8_t tag;
+    if (!ReadTag(&tag)) {
+      return false;
+    }
+
+    switch (tag) {
+      case kPlainTextTag:
+        return ReadAlternative<ast::PlainText>(node);
+      case kHtmlEntityTag:
+        return ReadAlternative<ast::HtmlEntity>(node);
+      case kInlinedMathTextTag:
+        return ReadAlternative<ast::InlinedMathText>(node);
+      case kCommandTag:
+        return ReadAlternative<ast::Command>(node);
+      case kUnescapedCommandTag:
+        return ReadAlternative<ast::UnescapedCommand>(node);
+      case kNparagraphCommandTag:
+        return ReadAlternative<ast::NparagraphCommand>(node);
+      default:
+        return false;
+    }
+  }
+
+  bool ReadNode(ast::ArgumentNode* node) {
+    std::uint8_t tag;
+    if (!ReadTag(&tag)) {
+      return false;
+    }
+
+    switch (tag) {
+      case kPlainTextTag:
+        return ReadAlternative<ast::PlainText>(node);
+      case kHtmlEntityTag:
+        return ReadAlternative<ast::HtmlEntity>(node);
+      case kInlinedMathTextTag:
+        return ReadAlternative<ast::InlinedMathText>(node);
+      case kCommandTag:
+        return ReadAlternative<ast::Command>(node);
+      case kUnescapedCommandTag:
+        return ReadAlternative<ast::UnescapedCommand>(node);
+      case kNparagraphCommandTag:
+        return ReadAlternative<ast::NparagraphCommand>(node);
+      case kArgumentRefTag:
+        return ReadAlternative<ast::ArgumentRef>(node);
+      case kOuterArgumentRefTag:
+        return ReadAlternative<ast::OuterArgumentRef>(node);
+      default:
+        return false;
+    }
+  }
+
+ private:
+  template <typename Node, typename Variant>
+  bool ReadAlternative(Variant* variant) {
+    Node node;
+    if (!ReadPosition(&node) || !ReadPayload(&node)) {
+      return false;
+    }
+
+    *variant = std::move(node);
+    return true;
+  }
+
+  bool ReadPayload(ast::Program* node) { return ReadList(&node->nodes); }
+  bool ReadPayload(ast::PlainText* node) { return ReadString(&node->text); }
+  bool ReadPayload(ast::HtmlEntity* node) { return ReadString(&node->text); }
+  bool ReadPayload(ast::Paragraph* node) { return ReadList(&node->nodes); }
+  bool ReadPayload(ast::ParagraphBreaker* node) { return true; }
+  bool ReadPayload(ast::Argument* node) { return ReadList(&node->nodes); }
+  bool ReadPayload(ast::ArgumentRef* node) { return ReadInt(&node->argument_id); }
+  bool ReadPayload(ast::OuterArgumentRef* node) { return ReadInt(&node->argument_id); }
+  bool ReadPayload(ast::InlinedMathText* node) { return ReadString(&node->text); }
+  bool ReadPayload(ast::MathText* node) { return ReadString(&node->text); }
+
+  bool ReadPayload(ast::CommandMacro* node) {
+    return ReadSymbol(&node->name) && ReadOptionalInt(&node->arguments_num) && ReadList(&node->default_arguments) &&
+           ReadNode(&node->body);
+  }
+
+  bool ReadPayload(ast::EnvironmentMacro* node) {
+    return ReadSymbol(&node->name) && ReadOptionalInt(&node->arguments_num) && ReadList(&node->default_arguments) &&
+           ReadNode(&node->pre_program) && ReadNode(&node->post_program);
+  }
+
+  bool ReadPayload(ast::Command* node) {
+    return ReadSymbol(&node->name) && ReadList(&node->default_arguments) && ReadList(&node->arguments);
+  }
+
+  bool ReadPayload(ast::UnescapedCommand* node) { return ReadNode(&node->body); }
+  bool ReadPayload(ast::NparagraphCommand* node) { return ReadNode(&node->body); }
+
+  bool ReadPayload(ast::Environment* node) {
+    return ReadSymbol(&node->name) && ReadSymbol(&node->end_name) && ReadList(&node->default_arguments) &&
+           ReadList(&node->arguments) && ReadNode(&node->program);
+  }
+
+  bool ReadPayload(ast::VerbatimEnvironment* node) { return ReadString(&node->content); }
+
+  template <typename Node>
+  bool ReadList(std::list<Node>* nodes) {
+    std::uint64_t size;
+    // Every node takes at least one byte, which bounds the size of a well-formed list.
+    if (!ReadVarint(&size) || size > size_ - position_) {
+      return false;
+    }
+
+    for (std::uint64_t i = 0; i < size; ++i) {
+      nodes->emplace_back();
+      if (!ReadNode(&nodes->back())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool ReadPosition(ast::x3::position_tagged* node) {
+    std::uint64_t first;
+    std::uint64_t last;
+    if (!ReadVarint(&first) || !ReadVarint(&last) || first > std::numeric_limits<int>::max() ||
+        last > std::numeric_limits<int>::max()) {
+      return false;
+    }
+
+    node->id_first = static_cast<int>(first) - 1;
+    node->id_last = static_cast<int>(last) - 1;
+    return true;
+  }
+
+  bool ReadString(std::string* value) {
+    std::uint64_t size;
+    if (!ReadVarint(&size) || size > size_ - position_) {
+      return false;
+    }
+
+    value->assign(data_ + position_, size);
+    position_ += size;
+    return true;
+  }
+
+  bool ReadSymbol(ast::SymbolId* value) {
+    std::string name;
+    if (!ReadString(&name)) {
+      return false;
+    }
+
+    *value = symbol_table_->Intern(name);
+    return true;
+  }
+
+  bool ReadInt(int* value) {
+    std::uint64_t encoded;
+    if (!ReadVarint(&encoded)) {
+      return false;
+    }
+
+    const std::int64_t decoded = static_cast<std::int64_t>(encoded >> 1) ^ -static_cast<std::int64_t>(encoded & 1);
+    if (decoded < std::numeric_limits<int>::min() || decoded > std::numeric_limits<int>::max()) {
+      return false;
+    }
+
+    *value = static_cast<int>(decoded);
+    return true;
+  }
+
+  bool ReadOptionalInt(boost::optional<int>* value) {
+    std::uint64_t is_present;
+    if (!ReadVarint(&is_present) || is_present > 1) {
+      return false;
+    }
+
+    if (is_present) {
+      int present_value;
+      if (!ReadInt(&present_value)) {
+        return false;
+      }
+      *value = present_value;
+    }
+    return true;
+  }
+
+  bool ReadTag(std::uint8_t* tag) {
+    if (position_ == size_) {
+      return false;
+    }
+
+    *tag = static_cast<std::uint8_t>(data_[position_++]);
+    return true;
+  }
+
+  bool ReadVarint(std::uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (position_ == size_) {
+        return false;
+      }
+
+      const std::uint8_t byte = static_cast<std::uint8_t>(data_[position_++]);
+      *value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const char* data_;
+  std::size_t size_;
+  std::size_t position_ = 0;
+
+  ast::SymbolTable* symbol_table_;  // Not owned.
+};
+}  // namespace
+
+bool ReadBinaryAst(const char* data, std::size_t size, ast::SymbolTable* symbol_table, ast::Program* output) {
+  if (!data || !symbol_table || !output) {
+    return false;
+  }
+
+  BinaryReader reader(data, size, symbol_table);
+  return reader.ReadHeader() && reader.ReadNode(output) && reader.IsAtEnd();
+}
+
+}  // namespace ast_exporter
+}  // namespace lightex
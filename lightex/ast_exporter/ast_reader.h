@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+#include <lightex/ast/ast.h>
+#include <lightex/ast/symbol_table.h>
+
+namespace lightex {
+namespace ast_exporter {
+
+// Reads back an AST written by AstExporter in Format::kBinary without depth limit. Returns false if the data is
+// malformed, truncated or written by an incompatible version. Names are interned into |symbol_table|.
+bool ReadBinaryAst(const char* data, std::size_t size, ast::SymbolTable* symbol_table, ast::Program* output);
+
+}  // namespace ast_exporter
+}  // namespace lightex
@@ -0,0 +1,175 @@
+#include <lightex/backends/backends.h>
+
+#include <sstream>
+
+#include <lightex/ast_exporter/ast_exporter.h>
+#include <lightex/dot_converter/dot_visitor.h>
+#include <lightex/html_converter/html_visitor.h>
+#include <lightex/text_converter/text_visitor.h>
+#include <lightex/utils/arena.h>
+
+namespace lightex {
+namespace backends {
+namespace {
+
+bool FlushWriter(utils::OutputWriter* writer, std::string* error_message) {
+  if (!writer->Flush()) {
+    if (error_message) {
+      *error_message = writer->GetErrorMessage();
+    }
+    return false;
+  }
+  return true;
+}
+
+class HtmlBackend : public Backend {
+ public:
+  bool Render(const engine::Engine& engine,
+              const style_cache::CompiledStyle& style,
+              const ast::SymbolTable& symbol_table,
+              const ast::Program& ast,
+              std::string* error_message,
+              std::string* output) const override {
+    // Intermediate results of the render are allocated from a per-request arena and released at once along with it,
+    // so they must not outlive this scope.
+    utils::Arena arena;
+    utils::ArenaScope arena_scope(&arena);
+
+    html_converter::HtmlVisitor visitor_copy = engine.CopyHtmlVisitor(style, &symbol_table);
+    html_converter::Result result = visitor_copy(ast);
+    if (!result.is_successful) {
+      if (error_message) {
+        *error_message = result.error_message;
+      }
+      return false;
+    }
+
+    output->clear();
+    result.escaped.AppendTo(output);
+    return true;
+  }
+
+  bool RenderToWriter(const engine::Engine& engine,
+                      const style_cache::CompiledStyle& style,
+                      const ast::SymbolTable& symbol_table,
+                      const ast::Program& ast,
+                      std::string* error_message,
+                      utils::OutputWriter* writer) const override {
+    utils::Arena arena;
+    utils::ArenaScope arena_scope(&arena);
+
+    html_converter::HtmlVisitor visitor_copy = engine.CopyHtmlVisitor(style, &symbol_table);
+    html_converter::Result result = visitor_copy(ast);
+    if (!result.is_successful) {
+      if (error_message) {
+        *error_message = result.error_message;
+      }
+      return false;
+    }
+
+    // The writer refers to the fragments of the output in the arena and in the style, so it's flushed before the arena
+    // is gone.
+    result.escaped.ForEachFragment([writer](const char* data, std::size_t size) {
+      writer->Append(data, size);
+      return true;
+    });
+    return FlushWriter(writer, error_message);
+  }
+};
+
+class TextBackend : public Backend {
+ public:
+  bool Render(const engine::Engine& engine,
+              const style_cache::CompiledStyle& style,
+              const ast::SymbolTable& symbol_table,
+              const ast::Program& ast,
+              std::string* error_message,
+              std::string* output) const override {
+    text_converter::TextVisitor visitor_copy = engine.CopyTextVisitor(style, &symbol_table);
+    if (!visitor_copy(ast)) {
+      if (error_message) {
+        *error_message = visitor_copy.GetErrorMessage();
+      }
+      return false;
+    }
+
+    *output += visitor_copy.TakeOutput();
+    return true;
+  }
+};
+
+class DotBackend : public Backend {
+ public:
+  bool Render(const engine::Engine& engine,
+              const style_cache::CompiledStyle& style,
+              const ast::SymbolTable& symbol_table,
+              const ast::Program& ast,
+              std::string* error_message,
+              std::string* output) const override {
+    *output += "digraph d {\n";
+    dot_converter::DotVisitor visitor(&symbol_table, output);
+    visitor(ast);
+    *output += "}\n";
+    return true;
+  }
+};
+
+class AstBackend : public Backend {
+ public:
+  AstBackend(ast_exporter::Format format, int max_depth) : format_(format), max_depth_(max_depth) {}
+
+  bool Render(const engine::Engine& engine,
+              const style_cache::CompiledStyle& style,
+              const ast::SymbolTable& symbol_table,
+              const ast::Program& ast,
+              std::string* error_message,
+              std::string* output) const override {
+    std::ostringstream buffer;
+    ast_exporter::AstExporter exporter(format_, max_depth_, &symbol_table, &buffer);
+    exporter(ast);
+    *output += buffer.str();
+    return true;
+  }
+
+ private:
+  ast_exporter::Format format_;
+  int max_depth_;
+};
+}  // namespace
+
+bool Backend::RenderToWriter(const engine::Engine& engine,
+                             const style_cache::CompiledStyle& style,
+                             const ast::SymbolTable& symbol_table,
+                             const ast::Program& ast,
+                             std::string* error_message,
+                             utils::OutputWriter* writer) const {
+  std::string output;
+  if (!Render(engine, style, symbol_table, ast, error_message, &output)) {
+    return false;
+  }
+  writer->Append(output);
+  return FlushWriter(writer, error_message);
+}
+
+std::shared_ptr<const Backend> MakeHtmlBackend() {
+  return std::make_shared<HtmlBackend>();
+}
+
+std::shared_ptr<const Backend> MakeTextBackend() {
+  return std::make_shared<TextBackend>();
+}
+
+std::shared_ptr<const Backend> MakeDotBackend() {
+  return std::make_shared<DotBackend>();
+}
+
+std::shared_ptr<const Backend> MakeJsonAstBackend(int max_depth) {
+  return std::make_shared<AstBackend>(ast_exporter::Format::kJson, max_depth);
+}
+
+std::shared_ptr<const Backend> MakeBinaryAstBackend(int max_depth) {
+  return std::make_shared<AstBackend>(ast_exporter::Format::kBinary, max_depth);
+}
+
+}  // namespace backends
+}  // namespace lightex
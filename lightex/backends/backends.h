@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <lightex/ast/ast.h>
+#include <lightex/ast/symbol_table.h>
+#include <lightex/engine/engine.h>
+#include <lightex/style_cache/style_cache.h>
+#include <lightex/utils/output_writer.h>
+
+namespace lightex {
+namespace backends {
+
+// Renders parsed programs into one output format. Backends only read the program, its names and the style, so a
+// backend can render on several threads at once.
+class Backend {
+ public:
+  virtual ~Backend() {}
+
+  // Programs are parsed by |engine|, whose limits and profiler apply to the macro expansions.
+  virtual bool Render(const engine::Engine& engine,
+                      const style_cache::CompiledStyle& style,
+                      const ast::SymbolTable& symbol_table,
+                      const ast::Program& ast,
+                      std::string* error_message,
+                      std::string* output) const = 0;
+
+  // Same as Render, but writes the output to |writer| and flushes it.
+  virtual bool RenderToWriter(const engine::Engine& engine,
+                              const style_cache::CompiledStyle& style,
+                              const ast::SymbolTable& symbol_table,
+                              const ast::Program& ast,
+                              std::string* error_message,
+                              utils::OutputWriter* writer) const;
+};
+
+std::shared_ptr<const Backend> MakeHtmlBackend();
+// Visible text only, e.g. for search indexing (see text_converter/text_visitor.h).
+std::shared_ptr<const Backend> MakeTextBackend();
+std::shared_ptr<const Backend> MakeDotBackend();
+
+// AST exports, skipping subtrees deeper than |max_depth| (see ast_exporter/ast_exporter.h).
+std::shared_ptr<const Backend> MakeJsonAstBackend(int max_depth);
+std::shared_ptr<const Backend> MakeBinaryAstBackend(int max_depth);
+
+}  // namespace backends
+}  // namespace lightex
@@ -0,0 +1,63 @@
+#include <lightex/backends/fan_out.h>
+
+#include <future>
+
+namespace lightex {
+namespace backends {
+
+FanOut::FanOut(std::shared_ptr<engine::Engine> engine) : engine_(engine) {}
+
+void FanOut::AddBackend(std::shared_ptr<const Backend> backend) {
+  backends_.push_back(backend);
+}
+
+bool FanOut::ParseProgram(const std::string& input,
+                          bool is_parallel,
+                          std::string* error_message,
+                          std::vector<std::string>* outputs) const {
+  if (!outputs) {
+    return false;
+  }
+
+  std::shared_ptr<const style_cache::CompiledStyle> style = engine_->GetLoadedStyle();
+  ast::SymbolTable symbol_table(style->symbol_table.get());
+  ast::Program ast;
+  if (!engine_->ParseProgramToAst(input, &symbol_table, error_message, &ast)) {
+    return false;
+  }
+
+  // Backends only read the AST, its names and the style, so they can share them without copies or locks.
+  std::vector<std::string> backend_outputs(backends_.size());
+  std::vector<std::string> backend_error_messages(backends_.size());
+  std::vector<std::future<bool>> backend_results;
+  const std::size_t first_serial_backend = is_parallel && !backends_.empty() ? backends_.size() - 1 : 0;
+  for (std::size_t i = 0; i < first_serial_backend; ++i) {
+    backend_results.push_back(std::async(std::launch::async, &Backend::Render, backends_[i].get(),
+                                         std::cref(*engine_), std::cref(*style), std::cref(symbol_table),
+                                         std::cref(ast), &backend_error_messages[i], &backend_outputs[i]));
+  }
+
+  std::vector<bool> is_rendered(backends_.size());
+  for (std::size_t i = first_serial_backend; i < backends_.size(); ++i) {
+    is_rendered[i] = backends_[i]->Render(*engine_, *style, symbol_table, ast, &backend_error_messages[i],
+                                          &backend_outputs[i]);
+  }
+  for (std::size_t i = 0; i < backend_results.size(); ++i) {
+    is_rendered[i] = backend_results[i].get();
+  }
+
+  for (std::size_t i = 0; i < backends_.size(); ++i) {
+    if (!is_rendered[i]) {
+      if (error_message) {
+        *error_message = backend_error_messages[i];
+      }
+      return false;
+    }
+  }
+
+  *outputs = std::move(backend_outputs);
+  return true;
+}
+
+}  // namespace backends
+}  // namespace lightex
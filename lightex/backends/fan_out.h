@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <lightex/backends/backends.h>
+#include <lightex/engine/engine.h>
+
+namespace lightex {
+namespace backends {
+
+// Parses every program once with the loaded style of the engine and renders it with each of the added backends.
+class FanOut {
+ public:
+  explicit FanOut(std::shared_ptr<engine::Engine> engine);
+
+  // Not thread safe, backends should be added before parsing anything. Outputs come in the order of the backends.
+  void AddBackend(std::shared_ptr<const Backend> backend);
+
+  // Renders with the backends on separate threads if |is_parallel|. Thread safe.
+  bool ParseProgram(const std::string& input,
+                    bool is_parallel,
+                    std::string* error_message,
+                    std::vector<std::string>* outputs) const;
+
+ private:
+  std::shared_ptr<engine::Engine> engine_;
+  std::vector<std::shared_ptr<const Backend>> backends_;
+};
+
+}  // namespace backends
+}  // namespace lightex
@@ -0,0 +1,63 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <lightex/workspace.h>
+
+namespace {
+
+const int kIterationsNum = 5;
+const int kMaxRepetitionsNum = 1 << 12;
+
+// Every construct here shares its first characters with some other node kind, and plain text is full of characters
+// that start lookup table symbols. Parsing it makes the grammar consider as many alternatives as possible.
+const char kNearMissBlock[] =
+    "a-b <c> d--e << f >> g \\, h~i \\% \\$ \\{ &amp; $x$ \\x[y]{z}{#1} \\unescaped{u} \\nparagraph{n} #2 ##1 % c\n"
+    "\\newcommand{\\x}[1][d]{#1} \\newenvironment{e}{p}{q}\n\n"
+    "\\begin{e}[o]{a} $$m$$ \\begin{verbatim} v \\end{verbatim} \\end{e}\n\n";
+
+double MeasureMilliseconds(lightex::Workspace* workspace, const std::string& input) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterationsNum; ++i) {
+    std::string output;
+    std::string error_message;
+    if (!workspace->ParseProgram(input, &error_message, &output)) {
+      std::cerr << "Error: " << error_message << std::endl;
+      return -1;
+    }
+  }
+  const auto finish = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(finish - start).count() / kIterationsNum;
+}
+}  // namespace
+
+int main() {
+  // Only the root of the AST is exported, so the time is spent almost entirely in the parser.
+  std::shared_ptr<lightex::Workspace> workspace = lightex::MakeJsonAstWorkspace(0);
+
+  double previous_milliseconds = 0;
+  for (int repetitions_num = 1 << 6; repetitions_num <= kMaxRepetitionsNum; repetitions_num *= 2) {
+    std::string input;
+    for (int i = 0; i < repetitions_num; ++i) {
+      input += kNearMissBlock;
+    }
+
+    const double milliseconds = MeasureMilliseconds(workspace.get(), input);
+    if (milliseconds < 0) {
+      return 1;
+    }
+
+    std::cout << "Input size: " << input.size() << " bytes, parse time: " << milliseconds << " ms, "
+              << static_cast<double>(input.size()) / milliseconds / 1000 << " MB/s";
+    if (previous_milliseconds > 0) {
+      std::cout << ", growth: " << milliseconds / previous_milliseconds << "x";
+    }
+    std::cout << std::endl;
+
+    previous_milliseconds = milliseconds;
+  }
+
+  return 0;
+}
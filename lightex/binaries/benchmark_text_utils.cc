@@ -0,0 +1,137 @@
+#include <chrono>
+#include <cctype>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <lightex/utils/file_utils.h>
+#include <lightex/utils/text_utils.h>
+
+namespace {
+
+const int kIterationsNum = 200;
+const std::size_t kGeneratedInputSize = 1 << 20;
+
+// Two-pass implementation that AppendFormattedHtml replaces, kept as the baseline for comparison.
+std::string FormatText(const std::string& unformatted) {
+  std::ostringstream buffer;
+
+  bool previous_is_space = false;
+  for (char c : unformatted) {
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      if (!previous_is_space) {
+        buffer << ' ';
+      }
+      previous_is_space = true;
+      continue;
+    }
+
+    buffer << c;
+    previous_is_space = false;
+  }
+
+  return buffer.str();
+}
+
+std::string EscapeStringForHtml(const std::string& unescaped) {
+  std::ostringstream buffer;
+
+  for (char c : unescaped) {
+    switch (c) {
+      case '&':
+        buffer << "&amp;";
+        break;
+
+      case '\"':
+        buffer << "&quot;";
+        break;
+
+      case '\'':
+        buffer << "&apos;";
+        break;
+
+      case '<':
+        buffer << "&lt;";
+        break;
+
+      case '>':
+        buffer << "&gt;";
+        break;
+
+      default:
+        buffer << c;
+    }
+  }
+
+  return buffer.str();
+}
+
+std::string GenerateInput(std::size_t size) {
+  // Mostly plain words with occasional white space runs and HTML special characters, like real statements.
+  const std::string alphabet =
+      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789.,;:() \n&<>";
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<std::size_t> distribution(0, alphabet.size() - 1);
+
+  std::string input;
+  input.reserve(size);
+  while (input.size() < size) {
+    input += alphabet[distribution(generator)];
+  }
+  return input;
+}
+
+template <typename Function>
+double MeasureMegabytesPerSecond(const std::string& input, Function function) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterationsNum; ++i) {
+    function();
+  }
+  const auto finish = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(finish - start).count();
+  return static_cast<double>(input.size()) * kIterationsNum / seconds / (1 << 20);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string input;
+  if (argc == 2) {
+    if (!lightex::utils::ReadDataFromFile(argv[1], &input)) {
+      return 1;
+    }
+  } else if (argc == 1) {
+    input = GenerateInput(kGeneratedInputSize);
+  } else {
+    std::cerr << "Error: invalid number of arguments! (Expected 0 or 1, got " << std::to_string(argc - 1) << ")"
+              << std::endl;
+    return 1;
+  }
+
+  std::string expected = EscapeStringForHtml(FormatText(input));
+  std::string actual;
+  lightex::utils::AppendFormattedHtml(input, &actual);
+  if (actual != expected) {
+    std::cerr << "Error: fused escaping produced a different result!" << std::endl;
+    return 1;
+  }
+
+  std::size_t checksum = 0;
+  const double baseline_speed = MeasureMegabytesPerSecond(input, [&]() {
+    checksum += EscapeStringForHtml(FormatText(input)).size();
+  });
+  const double fused_speed = MeasureMegabytesPerSecond(input, [&]() {
+    std::string output;
+    lightex::utils::AppendFormattedHtml(input, &output);
+    checksum += output.size();
+  });
+
+  std::cout << "Input size: " << input.size() << " bytes" << std::endl;
+  std::cout << "FormatText + EscapeStringForHtml: " << baseline_speed << " MB/s" << std::endl;
+  std::cout << "AppendFormattedHtml: " << fused_speed << " MB/s" << std::endl;
+  std::cout << "Checksum: " << checksum << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,215 @@
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <dirent.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <lightex/backends/backends.h>
+#include <lightex/engine/engine.h>
+#include <lightex/html_converter/html_visitor.h>
+#include <lightex/workspace.h>
+#include <lightex/utils/file_utils.h>
+
+// Fuzz target for Workspace::ParseProgram. Every input is rendered to HTML twice: by a bare workspace and by one with
+// the bundled style loaded. Besides crashes, an input is a finding if a render
+//   - overflows a stack of LIGHTEX_FUZZ_STACK_KB kilobytes (1024 by default), which is what deep nesting does,
+//   - takes longer than LIGHTEX_FUZZ_TIMEOUT_MS milliseconds (1000 by default),
+//   - grows the peak resident memory of the process by more than LIGHTEX_FUZZ_RSS_GROWTH_MB megabytes (256 by
+//     default).
+// Findings abort the process, so that libFuzzer and AFL save the input. LIGHTEX_FUZZ_STYLE overrides the path of the
+// style file, lightex/styles/lightex.sty by default.
+//
+// Built with LIGHTEX_LIBFUZZER the binary is a libFuzzer target. Otherwise it has its own driver:
+//   fuzz_parse_program < input_file               runs a single input, as AFL does;
+//   fuzz_parse_program (file | directory)...       runs every file, e.g. a corpus or saved findings.
+
+namespace {
+
+const char kDefaultStyleFile[] = "lightex/styles/lightex.sty";
+// Keeps the parser within the stack limit below, deeper inputs are rejected before parsing.
+const int kMaxNestingDepth = 128;
+
+struct Limits {
+  std::size_t stack_size_bytes = 1024 << 10;
+  std::chrono::milliseconds timeout = std::chrono::milliseconds(1000);
+  long rss_growth_kb = 256 << 10;
+};
+
+std::size_t GetEnvironmentNumber(const char* name, std::size_t default_value) {
+  const char* value = std::getenv(name);
+  return value && *value ? std::strtoull(value, nullptr, 10) : default_value;
+}
+
+std::shared_ptr<lightex::Workspace> MakeLimitedHtmlWorkspace() {
+  auto engine = std::make_shared<lightex::engine::Engine>();
+  engine->SetNestingLimits(kMaxNestingDepth, lightex::html_converter::kDefaultMaxExpansionDepth);
+  return lightex::MakeWorkspace(engine, lightex::backends::MakeHtmlBackend());
+}
+
+long GetPeakRssKb() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+class Fuzzer {
+ public:
+  Fuzzer() : bare_workspace_(MakeLimitedHtmlWorkspace()), styled_workspace_(MakeLimitedHtmlWorkspace()) {
+    limits_.stack_size_bytes = GetEnvironmentNumber("LIGHTEX_FUZZ_STACK_KB", limits_.stack_size_bytes >> 10) << 10;
+    limits_.timeout =
+        std::chrono::milliseconds(GetEnvironmentNumber("LIGHTEX_FUZZ_TIMEOUT_MS", limits_.timeout.count()));
+    limits_.rss_growth_kb = GetEnvironmentNumber("LIGHTEX_FUZZ_RSS_GROWTH_MB", limits_.rss_growth_kb >> 10) << 10;
+
+    const char* style_file = std::getenv("LIGHTEX_FUZZ_STYLE");
+    std::string error_message;
+    if (!styled_workspace_->LoadStyle(style_file ? style_file : kDefaultStyleFile, &error_message)) {
+      std::cerr << "Error: failed to load style file!" << std::endl;
+      std::cerr << error_message << std::endl;
+      std::exit(1);
+    }
+  }
+
+  void Run(const std::string& input) {
+    Render(bare_workspace_.get(), input, "bare workspace");
+    Render(styled_workspace_.get(), input, "styled workspace");
+  }
+
+ private:
+  struct Task {
+    lightex::Workspace* workspace;  // Not owned.
+    const std::string* input;       // Not owned.
+
+    std::mutex mtx;
+    std::condition_variable is_done_cv;
+    bool is_done = false;
+  };
+
+  static void* RunTask(void* task_ptr) {
+    Task* task = static_cast<Task*>(task_ptr);
+
+    // Parsing errors are expected, only the resources spent on the input matter.
+    std::string output;
+    std::string error_message;
+    task->workspace->ParseProgram(*task->input, &error_message, &output);
+
+    std::unique_lock<std::mutex> lock(task->mtx);
+    task->is_done = true;
+    task->is_done_cv.notify_one();
+    return nullptr;
+  }
+
+  // The render runs on a thread of its own, which has the limited stack and can be waited for with a timeout.
+  void Render(lightex::Workspace* workspace, const std::string& input, const char* workspace_name) {
+    const long peak_rss_kb = GetPeakRssKb();
+
+    Task task;
+    task.workspace = workspace;
+    task.input = &input;
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, limits_.stack_size_bytes);
+    pthread_t thread;
+    if (pthread_create(&thread, &attributes, &Fuzzer::RunTask, &task) != 0) {
+      std::cerr << "Error: failed to start a render thread!" << std::endl;
+      std::abort();
+    }
+    pthread_attr_destroy(&attributes);
+
+    {
+      std::unique_lock<std::mutex> lock(task.mtx);
+      if (!task.is_done_cv.wait_for(lock, limits_.timeout, [&task]() { return task.is_done; })) {
+        std::cerr << "Finding: render by the " << workspace_name << " takes longer than " << limits_.timeout.count()
+                  << " ms." << std::endl;
+        std::abort();
+      }
+    }
+    pthread_join(thread, nullptr);
+
+    const long rss_growth_kb = GetPeakRssKb() - peak_rss_kb;
+    if (rss_growth_kb > limits_.rss_growth_kb) {
+      std::cerr << "Finding: render by the " << workspace_name << " grows peak memory by " << (rss_growth_kb >> 10)
+                << " MB." << std::endl;
+      std::abort();
+    }
+  }
+
+  Limits limits_;
+  std::shared_ptr<lightex::Workspace> bare_workspace_;
+  std::shared_ptr<lightex::Workspace> styled_workspace_;
+};
+
+Fuzzer& GetFuzzer() {
+  static Fuzzer fuzzer;
+  return fuzzer;
+}
+
+#ifndef LIGHTEX_LIBFUZZER
+bool IsDirectory(const std::string& path) {
+  struct stat path_stat;
+  return stat(path.c_str(), &path_stat) == 0 && S_ISDIR(path_stat.st_mode);
+}
+
+bool RunFile(const std::string& path) {
+  std::string input;
+  if (!lightex::utils::ReadDataFromFile(path, &input)) {
+    return false;
+  }
+
+  std::cerr << "Running " << path << std::endl;
+  GetFuzzer().Run(input);
+  return true;
+}
+
+bool RunPath(const std::string& path) {
+  if (!IsDirectory(path)) {
+    return RunFile(path);
+  }
+
+  DIR* directory = opendir(path.c_str());
+  if (!directory) {
+    std::cerr << "Error: failed to open directory: " << path << std::endl;
+    return false;
+  }
+
+  bool is_successful = true;
+  while (const dirent* entry = readdir(directory)) {
+    if (entry->d_name[0] != '.') {
+      is_successful &= RunPath(path + "/" + entry->d_name);
+    }
+  }
+  closedir(directory);
+  return is_successful;
+}
+#endif
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+  GetFuzzer().Run(std::string(reinterpret_cast<const char*>(data), size));
+  return 0;
+}
+
+#ifndef LIGHTEX_LIBFUZZER
+int main(int argc, char** argv) {
+  if (argc == 1) {
+    const std::string input(std::istreambuf_iterator<char>(std::cin), {});
+    GetFuzzer().Run(input);
+    return 0;
+  }
+
+  bool is_successful = true;
+  for (int i = 1; i < argc; ++i) {
+    is_successful &= RunPath(argv[i]);
+  }
+  return is_successful ? 0 : 1;
+}
+#endif
@@ -0,0 +1,73 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <lightex/workspace.h>
+#include <lightex/utils/file_utils.h>
+#include <lightex/utils/output_writer.h>
+
+namespace {
+
+const char kBinaryFlag[] = "--binary";
+const char kMaxDepthFlag[] = "--max-depth=";
+
+}  // namespace
+
+// Usage: parse_program_to_ast [--binary] [--max-depth=N] input_file output_file
+int main(int argc, char** argv) {
+  bool is_binary = false;
+  int max_depth = -1;
+  std::vector<char const*> positional_args;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], kBinaryFlag) == 0) {
+      is_binary = true;
+    } else if (std::strncmp(argv[i], kMaxDepthFlag, sizeof(kMaxDepthFlag) - 1) == 0) {
+      max_depth = std::atoi(argv[i] + sizeof(kMaxDepthFlag) - 1);
+    } else {
+      positional_args.push_back(argv[i]);
+    }
+  }
+
+  char const* input_file;
+  char const* output_file;
+  if (positional_args.size() == 2) {
+    input_file = positional_args[0];
+    output_file = positional_args[1];
+  } else {
+    std::cerr << "Error: invalid number of arguments! (Expected 2, got " << std::to_string(positional_args.size())
+              << ")" << std::endl;
+    return 1;
+  }
+
+  std::string storage;
+  if (!lightex::utils::ReadDataFromFile(input_file, &storage)) {
+    return 1;
+  }
+
+  std::shared_ptr<lightex::Workspace> workspace =
+      is_binary ? lightex::MakeBinaryAstWorkspace(max_depth) : lightex::MakeJsonAstWorkspace(max_depth);
+  std::string error_message;
+  lightex::utils::OutputFile output(output_file);
+  if (!output.Open()) {
+    return 1;
+  }
+  lightex::utils::OutputWriter writer(output.GetFd());
+  const bool is_written = workspace->ParseProgramToWriter(storage, &writer, &error_message);
+  if (!writer.GetErrorMessage().empty()) {
+    std::cerr << "Error: failed to write output file: " << output_file << std::endl;
+    return 1;
+  }
+  if (!is_written) {
+    std::cerr << "Error: failed to parse input!" << std::endl;
+    std::cerr << error_message << std::endl;
+    return 1;
+  }
+  if (!output.Commit()) {
+    return 1;
+  }
+
+  return 0;
+}
@@ -1,10 +1,10 @@
-#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
 
 #include <lightex/workspace.h>
 #include <lightex/utils/file_utils.h>
+#include <lightex/utils/output_writer.h>
 
 int main(int argc, char** argv) {
   char const* input_file;
@@ -25,20 +25,23 @@ int main(int argc, char** argv) {
 
   std::shared_ptr<lightex::Workspace> workspace = lightex::MakeDotWorkspace();
   std::string error_message;
-  std::string result;
-  if (!workspace->ParseProgram(storage, &error_message, &result)) {
+  lightex::utils::OutputFile output(output_file);
+  if (!output.Open()) {
+    return 1;
+  }
+  lightex::utils::OutputWriter writer(output.GetFd());
+  const bool is_written = workspace->ParseProgramToWriter(storage, &writer, &error_message);
+  if (!writer.GetErrorMessage().empty()) {
+    std::cerr << "Error: failed to write output file: " << output_file << std::endl;
+    return 1;
+  }
+  if (!is_written) {
     std::cerr << "Error: failed to parse input!" << std::endl;
     std::cerr << error_message << std::endl;
     return 1;
   }
-
-  {
-    std::ofstream out(output_file);
-    if (!out) {
-      std::cerr << "Error: failed to open output file for writing: " << input_file << std::endl;
-      return 1;
-    }
-    out << result;
+  if (!output.Commit()) {
+    return 1;
   }
 
   return 0;
@@ -1,49 +1,242 @@
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
+#include <lightex/backends/backends.h>
+#include <lightex/engine/engine.h>
+#include <lightex/html_converter/macro_profiler.h>
+#include <lightex/stream_renderer/stream_renderer.h>
 #include <lightex/workspace.h>
 #include <lightex/utils/file_utils.h>
+#include <lightex/utils/output_writer.h>
 
+namespace {
+
+const char kAstCacheFlag[] = "--ast-cache=";
+const char kAstCacheSizeFlag[] = "--ast-cache-size=";
+const char kClearAstCacheFlag[] = "--clear-ast-cache";
+const char kThreadsFlag[] = "--threads=";
+const char kTextFlag[] = "--text";
+const char kStreamFlag[] = "--stream";
+const char kMacroProfileFlag[] = "--macro-profile=";
+const char kMacroTraceFlag[] = "--macro-trace=";
+
+const std::uint64_t kDefaultAstCacheSizeBytes = 1ull << 30;
+
+bool ConsumeFlagValue(const char* arg, const char* flag, std::size_t flag_size, std::string* value) {
+  if (std::strncmp(arg, flag, flag_size - 1) != 0) {
+    return false;
+  }
+
+  *value = arg + flag_size - 1;
+  return true;
+}
+
+// Parses a decimal number in [min_value, max_value] given to |flag|, prints a usage error otherwise.
+bool ParseIntFlagValue(const char* flag, const std::string& value, long min_value, long max_value, long* output) {
+  char* end = nullptr;
+  errno = 0;
+  const long number = std::strtol(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0' || errno == ERANGE || number < min_value || number > max_value) {
+    std::cerr << "Error: invalid " << flag << value << "! (Expected a number from " << min_value << " to " << max_value
+              << ")" << std::endl;
+    return false;
+  }
+
+  *output = number;
+  return true;
+}
+
+// Parses a decimal size in bytes given to |flag|, prints a usage error otherwise.
+bool ParseSizeFlagValue(const char* flag, const std::string& value, std::uint64_t* output) {
+  char* end = nullptr;
+  errno = 0;
+  const unsigned long long size = std::strtoull(value.c_str(), &end, 10);
+  // strtoull() accepts leading white space and negates negative numbers, so the value must start with a digit.
+  if (value.empty() || value[0] < '0' || value[0] > '9' || *end != '\0' || errno == ERANGE) {
+    std::cerr << "Error: invalid " << flag << value << "! (Expected a size in bytes)" << std::endl;
+    return false;
+  }
+
+  *output = size;
+  return true;
+}
+
+bool WriteMacroProfile(const lightex::html_converter::MacroProfiler& macro_profiler,
+                       const std::string& report_file,
+                       const std::string& trace_file) {
+  if (!report_file.empty()) {
+    std::ofstream out(report_file);
+    macro_profiler.WriteReport(&out);
+    if (!out) {
+      std::cerr << "Error: failed to write macro profile: " << report_file << std::endl;
+      return false;
+    }
+  }
+
+  if (!trace_file.empty()) {
+    std::ofstream out(trace_file);
+    macro_profiler.WriteChromeTrace(&out);
+    if (!out) {
+      std::cerr << "Error: failed to write macro trace: " << trace_file << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
+// Usage: parse_program_to_html [--ast-cache=DIR [--ast-cache-size=BYTES] [--clear-ast-cache]] [--threads=N] [--text]
+//                              [--stream] [--macro-profile=REPORT_FILE] [--macro-trace=TRACE_FILE]
+//                              input_file output_file
+//
+// With --text only the visible text of the program is written instead of HTML. With --stream the input is rendered
+// block by block as it is read, with memory bounded by the largest block (see stream_renderer/stream_renderer.h),
+// and it can't be combined with --text. The output file is replaced only once the whole input is rendered. The macro
+// profile flags write per-macro expansion statistics of the render and its timeline in the Chrome trace event format.
 int main(int argc, char** argv) {
+  std::string ast_cache_directory;
+  std::string ast_cache_size;
+  std::string threads_num;
+  std::string macro_profile_file;
+  std::string macro_trace_file;
+  bool clear_ast_cache = false;
+  bool is_text = false;
+  bool is_stream = false;
+  std::vector<char const*> positional_args;
+  for (int i = 1; i < argc; ++i) {
+    if (ConsumeFlagValue(argv[i], kAstCacheFlag, sizeof(kAstCacheFlag), &ast_cache_directory) ||
+        ConsumeFlagValue(argv[i], kAstCacheSizeFlag, sizeof(kAstCacheSizeFlag), &ast_cache_size) ||
+        ConsumeFlagValue(argv[i], kThreadsFlag, sizeof(kThreadsFlag), &threads_num) ||
+        ConsumeFlagValue(argv[i], kMacroProfileFlag, sizeof(kMacroProfileFlag), &macro_profile_file) ||
+        ConsumeFlagValue(argv[i], kMacroTraceFlag, sizeof(kMacroTraceFlag), &macro_trace_file)) {
+      continue;
+    }
+    if (std::strcmp(argv[i], kClearAstCacheFlag) == 0) {
+      clear_ast_cache = true;
+    } else if (std::strcmp(argv[i], kTextFlag) == 0) {
+      is_text = true;
+    } else if (std::strcmp(argv[i], kStreamFlag) == 0) {
+      is_stream = true;
+    } else {
+      positional_args.push_back(argv[i]);
+    }
+  }
+
+  if (is_text && is_stream) {
+    std::cerr << "Error: " << kTextFlag << " and " << kStreamFlag << " can't be used together!" << std::endl;
+    return 1;
+  }
+
   char const* input_file;
   char const* output_file;
-  if (argc == 3) {
-    input_file = argv[1];
-    output_file = argv[2];
+  if (positional_args.size() == 2) {
+    input_file = positional_args[0];
+    output_file = positional_args[1];
   } else {
-    std::cerr << "Error: invalid number of arguments! (Expected 2, got " << std::to_string(argc - 1) << ")"
-              << std::endl;
+    std::cerr << "Error: invalid number of arguments! (Expected 2, got " << std::to_string(positional_args.size())
+              << ")" << std::endl;
     return 1;
   }
 
-  std::string storage;
-  if (!lightex::utils::ReadDataFromFile(input_file, &storage)) {
+  long parsing_threads_num = 1;
+  if (!threads_num.empty() && !ParseIntFlagValue(kThreadsFlag, threads_num, 1, INT_MAX, &parsing_threads_num)) {
     return 1;
   }
 
-  std::shared_ptr<lightex::Workspace> workspace = lightex::MakeHtmlWorkspace();
+  auto engine = std::make_shared<lightex::engine::Engine>();
+  engine->SetParsingThreadsNum(static_cast<int>(parsing_threads_num));
+  std::shared_ptr<lightex::html_converter::MacroProfiler> macro_profiler;
+  if (!macro_profile_file.empty() || !macro_trace_file.empty()) {
+    macro_profiler = std::make_shared<lightex::html_converter::MacroProfiler>(!macro_trace_file.empty());
+    engine->SetMacroProfiler(macro_profiler);
+  }
+
   std::string error_message;
-  if (!workspace->LoadStyle("lightex/styles/lightex.sty", &error_message)) {
-    std::cerr << "Error: failed to preload style file!" << std::endl;
-    std::cerr << error_message << std::endl;
-    return 1;
+  if (!ast_cache_directory.empty()) {
+    std::uint64_t max_size_bytes = kDefaultAstCacheSizeBytes;
+    if (!ast_cache_size.empty() && !ParseSizeFlagValue(kAstCacheSizeFlag, ast_cache_size, &max_size_bytes)) {
+      return 1;
+    }
+    if (!engine->EnableAstCache(ast_cache_directory, max_size_bytes, &error_message) ||
+        (clear_ast_cache && !engine->ClearAstCache(&error_message))) {
+      std::cerr << "Error: failed to set up AST cache!" << std::endl;
+      std::cerr << error_message << std::endl;
+      return 1;
+    }
   }
 
-  std::string result;
-  if (!workspace->ParseProgram(storage, &error_message, &result)) {
-    std::cerr << "Error: failed to parse input!" << std::endl;
+  if (!engine->LoadStyle("lightex/styles/lightex.sty", &error_message)) {
+    std::cerr << "Error: failed to preload style file!" << std::endl;
     std::cerr << error_message << std::endl;
     return 1;
   }
 
-  {
-    std::ofstream out(output_file);
+  if (is_stream) {
+    std::ifstream in(input_file, std::ios::binary);
+    if (!in) {
+      std::cerr << "Error: failed to open input file for reading: " << input_file << std::endl;
+      return 1;
+    }
+    lightex::utils::OutputFile output(output_file);
+    if (!output.Open()) {
+      return 1;
+    }
+    std::ofstream out(output.GetTemporaryPath(), std::ios::binary);
+    if (!out) {
+      std::cerr << "Error: failed to open output file for writing: " << output.GetTemporaryPath() << std::endl;
+      return 1;
+    }
+    if (!lightex::stream_renderer::StreamRenderer(engine).Render(&in, &out, &error_message)) {
+      std::cerr << "Error: failed to parse input!" << std::endl;
+      std::cerr << error_message << std::endl;
+      return 1;
+    }
+    out.close();
     if (!out) {
-      std::cerr << "Error: failed to open output file for writing: " << input_file << std::endl;
+      std::cerr << "Error: failed to write output file: " << output_file << std::endl;
       return 1;
     }
-    out << result;
+    if (!output.Commit()) {
+      return 1;
+    }
+  } else {
+    std::string storage;
+    if (!lightex::utils::ReadDataFromFile(input_file, &storage)) {
+      return 1;
+    }
+
+    lightex::utils::OutputFile output(output_file);
+    if (!output.Open()) {
+      return 1;
+    }
+    std::shared_ptr<lightex::Workspace> workspace = lightex::MakeWorkspace(
+        engine, is_text ? lightex::backends::MakeTextBackend() : lightex::backends::MakeHtmlBackend());
+    lightex::utils::OutputWriter writer(output.GetFd());
+    const bool is_written = workspace->ParseProgramToWriter(storage, &writer, &error_message);
+    if (!writer.GetErrorMessage().empty()) {
+      std::cerr << "Error: failed to write output file: " << output_file << std::endl;
+      return 1;
+    }
+    if (!is_written) {
+      std::cerr << "Error: failed to parse input!" << std::endl;
+      std::cerr << error_message << std::endl;
+      return 1;
+    }
+    if (!output.Commit()) {
+      return 1;
+    }
+  }
+
+  if (macro_profiler && !WriteMacroProfile(*macro_profiler, macro_profile_file, macro_trace_file)) {
+    return 1;
   }
 
   return 0;
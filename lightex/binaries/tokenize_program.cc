@@ -0,0 +1,48 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <lightex/lexer/lexer.h>
+#include <lightex/utils/file_utils.h>
+
+// Writes the token stream of the input as line-delimited JSON, one token per line, e.g. for syntax highlighting.
+int main(int argc, char** argv) {
+  char const* input_file;
+  char const* output_file;
+  if (argc == 3) {
+    input_file = argv[1];
+    output_file = argv[2];
+  } else {
+    std::cerr << "Error: invalid number of arguments! (Expected 2, got " << std::to_string(argc - 1) << ")"
+              << std::endl;
+    return 1;
+  }
+
+  std::string storage;
+  if (!lightex::utils::ReadDataFromFile(input_file, &storage)) {
+    return 1;
+  }
+
+  std::vector<lightex::lexer::Token> tokens;
+  std::string error_message;
+  if (!lightex::lexer::Tokenize(storage, &tokens, &error_message)) {
+    std::cerr << "Error: failed to tokenize input!" << std::endl;
+    std::cerr << error_message << std::endl;
+    return 1;
+  }
+
+  {
+    std::ofstream out(output_file);
+    if (!out) {
+      std::cerr << "Error: failed to open output file for writing: " << output_file << std::endl;
+      return 1;
+    }
+    for (const auto& token : tokens) {
+      out << "{\"type\":\"" << lightex::lexer::GetTokenTypeName(token.type) << "\",\"first\":" << token.first
+          << ",\"last\":" << token.last << "}\n";
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,227 @@
+#include <lightex/c_api/c_api.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+
+#include <lightex/ast_exporter/ast_exporter.h>
+#include <lightex/backends/backends.h>
+#include <lightex/engine/engine.h>
+#include <lightex/patch_renderer/patch_renderer.h>
+#include <lightex/workspace.h>
+
+struct lightex_workspace {
+  std::shared_ptr<lightex::engine::Engine> engine;
+  std::shared_ptr<lightex::Workspace> workspace;
+  // Only HTML workspaces make patches.
+  std::shared_ptr<lightex::patch_renderer::PatchRenderer> patch_renderer;
+};
+
+namespace {
+
+// Copies |data| into a NUL terminated buffer allocated with malloc, so that lightex_free can release it.
+char* CopyToBuffer(const std::string& data) {
+  char* buffer = static_cast<char*>(std::malloc(data.size() + 1));
+  if (buffer) {
+    std::memcpy(buffer, data.data(), data.size());
+    buffer[data.size()] = '\0';
+  }
+  return buffer;
+}
+
+int Fail(const std::string& error_message, char** error_message_buffer) {
+  if (error_message_buffer) {
+    *error_message_buffer = CopyToBuffer(error_message);
+  }
+  return 0;
+}
+
+int ReturnOutput(const std::string& output, char** output_buffer, size_t* output_size, char** error_message_buffer) {
+  *output_buffer = CopyToBuffer(output);
+  if (!*output_buffer) {
+    return Fail("Failed to allocate the output buffer.", error_message_buffer);
+  }
+  if (output_size) {
+    *output_size = output.size();
+  }
+  return 1;
+}
+
+// Exceptions must not cross the C boundary, the library throws only on allocation failures.
+template <typename Function>
+int CallGuarded(const Function& function, char** error_message_buffer) {
+  try {
+    return function();
+  } catch (const std::exception& exception) {
+    return Fail(exception.what(), error_message_buffer);
+  }
+}
+}  // namespace
+
+int lightex_get_api_version(void) {
+  return LIGHTEX_C_API_VERSION;
+}
+
+lightex_workspace* lightex_workspace_create(lightex_backend backend) {
+  lightex_workspace* workspace = nullptr;
+  CallGuarded(
+      [&]() {
+        std::shared_ptr<const lightex::backends::Backend> workspace_backend;
+        switch (backend) {
+          case LIGHTEX_BACKEND_HTML:
+            workspace_backend = lightex::backends::MakeHtmlBackend();
+            break;
+
+          case LIGHTEX_BACKEND_TEXT:
+            workspace_backend = lightex::backends::MakeTextBackend();
+            break;
+
+          case LIGHTEX_BACKEND_DOT:
+            workspace_backend = lightex::backends::MakeDotBackend();
+            break;
+
+          case LIGHTEX_BACKEND_JSON_AST:
+            workspace_backend = lightex::backends::MakeJsonAstBackend(lightex::ast_exporter::kUnlimitedDepth);
+            break;
+
+          case LIGHTEX_BACKEND_BINARY_AST:
+            workspace_backend = lightex::backends::MakeBinaryAstBackend(lightex::ast_exporter::kUnlimitedDepth);
+            break;
+
+          default:
+            return 0;
+        }
+
+        auto engine = std::make_shared<lightex::engine::Engine>();
+        std::shared_ptr<lightex::patch_renderer::PatchRenderer> patch_renderer;
+        if (backend == LIGHTEX_BACKEND_HTML) {
+          patch_renderer = std::make_shared<lightex::patch_renderer::PatchRenderer>(engine);
+        }
+        workspace =
+            new lightex_workspace{engine, lightex::MakeWorkspace(engine, workspace_backend), std::move(patch_renderer)};
+        return 1;
+      },
+      nullptr);
+  return workspace;
+}
+
+void lightex_workspace_free(lightex_workspace* workspace) {
+  delete workspace;
+}
+
+int lightex_workspace_load_style(lightex_workspace* workspace, const char* style_file_path, char** error_message) {
+  if (!workspace || !style_file_path) {
+    return Fail("No workspace or style file path is provided.", error_message);
+  }
+
+  return CallGuarded(
+      [&]() {
+        std::string load_error_message;
+        if (!workspace->workspace->LoadStyle(style_file_path, &load_error_message)) {
+          return Fail(load_error_message, error_message);
+        }
+        return 1;
+      },
+      error_message);
+}
+
+int lightex_workspace_render(lightex_workspace* workspace,
+                             const char* input,
+                             size_t input_size,
+                             char** output,
+                             size_t* output_size,
+                             char** error_message) {
+  if (!workspace || (!input && input_size > 0) || !output) {
+    return Fail("No workspace, input or place for the output is provided.", error_message);
+  }
+
+  return CallGuarded(
+      [&]() {
+        std::string result;
+        std::string render_error_message;
+        if (!workspace->workspace->ParseProgram(std::string(input, input_size), &render_error_message, &result)) {
+          return Fail(render_error_message, error_message);
+        }
+        return ReturnOutput(result, output, output_size, error_message);
+      },
+      error_message);
+}
+
+int lightex_workspace_render_with_style(lightex_workspace* workspace,
+                                        const char* style_file_path,
+                                        const char* input,
+                                        size_t input_size,
+                                        char** output,
+                                        size_t* output_size,
+                                        char** error_message) {
+  if (!workspace || !style_file_path || (!input && input_size > 0) || !output) {
+    return Fail("No workspace, style file path, input or place for the output is provided.", error_message);
+  }
+
+  return CallGuarded(
+      [&]() {
+        std::string result;
+        std::string render_error_message;
+        if (!workspace->workspace->ParseProgramWithStyle(style_file_path, std::string(input, input_size),
+                                                         &render_error_message, &result)) {
+          return Fail(render_error_message, error_message);
+        }
+        return ReturnOutput(result, output, output_size, error_message);
+      },
+      error_message);
+}
+
+int lightex_workspace_render_patch(lightex_workspace* workspace,
+                                   const char* document_id,
+                                   const char* input,
+                                   size_t input_size,
+                                   char** output,
+                                   size_t* output_size,
+                                   char** error_message) {
+  if (!workspace || !document_id || (!input && input_size > 0) || !output) {
+    return Fail("No workspace, document id, input or place for the output is provided.", error_message);
+  }
+
+  if (!workspace->patch_renderer) {
+    return Fail("Only HTML workspaces can make patches.", error_message);
+  }
+
+  return CallGuarded(
+      [&]() {
+        std::string result;
+        std::string render_error_message;
+        if (!workspace->patch_renderer->ParseProgramToPatch(document_id, std::string(input, input_size),
+                                                            &render_error_message, &result)) {
+          return Fail(render_error_message, error_message);
+        }
+        return ReturnOutput(result, output, output_size, error_message);
+      },
+      error_message);
+}
+
+void lightex_workspace_forget_document(lightex_workspace* workspace, const char* document_id) {
+  if (!workspace || !workspace->patch_renderer || !document_id) {
+    return;
+  }
+
+  workspace->patch_renderer->ForgetDocument(document_id);
+}
+
+void lightex_workspace_get_style_cache_stats(const lightex_workspace* workspace, lightex_style_cache_stats* stats) {
+  if (!workspace || !stats) {
+    return;
+  }
+
+  const lightex::style_cache::Stats workspace_stats = workspace->engine->GetStyleCacheStats();
+  stats->hits_num = workspace_stats.hits_num;
+  stats->misses_num = workspace_stats.misses_num;
+  stats->evictions_num = workspace_stats.evictions_num;
+  stats->size_bytes = workspace_stats.size_bytes;
+  stats->styles_num = workspace_stats.styles_num;
+}
+
+void lightex_free(void* buffer) {
+  std::free(buffer);
+}
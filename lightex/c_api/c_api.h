@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// C interface of Workspace, built into the liblightex_c shared library for bindings such as utils/lightex.py.
+//
+// Functions returning int return 1 on success and 0 on failure. On failure they store a description of the error in
+// |*error_message| if |error_message| isn't NULL. Strings and buffers returned by the library must be released with
+// lightex_free. Workspaces are safe to render with from several threads at once, once their style is loaded.
+//
+// Only new functions and new enumerators are ever added, so programs built against an older version of this header
+// keep working with newer versions of the library.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LIGHTEX_C_API_VERSION 2
+
+typedef struct lightex_workspace lightex_workspace;
+
+typedef enum {
+  LIGHTEX_BACKEND_HTML = 0,
+  LIGHTEX_BACKEND_TEXT = 1,
+  LIGHTEX_BACKEND_DOT = 2,
+  LIGHTEX_BACKEND_JSON_AST = 3,
+  LIGHTEX_BACKEND_BINARY_AST = 4,
+} lightex_backend;
+
+typedef struct {
+  uint64_t hits_num;
+  uint64_t misses_num;
+  uint64_t evictions_num;
+  // Total size of the style files of the cached styles.
+  uint64_t size_bytes;
+  uint64_t styles_num;
+} lightex_style_cache_stats;
+
+// LIGHTEX_C_API_VERSION the library was built with.
+int lightex_get_api_version(void);
+
+// Returns NULL if |backend| is unknown or the workspace can't be allocated.
+lightex_workspace* lightex_workspace_create(lightex_backend backend);
+void lightex_workspace_free(lightex_workspace* workspace);
+
+int lightex_workspace_load_style(lightex_workspace* workspace, const char* style_file_path, char** error_message);
+
+// Renders |input_size| bytes of |input| with the loaded style. The output isn't NUL terminated in general, e.g. for
+// binary AST exports, but a NUL byte follows its |*output_size| bytes.
+int lightex_workspace_render(lightex_workspace* workspace,
+                             const char* input,
+                             size_t input_size,
+                             char** output,
+                             size_t* output_size,
+                             char** error_message);
+
+// Same as lightex_workspace_render, but renders with the style in |style_file_path| alone, see
+// Workspace::ParseProgramWithStyle.
+int lightex_workspace_render_with_style(lightex_workspace* workspace,
+                                        const char* style_file_path,
+                                        const char* input,
+                                        size_t input_size,
+                                        char** output,
+                                        size_t* output_size,
+                                        char** error_message);
+
+// Renders |input_size| bytes of |input| into a patch of the previous render of the document |document_id|, see
+// PatchRenderer::ParseProgramToPatch. HTML workspaces only, added in version 2.
+int lightex_workspace_render_patch(lightex_workspace* workspace,
+                                   const char* document_id,
+                                   const char* input,
+                                   size_t input_size,
+                                   char** output,
+                                   size_t* output_size,
+                                   char** error_message);
+
+// Drops the render kept for the document |document_id|. Added in version 2.
+void lightex_workspace_forget_document(lightex_workspace* workspace, const char* document_id);
+
+void lightex_workspace_get_style_cache_stats(const lightex_workspace* workspace, lightex_style_cache_stats* stats);
+
+void lightex_free(void* buffer);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
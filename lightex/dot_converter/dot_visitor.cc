@@ -1,5 +1,9 @@
 #include <lightex/dot_converter/dot_visitor.h>
 
+#include <algorithm>
+
+#include <boost/variant/static_visitor.hpp>
+
 namespace lightex {
 namespace dot_converter {
 namespace {
@@ -21,59 +25,118 @@ std::string EscapeForDot(const std::string& s) {
 }
 }  // namespace
 
-DotVisitor::DotVisitor(std::string* output) : output_(output), next_node_id_(0) {}
+class DotVisitor::NodePrinter : public boost::static_visitor<NodeId> {
+ public:
+  explicit NodePrinter(DotVisitor* visitor) : visitor_(visitor) {}
+
+  template <typename Node>
+  NodeId operator()(const Node& node) const {
+    return visitor_->Print(node);
+  }
+
+ private:
+  DotVisitor* visitor_;  // Not owned.
+};
+
+DotVisitor::DotVisitor(const ast::SymbolTable* symbol_table, std::string* output)
+    : symbol_table_(symbol_table), next_node_id_(0), output_(output) {}
 
 NodeId DotVisitor::operator()(const ast::Program& program) {
+  tasks_.push_back({Task::Type::kPrintProgram, &program, "", ""});
+  while (!tasks_.empty()) {
+    const Task task = std::move(tasks_.back());
+    tasks_.pop_back();
+
+    if (task.type == Task::Type::kPrintEdge) {
+      AppendToOutput("  " + task.parent_id + " -> " + child_ids_.back() + task.edge_attributes + ";\n");
+      child_ids_.pop_back();
+      continue;
+    }
+
+    const std::size_t children_begin = tasks_.size();
+    child_ids_.push_back(PrintNode(task));
+    // Children were scheduled in order, so the first one has to be moved to the top.
+    std::reverse(tasks_.begin() + children_begin, tasks_.end());
+  }
+
+  const NodeId node_id = child_ids_.back();
+  child_ids_.pop_back();
+  return node_id;
+}
+
+NodeId DotVisitor::PrintNode(const Task& task) {
+  switch (task.type) {
+    case Task::Type::kPrintProgram:
+      return Print(*static_cast<const ast::Program*>(task.node));
+
+    case Task::Type::kPrintArgument:
+      return Print(*static_cast<const ast::Argument*>(task.node));
+
+    case Task::Type::kPrintProgramNode:
+      return boost::apply_visitor(NodePrinter(this), *static_cast<const ast::ProgramNode*>(task.node));
+
+    case Task::Type::kPrintParagraphNode:
+      return boost::apply_visitor(NodePrinter(this), *static_cast<const ast::ParagraphNode*>(task.node));
+
+    case Task::Type::kPrintArgumentNode:
+      return boost::apply_visitor(NodePrinter(this), *static_cast<const ast::ArgumentNode*>(task.node));
+
+    case Task::Type::kPrintEdge:
+      break;
+  }
+
+  return NodeId();
+}
+
+NodeId DotVisitor::Print(const ast::Program& program) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"PROGRAM\"];\n");
 
-  for (const auto& program_node : program.nodes) {
-    NodeId child_id = boost::apply_visitor(*this, program_node);
-    AppendToOutput("  " + node_id + " -> " + child_id + ";\n");
-  }
+  ScheduleChildren(node_id, program.nodes);
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::PlainText& plain_text) {
+NodeId DotVisitor::Print(const ast::PlainText& plain_text) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"PLAIN_TEXT = <" + EscapeForDot(plain_text.text) + ">\"];\n");
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::Paragraph& paragraph) {
+NodeId DotVisitor::Print(const ast::HtmlEntity& html_entity) {
+  NodeId node_id = GenerateNodeId();
+  AppendToOutput("  " + node_id + " [label=\"HTML_ENTITY = <" + EscapeForDot(html_entity.text) + ">\"];\n");
+
+  return node_id;
+}
+
+NodeId DotVisitor::Print(const ast::Paragraph& paragraph) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"PARAGRAPH\"];\n");
 
-  for (const auto& paragraph_node : paragraph.nodes) {
-    NodeId child_id = boost::apply_visitor(*this, paragraph_node);
-    AppendToOutput("  " + node_id + " -> " + child_id + ";\n");
-  }
+  ScheduleChildren(node_id, paragraph.nodes);
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::ParagraphBreaker& paragraph_breaker) {
+NodeId DotVisitor::Print(const ast::ParagraphBreaker& paragraph_breaker) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"PARAGRAPH_BREAKER\"];\n");
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::Argument& argument) {
+NodeId DotVisitor::Print(const ast::Argument& argument) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"ARGUMENT\"];\n");
 
-  for (const auto& argument_node : argument.nodes) {
-    NodeId child_id = boost::apply_visitor(*this, argument_node);
-    AppendToOutput("  " + node_id + " -> " + child_id + ";\n");
-  }
+  ScheduleChildren(node_id, argument.nodes);
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::ArgumentRef& argument_ref) {
+NodeId DotVisitor::Print(const ast::ArgumentRef& argument_ref) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"ARGUMENT_REF = <argument_id=");
   AppendToOutput(std::to_string(argument_ref.argument_id));
@@ -82,7 +145,7 @@ NodeId DotVisitor::operator()(const ast::ArgumentRef& argument_ref) {
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::OuterArgumentRef& outer_argument_ref) {
+NodeId DotVisitor::Print(const ast::OuterArgumentRef& outer_argument_ref) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"OUTER_ARGUMENT_REF = <argument_id=");
   AppendToOutput(std::to_string(outer_argument_ref.argument_id));
@@ -91,118 +154,107 @@ NodeId DotVisitor::operator()(const ast::OuterArgumentRef& outer_argument_ref) {
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::InlinedMathText& math_text) {
+NodeId DotVisitor::Print(const ast::InlinedMathText& math_text) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"INLINED_MATH_TEXT = <" + EscapeForDot(math_text.text) + ">\"];\n");
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::MathText& math_text) {
+NodeId DotVisitor::Print(const ast::MathText& math_text) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"MATH_TEXT = <" + EscapeForDot(math_text.text) + ">\"];\n");
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::CommandMacro& command_macro) {
+NodeId DotVisitor::Print(const ast::CommandMacro& command_macro) {
   NodeId node_id = GenerateNodeId();
-  AppendToOutput("  " + node_id + " [label=\"COMMAND_MACRO = <name=" + command_macro.name);
+  AppendToOutput("  " + node_id + " [label=\"COMMAND_MACRO = <name=" + symbol_table_->GetName(command_macro.name));
   AppendToOutput(" argument=");
   AppendToOutput(std::to_string(command_macro.arguments_num.value_or(0)));
   AppendToOutput(">\"];\n");
 
   for (const auto& argument : command_macro.default_arguments) {
-    NodeId child_id = (*this)(argument);
-    AppendToOutput("  " + node_id + " -> " + child_id + " [style=dotted];\n");
+    ScheduleChild(node_id, argument, " [style=dotted]");
   }
 
-  NodeId child_id = (*this)(command_macro.body);
-  AppendToOutput("  " + node_id + " -> " + child_id + ";\n");
+  ScheduleChild(node_id, command_macro.body, "");
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::EnvironmentMacro& environment_macro) {
+NodeId DotVisitor::Print(const ast::EnvironmentMacro& environment_macro) {
   NodeId node_id = GenerateNodeId();
-  AppendToOutput("  " + node_id + " [label=\"ENVIRONMENT_MACRO = <name=" + environment_macro.name);
+  AppendToOutput("  " + node_id + " [label=\"ENVIRONMENT_MACRO = <name=" +
+                 symbol_table_->GetName(environment_macro.name));
   AppendToOutput(" argument=");
   AppendToOutput(std::to_string(environment_macro.arguments_num.value_or(0)));
   AppendToOutput(">\"];\n");
 
   for (const auto& argument : environment_macro.default_arguments) {
-    NodeId child_id = (*this)(argument);
-    AppendToOutput("  " + node_id + " -> " + child_id + " [style=dotted];\n");
+    ScheduleChild(node_id, argument, " [style=dotted]");
   }
 
-  NodeId pre_child_id = (*this)(environment_macro.pre_program);
-  AppendToOutput("  " + node_id + " -> " + pre_child_id + " [color=red];\n");
+  ScheduleChild(node_id, environment_macro.pre_program, " [color=red]");
 
-  NodeId post_child_id = (*this)(environment_macro.post_program);
-  AppendToOutput("  " + node_id + " -> " + post_child_id + " [color=blue];\n");
+  ScheduleChild(node_id, environment_macro.post_program, " [color=blue]");
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::Command& command) {
+NodeId DotVisitor::Print(const ast::Command& command) {
   NodeId node_id = GenerateNodeId();
-  AppendToOutput("  " + node_id + " [label=\"COMMAND = <name=" + command.name + ">\"];\n");
+  AppendToOutput("  " + node_id + " [label=\"COMMAND = <name=" + symbol_table_->GetName(command.name) + ">\"];\n");
 
   for (const auto& argument : command.default_arguments) {
-    NodeId child_id = (*this)(argument);
-    AppendToOutput("  " + node_id + " -> " + child_id + " [style=dotted];\n");
+    ScheduleChild(node_id, argument, " [style=dotted]");
   }
 
   for (const auto& argument : command.arguments) {
-    NodeId child_id = (*this)(argument);
-    AppendToOutput("  " + node_id + " -> " + child_id + ";\n");
+    ScheduleChild(node_id, argument, "");
   }
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::UnescapedCommand& unescaped_command) {
+NodeId DotVisitor::Print(const ast::UnescapedCommand& unescaped_command) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"UNESCAPED_COMMAND\"];\n");
 
-  NodeId child_id = (*this)(unescaped_command.body);
-  AppendToOutput("  " + node_id + " -> " + child_id + ";\n");
+  ScheduleChild(node_id, unescaped_command.body, "");
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::NparagraphCommand& nparagraph_command) {
+NodeId DotVisitor::Print(const ast::NparagraphCommand& nparagraph_command) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"NPARAGRAPH_COMMAND\"];\n");
 
-  NodeId child_id = (*this)(nparagraph_command.body);
-  AppendToOutput("  " + node_id + " -> " + child_id + ";\n");
+  ScheduleChild(node_id, nparagraph_command.body, "");
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::Environment& environment) {
+NodeId DotVisitor::Print(const ast::Environment& environment) {
   NodeId node_id = GenerateNodeId();
-  AppendToOutput("  " + node_id + " [label=\"ENVIRONMENT = <name=" + environment.name);
-  AppendToOutput(" end_name=" + environment.end_name + ">\"];\n");
+  AppendToOutput("  " + node_id + " [label=\"ENVIRONMENT = <name=" + symbol_table_->GetName(environment.name));
+  AppendToOutput(" end_name=" + symbol_table_->GetName(environment.end_name) + ">\"];\n");
 
   for (const auto& argument : environment.default_arguments) {
-    NodeId child_id = (*this)(argument);
-    AppendToOutput("  " + node_id + " -> " + child_id + " [style=dotted];\n");
+    ScheduleChild(node_id, argument, " [style=dotted]");
   }
 
   for (const auto& argument : environment.arguments) {
-    NodeId child_id = (*this)(argument);
-    AppendToOutput("  " + node_id + " -> " + child_id + " [style=dotted];\n");
+    ScheduleChild(node_id, argument, " [style=dotted]");
   }
 
-  NodeId body_child_id = (*this)(environment.program);
-  AppendToOutput("  " + node_id + " -> " + body_child_id + ";\n");
+  ScheduleChild(node_id, environment.program, "");
 
   return node_id;
 }
 
-NodeId DotVisitor::operator()(const ast::VerbatimEnvironment& verbatim_environment) {
+NodeId DotVisitor::Print(const ast::VerbatimEnvironment& verbatim_environment) {
   NodeId node_id = GenerateNodeId();
   AppendToOutput("  " + node_id + " [label=\"VERBATIM_ENVIRONMENT\" content=\"" + verbatim_environment.content +
                  "\"];\n");
@@ -210,6 +262,44 @@ NodeId DotVisitor::operator()(const ast::VerbatimEnvironment& verbatim_environme
   return node_id;
 }
 
+void DotVisitor::ScheduleChild(const NodeId& parent_id, const ast::Program& program, const char* edge_attributes) {
+  tasks_.push_back({Task::Type::kPrintProgram, &program, "", ""});
+  tasks_.push_back({Task::Type::kPrintEdge, nullptr, parent_id, edge_attributes});
+}
+
+void DotVisitor::ScheduleChild(const NodeId& parent_id, const ast::Argument& argument, const char* edge_attributes) {
+  tasks_.push_back({Task::Type::kPrintArgument, &argument, "", ""});
+  tasks_.push_back({Task::Type::kPrintEdge, nullptr, parent_id, edge_attributes});
+}
+
+void DotVisitor::ScheduleChild(const NodeId& parent_id,
+                               const ast::ProgramNode& program_node,
+                               const char* edge_attributes) {
+  tasks_.push_back({Task::Type::kPrintProgramNode, &program_node, "", ""});
+  tasks_.push_back({Task::Type::kPrintEdge, nullptr, parent_id, edge_attributes});
+}
+
+void DotVisitor::ScheduleChild(const NodeId& parent_id,
+                               const ast::ParagraphNode& paragraph_node,
+                               const char* edge_attributes) {
+  tasks_.push_back({Task::Type::kPrintParagraphNode, &paragraph_node, "", ""});
+  tasks_.push_back({Task::Type::kPrintEdge, nullptr, parent_id, edge_attributes});
+}
+
+void DotVisitor::ScheduleChild(const NodeId& parent_id,
+                               const ast::ArgumentNode& argument_node,
+                               const char* edge_attributes) {
+  tasks_.push_back({Task::Type::kPrintArgumentNode, &argument_node, "", ""});
+  tasks_.push_back({Task::Type::kPrintEdge, nullptr, parent_id, edge_attributes});
+}
+
+template <typename Node>
+void DotVisitor::ScheduleChildren(const NodeId& parent_id, const std::list<Node>& nodes) {
+  for (const auto& node : nodes) {
+    ScheduleChild(parent_id, node, "");
+  }
+}
+
 NodeId DotVisitor::GenerateNodeId() {
   return "node_" + std::to_string(next_node_id_++);
 }
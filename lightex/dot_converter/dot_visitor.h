@@ -1,44 +1,85 @@
 #pragma once
 
+#include <list>
 #include <string>
+#include <vector>
 
 #include <lightex/ast/ast.h>
-
-#include <boost/variant/static_visitor.hpp>
+#include <lightex/ast/symbol_table.h>
 
 namespace lightex {
 namespace dot_converter {
 
 using NodeId = std::string;
 
-// Returns node id.
-class DotVisitor : public boost::static_visitor<NodeId> {
+// Writes the AST as a graph in the DOT language. Nodes are printed from a work stack instead of recursion, so deep
+// programs don't exhaust the thread stack.
+class DotVisitor {
  public:
-  DotVisitor(std::string* output);
+  DotVisitor(const ast::SymbolTable* symbol_table, std::string* output);
 
+  // Returns the id of the program node.
   NodeId operator()(const ast::Program& program);
-  NodeId operator()(const ast::PlainText& plain_text);
-  NodeId operator()(const ast::Paragraph& paragraph);
-  NodeId operator()(const ast::ParagraphBreaker& paragraph_breaker);
-  NodeId operator()(const ast::Argument& argument);
-  NodeId operator()(const ast::ArgumentRef& argument_ref);
-  NodeId operator()(const ast::OuterArgumentRef& outer_argument_ref);
-  NodeId operator()(const ast::InlinedMathText& inlined_math_text);
-  NodeId operator()(const ast::MathText& math_text);
-  NodeId operator()(const ast::CommandMacro& command_macro);
-  NodeId operator()(const ast::EnvironmentMacro& environment_macro);
-  NodeId operator()(const ast::Command& command);
-  NodeId operator()(const ast::UnescapedCommand& unescaped_command);
-  NodeId operator()(const ast::NparagraphCommand& nparagraph_command);
-  NodeId operator()(const ast::Environment& environment);
-  NodeId operator()(const ast::VerbatimEnvironment& verbatim_environment);
 
  private:
+  class NodePrinter;
+
+  // Prints a node and schedules its children, or prints the edge from |parent_id| to the child printed last.
+  struct Task {
+    enum class Type {
+      kPrintProgram,
+      kPrintArgument,
+      kPrintProgramNode,
+      kPrintParagraphNode,
+      kPrintArgumentNode,
+      kPrintEdge,
+    };
+
+    Type type;
+    const void* node;  // Not owned.
+    NodeId parent_id;
+    const char* edge_attributes;
+  };
+
+  // Prints the node of the task and returns its id.
+  NodeId PrintNode(const Task& task);
+  NodeId Print(const ast::Program& program);
+  NodeId Print(const ast::PlainText& plain_text);
+  NodeId Print(const ast::HtmlEntity& html_entity);
+  NodeId Print(const ast::Paragraph& paragraph);
+  NodeId Print(const ast::ParagraphBreaker& paragraph_breaker);
+  NodeId Print(const ast::Argument& argument);
+  NodeId Print(const ast::ArgumentRef& argument_ref);
+  NodeId Print(const ast::OuterArgumentRef& outer_argument_ref);
+  NodeId Print(const ast::InlinedMathText& inlined_math_text);
+  NodeId Print(const ast::MathText& math_text);
+  NodeId Print(const ast::CommandMacro& command_macro);
+  NodeId Print(const ast::EnvironmentMacro& environment_macro);
+  NodeId Print(const ast::Command& command);
+  NodeId Print(const ast::UnescapedCommand& unescaped_command);
+  NodeId Print(const ast::NparagraphCommand& nparagraph_command);
+  NodeId Print(const ast::Environment& environment);
+  NodeId Print(const ast::VerbatimEnvironment& verbatim_environment);
+
+  // Children are printed in the order they are scheduled, after the node itself.
+  void ScheduleChild(const NodeId& parent_id, const ast::Program& program, const char* edge_attributes);
+  void ScheduleChild(const NodeId& parent_id, const ast::Argument& argument, const char* edge_attributes);
+  void ScheduleChild(const NodeId& parent_id, const ast::ProgramNode& program_node, const char* edge_attributes);
+  void ScheduleChild(const NodeId& parent_id, const ast::ParagraphNode& paragraph_node, const char* edge_attributes);
+  void ScheduleChild(const NodeId& parent_id, const ast::ArgumentNode& argument_node, const char* edge_attributes);
+  template <typename Node>
+  void ScheduleChildren(const NodeId& parent_id, const std::list<Node>& nodes);
+
   NodeId GenerateNodeId();
   void AppendToOutput(const std::string& s);
 
+  const ast::SymbolTable* symbol_table_;  // Not owned.
   int next_node_id_;
   std::string* output_;  // Not owned;
+
+  std::vector<Task> tasks_;
+  // Ids of the printed nodes whose edge from the parent isn't printed yet.
+  std::vector<NodeId> child_ids_;
 };
 
 }  // namespace dot_converter
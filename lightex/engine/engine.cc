@@ -0,0 +1,252 @@
+#include <lightex/engine/engine.h>
+
+#include <future>
+#include <vector>
+
+#include <lightex/grammar/grammar.h>
+#include <lightex/lexer/nesting_depth.h>
+#include <lightex/lexer/paragraph_splitter.h>
+#include <lightex/utils/file_utils.h>
+#include <lightex/utils/utf8_utils.h>
+
+#include <boost/spirit/home/x3.hpp>
+
+namespace lightex {
+namespace engine {
+namespace {
+
+const char kSyntaxParsingError[] = "Error while running syntax analysis! Failed on the following snippet: ";
+const int kFailedSnippetLength = 30;
+const std::size_t kMinParallelChunkSize = 64 * 1024;
+const std::uint64_t kDefaultStyleCacheSizeBytes = 4 << 20;
+
+namespace x3 = boost::spirit::x3;
+
+// Parses chunks of the input between top-level paragraph breaks on separate threads and joins the results. The
+// joined program is exactly the one a serial parse produces, and if any chunk fails to parse on its own, the input is
+// parsed serially, so that errors are reported the same way too.
+bool ParseProgramToAstInParallel(const std::string& input,
+                                 int threads_num,
+                                 ast::SymbolTable* symbol_table,
+                                 std::string* error_message,
+                                 ast::Program* output) {
+  std::vector<std::size_t> chunk_offsets;
+  if (!output || threads_num < 2 ||
+      !lexer::SplitAtTopLevelParagraphBreaks(input, threads_num, kMinParallelChunkSize, &chunk_offsets)) {
+    return Engine::ParseRangeToAst(input, 0, input.size(), symbol_table, error_message, output);
+  }
+
+  const std::size_t chunks_num = chunk_offsets.size() - 1;
+  std::vector<ast::Program> chunk_programs(chunks_num);
+  std::vector<std::future<bool>> chunk_results;
+  for (std::size_t i = 1; i < chunks_num; ++i) {
+    chunk_results.push_back(std::async(std::launch::async, Engine::ParseRangeToAst, std::cref(input),
+                                       chunk_offsets[i], chunk_offsets[i + 1], symbol_table, nullptr,
+                                       &chunk_programs[i]));
+  }
+
+  bool is_successful =
+      Engine::ParseRangeToAst(input, chunk_offsets[0], chunk_offsets[1], symbol_table, nullptr, &chunk_programs[0]);
+  for (auto& chunk_result : chunk_results) {
+    is_successful = chunk_result.get() && is_successful;
+  }
+  if (!is_successful) {
+    return Engine::ParseRangeToAst(input, 0, input.size(), symbol_table, error_message, output);
+  }
+
+  *output = std::move(chunk_programs.front());
+  for (std::size_t i = 1; i < chunks_num; ++i) {
+    output->nodes.splice(output->nodes.end(), chunk_programs[i].nodes);
+  }
+  output->id_last = chunk_programs.back().id_last;
+
+  return true;
+}
+}  // namespace
+
+Engine::Engine()
+    : style_(std::make_shared<style_cache::CompiledStyle>()), style_cache_(kDefaultStyleCacheSizeBytes) {}
+
+bool Engine::LoadStyle(const std::string& style_file_path, std::string* error_message) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  std::shared_ptr<const style_cache::CompiledStyle> style = CompileStyle(style_file_path, *style_, error_message);
+  if (!style) {
+    return false;
+  }
+
+  style_ = style;
+  return true;
+}
+
+std::shared_ptr<const style_cache::CompiledStyle> Engine::GetLoadedStyle() const {
+  std::unique_lock<std::mutex> lock(mtx_);
+  return style_;
+}
+
+std::shared_ptr<const style_cache::CompiledStyle> Engine::GetStyle(const std::string& style_file_path,
+                                                                   std::string* error_message) {
+  const auto compiler = [this](const std::string& style_id, std::string* compilation_error_message) {
+    return CompileStyle(style_id, style_cache::CompiledStyle(), compilation_error_message);
+  };
+  return style_cache_.Get(style_file_path, compiler, error_message);
+}
+
+bool Engine::ParseProgramToAst(const std::string& input,
+                               ast::SymbolTable* symbol_table,
+                               std::string* error_message,
+                               ast::Program* output) {
+  std::string normalized_input;
+  std::size_t invalid_offset = 0;
+  if (!utils::NormalizeUtf8Input(input, &normalized_input, &invalid_offset)) {
+    if (error_message) {
+      *error_message = kInvalidUtf8Error + std::to_string(invalid_offset);
+    }
+    return false;
+  }
+
+  if (ast_cache_ && output && ast_cache_->Load(normalized_input, symbol_table, output)) {
+    return true;
+  }
+
+  if (!lexer::CheckNestingDepth(normalized_input, 0, max_nesting_depth_, error_message) ||
+      !ParseProgramToAstInParallel(normalized_input, parsing_threads_num_, symbol_table, error_message, output)) {
+    return false;
+  }
+
+  if (ast_cache_) {
+    ast_cache_->Store(normalized_input, *symbol_table, *output);
+  }
+  return true;
+}
+
+bool Engine::ParseRangeToAst(const std::string& input,
+                             std::size_t first,
+                             std::size_t last,
+                             ast::SymbolTable* symbol_table,
+                             std::string* error_message,
+                             ast::Program* output) {
+  if (!symbol_table || !output) {
+    return false;
+  }
+
+  std::string::const_iterator start = input.begin();
+  std::string::const_iterator iter = start + first;
+  std::string::const_iterator end = start + last;
+  const auto parser =
+      x3::with<grammar::InputBeginTag>(start)[x3::with<grammar::SymbolTableTag>(*symbol_table)[grammar::program]];
+  if (!x3::phrase_parse(iter, end, parser, grammar::skipper, *output) || iter < end) {
+    if (error_message) {
+      std::size_t failed_at = iter - start;
+      *error_message = kSyntaxParsingError;
+      *error_message = input.substr(failed_at, failed_at + kFailedSnippetLength);
+      if (failed_at + kFailedSnippetLength + 1 < input.size()) {
+        *error_message += "...";
+      }
+    }
+    return false;
+  }
+
+  return true;
+}
+
+html_converter::HtmlVisitor Engine::CopyHtmlVisitor(const style_cache::CompiledStyle& style,
+                                                    const ast::SymbolTable* symbol_table) const {
+  html_converter::HtmlVisitor visitor = style.html_visitor;
+  visitor.SetSymbolTable(symbol_table);
+  visitor.SetProfiler(macro_profiler_.get());
+  visitor.SetMaxExpansionDepth(max_expansion_depth_);
+  return visitor;
+}
+
+text_converter::TextVisitor Engine::CopyTextVisitor(const style_cache::CompiledStyle& style,
+                                                    const ast::SymbolTable* symbol_table) const {
+  text_converter::TextVisitor visitor = style.text_visitor;
+  visitor.SetSymbolTable(symbol_table);
+  visitor.SetMaxExpansionDepth(max_expansion_depth_);
+  return visitor;
+}
+
+void Engine::SetStyleCacheMaxSizeBytes(std::uint64_t max_size_bytes) {
+  style_cache_.SetMaxSizeBytes(max_size_bytes);
+}
+
+style_cache::Stats Engine::GetStyleCacheStats() const {
+  return style_cache_.GetStats();
+}
+
+bool Engine::EnableAstCache(const std::string& directory, std::uint64_t max_size_bytes, std::string* error_message) {
+  auto ast_cache = std::make_shared<ast_cache::AstCache>(directory, max_size_bytes);
+  if (!ast_cache->Initialize(error_message)) {
+    return false;
+  }
+
+  ast_cache_ = ast_cache;
+  return true;
+}
+
+bool Engine::ClearAstCache(std::string* error_message) {
+  if (!ast_cache_) {
+    if (error_message) {
+      *error_message = "AST cache is not enabled.";
+    }
+    return false;
+  }
+
+  return ast_cache_->Clear(error_message);
+}
+
+void Engine::SetParsingThreadsNum(int threads_num) {
+  parsing_threads_num_ = threads_num;
+}
+
+void Engine::SetNestingLimits(int max_nesting_depth, int max_expansion_depth) {
+  max_nesting_depth_ = max_nesting_depth;
+  max_expansion_depth_ = max_expansion_depth;
+}
+
+void Engine::SetMacroProfiler(std::shared_ptr<html_converter::MacroProfiler> macro_profiler) {
+  macro_profiler_ = macro_profiler;
+}
+
+std::shared_ptr<const style_cache::CompiledStyle> Engine::CompileStyle(const std::string& style_file_path,
+                                                                       const style_cache::CompiledStyle& base_style,
+                                                                       std::string* error_message) {
+  std::string input;
+  if (!lightex::utils::ReadDataFromFile(style_file_path, &input)) {
+    if (error_message) {
+      *error_message = "Failed to read style file " + style_file_path + ".";
+    }
+    return nullptr;
+  }
+
+  auto style = std::make_shared<style_cache::CompiledStyle>(base_style);
+  ast::Program ast;
+  if (!ParseProgramToAst(input, style->symbol_table.get(), error_message, &ast)) {
+    return nullptr;
+  }
+
+  style->html_visitor.SetMaxExpansionDepth(max_expansion_depth_);
+  html_converter::Result result = style->html_visitor(ast);
+  if (!result.is_successful) {
+    if (error_message) {
+      *error_message = result.error_message;
+    }
+    return nullptr;
+  }
+  style->html_visitor.FoldConstantMacros();
+
+  style->text_visitor.SetMaxExpansionDepth(max_expansion_depth_);
+  if (!style->text_visitor(ast)) {
+    if (error_message) {
+      *error_message = style->text_visitor.GetErrorMessage();
+    }
+    return nullptr;
+  }
+  style->text_visitor.TakeOutput();
+
+  style->source_size_bytes += input.size();
+  return style;
+}
+
+}  // namespace engine
+}  // namespace lightex
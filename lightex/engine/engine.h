@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <lightex/ast/ast.h>
+#include <lightex/ast/symbol_table.h>
+#include <lightex/ast_cache/ast_cache.h>
+#include <lightex/html_converter/html_visitor.h>
+#include <lightex/html_converter/macro_profiler.h>
+#include <lightex/style_cache/style_cache.h>
+#include <lightex/text_converter/text_visitor.h>
+
+namespace lightex {
+namespace engine {
+
+constexpr char kInvalidUtf8Error[] = "Input is not valid UTF-8! Invalid byte sequence at offset ";
+
+// Parses programs and compiles styles for a workspace and the components rendering along with it (see workspace.h):
+// they share the loaded style, the caches and the limits of the engine. Thread safe, except for the setters, which
+// should be called before parsing anything.
+class Engine {
+ public:
+  Engine();
+
+  // Compiles the style in |style_file_path| on top of the loaded one and replaces it.
+  bool LoadStyle(const std::string& style_file_path, std::string* error_message);
+  std::shared_ptr<const style_cache::CompiledStyle> GetLoadedStyle() const;
+  // The style in |style_file_path| alone, taken from the style cache. Returns nullptr on failure.
+  std::shared_ptr<const style_cache::CompiledStyle> GetStyle(const std::string& style_file_path,
+                                                             std::string* error_message);
+
+  // Offsets in the AST refer to the normalized input (see utils/utf8_utils.h), names are interned into |symbol_table|.
+  bool ParseProgramToAst(const std::string& input,
+                         ast::SymbolTable* symbol_table,
+                         std::string* error_message,
+                         ast::Program* output);
+  // Parses the part [first, last) of a normalized input without the AST cache and the nesting limit. Offsets stored in
+  // the AST are relative to the beginning of the whole input.
+  static bool ParseRangeToAst(const std::string& input,
+                              std::size_t first,
+                              std::size_t last,
+                              ast::SymbolTable* symbol_table,
+                              std::string* error_message,
+                              ast::Program* output);
+
+  // Visitors of |style| for programs parsed into |symbol_table|, which keep to the limits of the engine. The HTML one
+  // reports to the macro profiler.
+  html_converter::HtmlVisitor CopyHtmlVisitor(const style_cache::CompiledStyle& style,
+                                              const ast::SymbolTable* symbol_table) const;
+  text_converter::TextVisitor CopyTextVisitor(const style_cache::CompiledStyle& style,
+                                              const ast::SymbolTable* symbol_table) const;
+
+  int GetMaxNestingDepth() const { return max_nesting_depth_; }
+
+  // Bounds the total size of the style files of the styles in the cache, 4 MB by default. Styles are weighed by their
+  // source rather than by the memory they take once compiled, which is larger.
+  void SetStyleCacheMaxSizeBytes(std::uint64_t max_size_bytes);
+  style_cache::Stats GetStyleCacheStats() const;
+
+  // Keeps parsed programs in an on-disk cache in |directory| (see ast_cache/ast_cache.h).
+  bool EnableAstCache(const std::string& directory, std::uint64_t max_size_bytes, std::string* error_message);
+  bool ClearAstCache(std::string* error_message);
+
+  // Parses large inputs in chunks on up to |threads_num| threads.
+  void SetParsingThreadsNum(int threads_num);
+
+  // Rejects inputs nested deeper than |max_nesting_depth| levels, -1 means no limit (see lexer/nesting_depth.h),
+  // and fails macro expansions nested deeper than |max_expansion_depth| calls.
+  void SetNestingLimits(int max_nesting_depth, int max_expansion_depth);
+
+  // Records statistics of the HTML macro expansions into |macro_profiler|, nullptr stops recording.
+  void SetMacroProfiler(std::shared_ptr<html_converter::MacroProfiler> macro_profiler);
+
+ private:
+  // Compiles the style in |style_file_path| on top of |base_style|.
+  std::shared_ptr<const style_cache::CompiledStyle> CompileStyle(const std::string& style_file_path,
+                                                                 const style_cache::CompiledStyle& base_style,
+                                                                 std::string* error_message);
+
+  std::shared_ptr<ast_cache::AstCache> ast_cache_;
+  std::shared_ptr<html_converter::MacroProfiler> macro_profiler_;
+  int parsing_threads_num_ = 1;
+  // The parser needs thread stack for every nesting level, about 4 KB in debug builds, so services parsing untrusted
+  // inputs should limit the nesting.
+  int max_nesting_depth_ = -1;
+  int max_expansion_depth_ = html_converter::kDefaultMaxExpansionDepth;
+
+  // The loaded style, replaced as a whole by LoadStyle.
+  std::shared_ptr<const style_cache::CompiledStyle> style_;
+  mutable std::mutex mtx_;
+
+  style_cache::StyleCache style_cache_;
+};
+
+}  // namespace engine
+}  // namespace lightex
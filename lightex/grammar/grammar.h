@@ -1,9 +1,12 @@
 #pragma once
 
+#include <iterator>
 #include <string>
 
 #include <lightex/ast/ast.h>
 #include <lightex/ast/ast_adapted.h>
+#include <lightex/ast/symbol_table.h>
+#include <lightex/symbols/symbol_tables.h>
 
 #include <boost/spirit/home/x3.hpp>
 
@@ -12,12 +15,122 @@ namespace grammar {
 
 namespace x3 = boost::spirit::x3;
 
+// Context tag for the iterator pointing to the beginning of the input.
+struct InputBeginTag;
+
+// Context tag for the ast::SymbolTable that names are interned into.
+struct SymbolTableTag;
+
+// Stores byte offsets of every successfully parsed node into its x3::position_tagged base.
+struct AnnotatePosition {
+  template <typename Iterator, typename Node, typename Context>
+  void on_success(const Iterator& first, const Iterator& last, Node& node, const Context& context) const {
+    const auto& begin = x3::get<InputBeginTag>(context);
+    Annotate(first - begin, last - begin, node);
+  }
+
+ private:
+  static void Annotate(int first, int last, x3::position_tagged& node) {
+    node.id_first = first;
+    node.id_last = last;
+  }
+
+  template <typename Node>
+  static void Annotate(int first, int last, x3::forward_ast<Node>& node) {
+    Annotate(first, last, node.get());
+  }
+};
+
+// Matches the longest lookup table symbol, e.g. "---", at the current position. Candidates are checked against the
+// generated table which the HTML converter uses for their replacements, so the two can't disagree on the set.
+struct LookupTableSymbolParser : x3::parser<LookupTableSymbolParser> {
+  using attribute_type = std::string;
+
+  template <typename Iterator, typename Context, typename RContext, typename Attribute>
+  bool parse(Iterator& first, const Iterator& last, const Context& context, RContext&, Attribute& attribute) const {
+    x3::skip_over(first, last, context);
+
+    char buffer[symbols::kMaxLookupTableSymbolSize];
+    std::size_t size = 0;
+    for (Iterator it = first; it != last && size < sizeof(buffer); ++it) {
+      buffer[size++] = *it;
+    }
+
+    for (; size > 0; --size) {
+      if (symbols::FindLookupTableSymbol(buffer, size)) {
+        const Iterator symbol_last = std::next(first, size);
+        x3::traits::move_to(first, symbol_last, attribute);
+        first = symbol_last;
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+// Matches a named character reference of HTML5, e.g. "&mdash;". Unknown names fail right here instead of producing
+// broken HTML later.
+struct HtmlEntityParser : x3::parser<HtmlEntityParser> {
+  using attribute_type = std::string;
+
+  template <typename Iterator, typename Context, typename RContext, typename Attribute>
+  bool parse(Iterator& first, const Iterator& last, const Context& context, RContext&, Attribute& attribute) const {
+    x3::skip_over(first, last, context);
+    if (first == last || *first != '&') {
+      return false;
+    }
+
+    char name[symbols::kMaxHtmlEntityNameSize];
+    std::size_t size = 0;
+    Iterator it = std::next(first);
+    for (; it != last && IsAsciiAlnum(*it); ++it) {
+      if (size == sizeof(name)) {
+        return false;
+      }
+      name[size++] = *it;
+    }
+
+    if (it == last || *it != ';' || !symbols::IsHtmlEntityName(name, size)) {
+      return false;
+    }
+
+    ++it;
+    x3::traits::move_to(first, it, attribute);
+    first = it;
+    return true;
+  }
+
+ private:
+  static bool IsAsciiAlnum(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+  }
+};
+
+class ProgramId : public AnnotatePosition {};
+class PlainTextId : public AnnotatePosition {};
+class HtmlEntityId : public AnnotatePosition {};
+class ParagraphId : public AnnotatePosition {};
+class ParagraphBreakerId : public AnnotatePosition {};
+class ArgumentId : public AnnotatePosition {};
+class ArgumentRefId : public AnnotatePosition {};
+class OuterArgumentRefId : public AnnotatePosition {};
+class InlinedMathTextId : public AnnotatePosition {};
+class MathTextId : public AnnotatePosition {};
+class CommandMacroId : public AnnotatePosition {};
+class EnvironmentMacroId : public AnnotatePosition {};
+class CommandId : public AnnotatePosition {};
+class UnescapedCommandId : public AnnotatePosition {};
+class NparagraphCommandId : public AnnotatePosition {};
+class EnvironmentId : public AnnotatePosition {};
+class VerbatimEnvironmentId : public AnnotatePosition {};
+
 x3::rule<class ProgramNodeId, ast::ProgramNode> program_node = "program_node";
 x3::rule<class ParagraphNodeId, ast::ParagraphNode> paragraph_node = "paragraph_node";
 x3::rule<class ArgumentNodeId, ast::ArgumentNode> argument_node = "argument_node";
 
 x3::rule<class ProgramId, ast::Program> program = "program";
 x3::rule<class PlainTextId, ast::PlainText> plain_text = "plain_text";
+x3::rule<class HtmlEntityId, ast::HtmlEntity> html_entity = "html_entity";
 x3::rule<class ParagraphId, ast::Paragraph> paragraph = "paragraph";
 x3::rule<class ParagraphBreakerId, ast::ParagraphBreaker> paragraph_breaker = "paragraph_breaker";
 x3::rule<class ArgumentId, ast::Argument> argument = "argument";
@@ -33,32 +146,66 @@ x3::rule<class NparagraphCommandId, ast::NparagraphCommand> nparagraph_command =
 x3::rule<class EnvironmentId, ast::Environment> environment = "environment";
 x3::rule<class VerbatimEnvironmentId, ast::VerbatimEnvironment> verbatim_environment = "verbatim_environment";
 
+x3::rule<class CommandNameId, ast::SymbolId> command_name = "command_name";
+x3::rule<class EnvironmentNameId, ast::SymbolId> environment_name = "environment_name";
+
+// ASCII-only counterparts of x3::space and x3::alpha. Classification functions of the standard encoding are undefined
+// for bytes of multibyte UTF-8 sequences.
+const auto skipper = x3::char_(" \t\n\v\f\r");
+const auto letter = x3::char_("a-zA-Z");
+
 const auto special_symbol = x3::char_("\\{}$&#^_%~[]");
 const auto control_symbol = x3::lexeme['\\' >> special_symbol];
-const auto unicode_symbol = x3::lexeme[x3::char_('&') >> +x3::alpha >> x3::char_(';')];
+const auto unicode_symbol = HtmlEntityParser();
 const auto special_command_identifier =
     x3::lit("begin") | "end" | "newcommand" | "newenvironment" | "unescaped" | "nparagraph";
-const auto command_identifier = x3::lexeme['\\' >> (+x3::alpha - special_command_identifier)];
+const auto command_identifier = x3::lexeme['\\' >> (+letter - special_command_identifier)];
 const auto math_text_symbol = x3::lexeme[x3::lit('\\') >> x3::char_('$')] | (x3::char_ - x3::char_('$'));
-const auto environment_identifier = x3::lexeme[+x3::alpha] - "verbatim";
-const auto plain_text_symbol = control_symbol | (x3::char_ - special_symbol - x3::lit('\n'));
+const auto environment_identifier = x3::lexeme[+letter] - "verbatim";
+const auto intern_symbol = [](auto& context) {
+  x3::_val(context) = x3::get<SymbolTableTag>(context).Intern(x3::_attr(context));
+};
+const auto lookup_table_symbol = LookupTableSymbolParser();
+
+// Lookup table symbols only start with characters excluded from the generic plain text symbol, so the lookahead for
+// them is needed just for '-', '<' and '>' rather than for every character.
+const auto lookup_table_symbol_prefix = x3::char_("<>") | x3::char_('-');
+const auto plain_text_symbol = control_symbol | (x3::char_ - special_symbol - lookup_table_symbol_prefix - '\n') |
+                               (!lookup_table_symbol >> lookup_table_symbol_prefix);
 const auto comment = x3::omit[x3::no_skip[x3::lit('%') >> *(x3::char_ - '\n') >> (x3::eol | x3::eoi)]];
-const auto lookup_table_symbol =
-    x3::string("\\,") | x3::string("~") | x3::string("---") | x3::string("--") | x3::string("<<") | x3::string(">>");
 
-const auto program_node_def = paragraph_breaker | paragraph | math_text | environment | verbatim_environment |
-                              command_macro | environment_macro | argument_ref | outer_argument_ref | comment;
+// Predictive guards. Every node kind except plain text is recognizable by its first characters, so an alternative is
+// entered only when they match and a failed attempt never has to be undone. The guards do not skip white space:
+// leading white space belongs to the plain text of a paragraph.
+const auto starts_with_environment = x3::no_skip[&x3::lit("\\begin")];
+const auto starts_with_command_macro = x3::no_skip[&x3::lit("\\newcommand")];
+const auto starts_with_environment_macro = x3::no_skip[&x3::lit("\\newenvironment")];
+const auto starts_with_unescaped_command = x3::no_skip[&x3::lit("\\unescaped")];
+const auto starts_with_nparagraph_command = x3::no_skip[&x3::lit("\\nparagraph")];
+const auto starts_with_command = x3::no_skip[&(x3::lit('\\') >> letter)];
+const auto starts_with_math_text = x3::no_skip[&x3::lit("$$")];
+const auto starts_with_inlined_math_text = x3::no_skip[&x3::lit('$')];
+const auto starts_with_outer_argument_ref = x3::no_skip[&x3::lit("##")];
+const auto starts_with_argument_ref = x3::no_skip[&x3::lit('#')];
+
+const auto program_node_def =
+    paragraph_breaker | (starts_with_environment >> environment) | (starts_with_environment >> verbatim_environment) |
+    (starts_with_command_macro >> command_macro) | (starts_with_environment_macro >> environment_macro) |
+    (starts_with_math_text >> math_text) | (starts_with_outer_argument_ref >> outer_argument_ref) |
+    (starts_with_argument_ref >> argument_ref) | paragraph | comment;
+
+const auto plain_text_def =
+    x3::no_skip[lookup_table_symbol | x3::string("\n") |
+                (+(-x3::char_('\n') >> plain_text_symbol) >> -(&(!paragraph_breaker) >> x3::char_('\n')))];
 
-const auto plain_text_def = x3::no_skip[lookup_table_symbol | unicode_symbol | x3::string("\n") |
-                                        (+(-x3::char_('\n') >> (&(!lookup_table_symbol) >> plain_text_symbol)) >>
-                                         -(&(!paragraph_breaker) >> x3::char_('\n')))];
+const auto inline_node = (starts_with_inlined_math_text >> inlined_math_text) |
+                         (starts_with_unescaped_command >> unescaped_command) |
+                         (starts_with_nparagraph_command >> nparagraph_command) | (starts_with_command >> command);
 
-const auto paragraph_node_def = &(!paragraph_breaker) >>
-                                (plain_text | inlined_math_text | command | unescaped_command | nparagraph_command |
-                                 comment);
+const auto paragraph_node_def = &(!paragraph_breaker) >> (inline_node | html_entity | plain_text | comment);
 
-const auto argument_node_def = comment | plain_text | inlined_math_text | command | unescaped_command |
-                               nparagraph_command | argument_ref | outer_argument_ref;
+const auto argument_node_def = comment | inline_node | (starts_with_outer_argument_ref >> outer_argument_ref) |
+                               (starts_with_argument_ref >> argument_ref) | html_entity | plain_text;
 
 const auto program_def = *program_node;
 
@@ -72,25 +219,31 @@ const auto argument_ref_def = x3::lexeme[x3::lit('#') >> x3::int_];
 
 const auto outer_argument_ref_def = x3::lexeme[x3::lit("##") >> x3::int_];
 
+const auto html_entity_def = x3::no_skip[unicode_symbol];
+
 const auto inlined_math_text_def = x3::lit('$') >> x3::no_skip[+math_text_symbol] >> '$';
 
 const auto math_text_def = x3::lit("$$") >> x3::no_skip[+math_text_symbol] >> "$$";
 
-const auto command_macro_def = x3::lit("\\newcommand") >> '{' >> command_identifier >> '}' >>
+const auto command_macro_def = x3::lit("\\newcommand") >> '{' >> command_name >> '}' >>
                                -('[' >> x3::int_ >> ']' >> *('[' >> argument >> ']')) >> '{' >> argument >> '}';
 
-const auto environment_macro_def = x3::lit("\\newenvironment") >> '{' >> environment_identifier >> '}' >>
+const auto environment_macro_def = x3::lit("\\newenvironment") >> '{' >> environment_name >> '}' >>
                                    -('[' >> x3::int_ >> ']' >> *('[' >> argument >> ']')) >> '{' >> program >> '}' >>
                                    '{' >> program >> '}';
 
-const auto command_def = command_identifier >> *('[' >> argument >> ']') >> *('{' >> argument >> '}');
+const auto command_def = command_name >> *('[' >> argument >> ']') >> *('{' >> argument >> '}');
 
 const auto unescaped_command_def = x3::lit("\\unescaped") >> '{' >> argument >> '}';
 
 const auto nparagraph_command_def = x3::lit("\\nparagraph") >> '{' >> argument >> '}';
 
-const auto environment_def = x3::lit("\\begin") >> '{' >> environment_identifier >> '}' >> *('[' >> argument >> ']') >>
-                             *('{' >> argument >> '}') >> program >> "\\end" >> '{' >> environment_identifier >> '}';
+const auto environment_def = x3::lit("\\begin") >> '{' >> environment_name >> '}' >> *('[' >> argument >> ']') >>
+                             *('{' >> argument >> '}') >> program >> "\\end" >> '{' >> environment_name >> '}';
+
+const auto command_name_def = command_identifier[intern_symbol];
+
+const auto environment_name_def = environment_identifier[intern_symbol];
 
 const auto verbatim_environment_def = x3::lit("\\begin") >> '{' >> "verbatim" >> '}' >>
                                       x3::no_skip[*(x3::char_ - '\\')] >> "\\end" >> '{' >> "verbatim" >> '}';
@@ -101,6 +254,7 @@ BOOST_SPIRIT_DEFINE(argument_node)
 
 BOOST_SPIRIT_DEFINE(program)
 BOOST_SPIRIT_DEFINE(plain_text)
+BOOST_SPIRIT_DEFINE(html_entity)
 BOOST_SPIRIT_DEFINE(paragraph)
 BOOST_SPIRIT_DEFINE(paragraph_breaker)
 BOOST_SPIRIT_DEFINE(argument)
@@ -115,6 +269,8 @@ BOOST_SPIRIT_DEFINE(unescaped_command)
 BOOST_SPIRIT_DEFINE(nparagraph_command)
 BOOST_SPIRIT_DEFINE(environment)
 BOOST_SPIRIT_DEFINE(verbatim_environment)
+BOOST_SPIRIT_DEFINE(command_name)
+BOOST_SPIRIT_DEFINE(environment_name)
 
 }  // namespace grammar
 }  // namespace lightex
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace lightex {
+namespace grammar {
+
+// Bump whenever the grammar or the AST changes in a way that makes previously parsed ASTs stale, e.g. ones stored in
+// the AST cache.
+const int kGrammarVersion = 3;
+
+}  // namespace grammar
+}  // namespace lightex
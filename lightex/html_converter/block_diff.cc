@@ -0,0 +1,205 @@
+#include <lightex/html_converter/block_diff.h>
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include <lightex/utils/json_utils.h>
+
+namespace lightex {
+namespace html_converter {
+namespace {
+
+std::string BindBlockId(const std::string& html, std::uint64_t id) {
+  const std::string id_text = std::to_string(id);
+  std::string output;
+  std::size_t position = 0;
+  for (std::size_t placeholder = html.find(kBlockIdPlaceholder); placeholder != std::string::npos;
+       placeholder = html.find(kBlockIdPlaceholder, position)) {
+    output.append(html, position, placeholder - position);
+    output += id_text;
+    position = placeholder + sizeof(kBlockIdPlaceholder) - 1;
+  }
+  output.append(html, position, std::string::npos);
+  return output;
+}
+
+// Pairs of old and new block indices, increasing in both.
+using BlockMatches = std::vector<std::pair<std::size_t, std::size_t>>;
+
+struct OutputHash {
+  std::size_t operator()(const std::string* output) const { return std::hash<std::string>()(*output); }
+};
+
+struct OutputEqual {
+  bool operator()(const std::string* a, const std::string* b) const { return *a == *b; }
+};
+
+struct OutputOccurrences {
+  std::size_t old_num = 0;
+  std::size_t new_num = 0;
+  std::size_t old_index = 0;
+};
+
+// Matches of the blocks whose outputs occur once in both renders, the longest sequence of them in the same order.
+BlockMatches FindUniqueMatches(const std::vector<RenderedBlock>& old_blocks, const std::vector<std::string>& htmls) {
+  std::unordered_map<const std::string*, OutputOccurrences, OutputHash, OutputEqual> occurrences;
+  for (std::size_t i = 0; i < old_blocks.size(); ++i) {
+    OutputOccurrences& output_occurrences = occurrences[&old_blocks[i].html];
+    ++output_occurrences.old_num;
+    output_occurrences.old_index = i;
+  }
+  for (const std::string& html : htmls) {
+    const auto occurrences_it = occurrences.find(&html);
+    if (occurrences_it != occurrences.end()) {
+      ++occurrences_it->second.new_num;
+    }
+  }
+
+  BlockMatches candidates;
+  for (std::size_t j = 0; j < htmls.size(); ++j) {
+    const auto occurrences_it = occurrences.find(&htmls[j]);
+    if (occurrences_it != occurrences.end() && occurrences_it->second.old_num == 1 &&
+        occurrences_it->second.new_num == 1) {
+      candidates.emplace_back(occurrences_it->second.old_index, j);
+    }
+  }
+
+  // Longest increasing sequence of the old indices: |tails[k]| is the candidate ending the best sequence of length
+  // k + 1 found so far.
+  const std::size_t no_candidate = candidates.size();
+  std::vector<std::size_t> tails;
+  std::vector<std::size_t> predecessors(candidates.size(), no_candidate);
+  for (std::size_t c = 0; c < candidates.size(); ++c) {
+    const auto tail_it = std::lower_bound(tails.begin(), tails.end(), candidates[c].first,
+                                          [&candidates](std::size_t tail, std::size_t old_index) {
+                                            return candidates[tail].first < old_index;
+                                          });
+    if (tail_it != tails.begin()) {
+      predecessors[c] = *(tail_it - 1);
+    }
+    if (tail_it == tails.end()) {
+      tails.push_back(c);
+    } else {
+      *tail_it = c;
+    }
+  }
+
+  BlockMatches matches;
+  for (std::size_t c = tails.empty() ? no_candidate : tails.back(); c != no_candidate; c = predecessors[c]) {
+    matches.push_back(candidates[c]);
+  }
+  std::reverse(matches.begin(), matches.end());
+  return matches;
+}
+
+// Extends every match of |unique_matches| to the equal blocks following and preceding it, and matches the equal
+// blocks at the beginning and at the end of the renders as well.
+BlockMatches ExtendMatches(const std::vector<RenderedBlock>& old_blocks,
+                           const std::vector<std::string>& htmls,
+                           const BlockMatches& unique_matches) {
+  BlockMatches matches;
+  std::size_t old_index = 0;
+  std::size_t new_index = 0;
+  for (std::size_t m = 0; m <= unique_matches.size(); ++m) {
+    const bool is_end = m == unique_matches.size();
+    const std::size_t old_last = is_end ? old_blocks.size() : unique_matches[m].first;
+    const std::size_t new_last = is_end ? htmls.size() : unique_matches[m].second;
+
+    while (old_index < old_last && new_index < new_last && old_blocks[old_index].html == htmls[new_index]) {
+      matches.emplace_back(old_index++, new_index++);
+    }
+
+    std::size_t old_first = old_last;
+    std::size_t new_first = new_last;
+    while (old_first > old_index && new_first > new_index && old_blocks[old_first - 1].html == htmls[new_first - 1]) {
+      --old_first;
+      --new_first;
+    }
+    for (; old_first < old_last; ++old_first, ++new_first) {
+      matches.emplace_back(old_first, new_first);
+    }
+
+    if (!is_end) {
+      matches.push_back(unique_matches[m]);
+    }
+    old_index = old_last + 1;
+    new_index = new_last + 1;
+  }
+  return matches;
+}
+}  // namespace
+
+void DiffBlocks(std::vector<std::string> htmls,
+                DocumentBlocks* document,
+                std::vector<BlockPatchOperation>* operations) {
+  if (!document || !operations) {
+    return;
+  }
+
+  htmls.erase(std::remove_if(htmls.begin(), htmls.end(), [](const std::string& html) { return html.empty(); }),
+              htmls.end());
+  std::vector<RenderedBlock>& old_blocks = document->blocks;
+  BlockMatches matches = ExtendMatches(old_blocks, htmls, FindUniqueMatches(old_blocks, htmls));
+  matches.emplace_back(old_blocks.size(), htmls.size());
+
+  std::vector<RenderedBlock> new_blocks;
+  new_blocks.reserve(htmls.size());
+  std::vector<BlockPatchOperation> removals;
+  std::vector<BlockPatchOperation> updates;
+  std::size_t old_index = 0;
+  std::size_t new_index = 0;
+  for (const auto& match : matches) {
+    for (; old_index < match.first && new_index < match.second; ++old_index, ++new_index) {
+      new_blocks.push_back({old_blocks[old_index].id, std::move(htmls[new_index])});
+      updates.push_back({BlockPatchOperation::Type::kReplace, new_blocks.back().id, 0,
+                         BindBlockId(new_blocks.back().html, new_blocks.back().id)});
+    }
+    for (; old_index < match.first; ++old_index) {
+      removals.push_back({BlockPatchOperation::Type::kRemove, old_blocks[old_index].id, 0, std::string()});
+    }
+    for (; new_index < match.second; ++new_index) {
+      const std::uint64_t previous_id = new_blocks.empty() ? 0 : new_blocks.back().id;
+      new_blocks.push_back({document->next_block_id++, std::move(htmls[new_index])});
+      updates.push_back({BlockPatchOperation::Type::kInsert, new_blocks.back().id, previous_id,
+                         BindBlockId(new_blocks.back().html, new_blocks.back().id)});
+    }
+
+    if (match.first < old_blocks.size()) {
+      new_blocks.push_back(std::move(old_blocks[old_index++]));
+      ++new_index;
+    }
+  }
+
+  document->blocks = std::move(new_blocks);
+  *operations = std::move(removals);
+  operations->insert(operations->end(), std::make_move_iterator(updates.begin()),
+                     std::make_move_iterator(updates.end()));
+}
+
+void WriteBlockPatch(const std::vector<BlockPatchOperation>& operations, std::ostream* output) {
+  for (const BlockPatchOperation& operation : operations) {
+    switch (operation.type) {
+      case BlockPatchOperation::Type::kRemove:
+        *output << "{\"op\":\"remove\",\"id\":" << operation.id << "}\n";
+        break;
+
+      case BlockPatchOperation::Type::kReplace:
+        *output << "{\"op\":\"replace\",\"id\":" << operation.id << ",\"html\":";
+        utils::WriteJsonString(operation.html, output);
+        *output << "}\n";
+        break;
+
+      case BlockPatchOperation::Type::kInsert:
+        *output << "{\"op\":\"insert\",\"id\":" << operation.id << ",\"after\":" << operation.previous_id
+                << ",\"html\":";
+        utils::WriteJsonString(operation.html, output);
+        *output << "}\n";
+        break;
+    }
+  }
+}
+
+}  // namespace html_converter
+}  // namespace lightex
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace lightex {
+namespace html_converter {
+
+// Stands for the id of the block in the outputs of HtmlVisitor::RenderTopLevelNodes. It isn't valid UTF-8, so it
+// never comes from the input.
+constexpr char kBlockIdPlaceholder[] = "\xff";
+
+// Rendered top-level block of a document (see HtmlVisitor::RenderTopLevelNodes), |html| with kBlockIdPlaceholder. Ids
+// are unique within the document and a block keeps its id for as long as it isn't removed, even if its output changes.
+struct RenderedBlock {
+  std::uint64_t id;
+  std::string html;
+};
+
+// Last render of a document, the blocks with empty outputs (e.g. macro definitions) left out.
+struct DocumentBlocks {
+  std::vector<RenderedBlock> blocks;
+  std::uint64_t next_block_id = 1;
+};
+
+struct BlockPatchOperation {
+  enum class Type {
+    kRemove,
+    kReplace,
+    // Inserts the block right after the block |previous_id|, or at the beginning of the document if it's 0.
+    kInsert,
+  };
+
+  Type type;
+  std::uint64_t id;
+  std::uint64_t previous_id;
+  std::string html;
+};
+
+// Replaces the blocks of |document| with |htmls| and makes the operations turning the old blocks into the new ones:
+// removals first, then replacements and insertions in document order, so every insertion follows a block which is
+// already in place. Blocks whose output didn't change keep their ids and aren't mentioned: blocks with outputs that
+// occur once in both renders are matched first, as the longest sequence in the same order (as patience diff does),
+// and every match is extended to the equal blocks around it. Unmatched blocks between two matched ones become
+// replacements as long as there are blocks on both sides, and removals or insertions for the rest, so editing a block
+// replaces it in place. Outputs of the operations have kBlockIdPlaceholder replaced with the id of their block.
+void DiffBlocks(std::vector<std::string> htmls,
+                DocumentBlocks* document,
+                std::vector<BlockPatchOperation>* operations);
+
+// Writes one JSON object per line and per operation:
+//   {"op":"remove","id":3}
+//   {"op":"replace","id":4,"html":"<p>b</p>"}
+//   {"op":"insert","id":9,"after":4,"html":"<p>c</p>"}
+// Clients are expected to keep every block in a container element of its own, keyed by the id, and to apply the
+// operations in order.
+void WriteBlockPatch(const std::vector<BlockPatchOperation>& operations, std::ostream* output);
+
+}  // namespace html_converter
+}  // namespace lightex
@@ -1,78 +1,28 @@
 #include <lightex/html_converter/html_visitor.h>
 
-#include <cctype>
+#include <algorithm>
 #include <list>
 #include <iomanip>
 #include <iostream>
-#include <map>
 #include <sstream>
 
+#include <lightex/html_converter/block_diff.h>
+#include <lightex/symbols/symbol_tables.h>
+#include <lightex/utils/text_utils.h>
+
+#include <boost/variant/static_visitor.hpp>
+
 namespace lightex {
 namespace html_converter {
 namespace {
 
-const std::map<std::string, std::string> kLookupTableSymbols = {
-    {"\\,", "&thinsp;"}, {"~", "&nbsp;"}, {"---", "&mdash;"}, {"--", "&ndash;"}, {"<<", "&laquo;"}, {">>", "&raquo;"}};
-
-std::string FormatText(const std::string& unformatted) {
-  std::ostringstream buffer;
-
-  bool previous_is_space = false;
-  for (char c : unformatted) {
-    if (std::isspace(c)) {
-      if (!previous_is_space) {
-        buffer << ' ';
-      }
-      previous_is_space = true;
-      continue;
-    }
-
-    buffer << c;
-    previous_is_space = false;
-  }
-
-  return buffer.str();
-}
-
-std::string EscapeStringForHtml(const std::string& unescaped) {
-  std::ostringstream buffer;
-
-  for (char c : unescaped) {
-    switch (c) {
-      case '&':
-        buffer << "&amp;";
-        break;
-
-      case '\"':
-        buffer << "&quot;";
-        break;
-
-      case '\'':
-        buffer << "&apos;";
-        break;
-
-      case '<':
-        buffer << "&lt;";
-        break;
-
-      case '>':
-        buffer << "&gt;";
-        break;
-
-      default:
-        buffer << c;
-    }
-  }
-
-  return buffer.str();
-}
-
 std::string EscapeStringForJs(const std::string& unescaped) {
   std::ostringstream buffer;
 
   for (char c : unescaped) {
-    if (c == '"' || c == '\\' || ('\x00' <= c && c <= '\x1f')) {
-      buffer << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int{c};
+    // Bytes of multibyte UTF-8 sequences are negative as char, so control characters are checked as unsigned.
+    if (c == '"' || c == '\\' || static_cast<unsigned char>(c) <= 0x1f) {
+      buffer << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
     } else {
       buffer << c;
     }
@@ -98,8 +48,11 @@ std::string EscapeDollarSigns(const std::string& unescaped) {
   return buffer.str();
 }
 
-std::string RenderMathFormula(const std::string& math_text, bool is_inlined, int* math_text_span_num) {
-  std::string span_id = "mathTextSpan" + std::to_string(++(*math_text_span_num));
+std::string RenderMathFormula(const std::string& math_text,
+                              bool is_inlined,
+                              const std::string& span_id_prefix,
+                              int* math_text_span_num) {
+  std::string span_id = span_id_prefix + std::to_string(++(*math_text_span_num));
   std::string display_mode = is_inlined ? "false" : "true";
 
   std::ostringstream buffer;
@@ -114,259 +67,720 @@ std::string RenderMathFormula(const std::string& math_text, bool is_inlined, int
   return buffer.str();
 }
 
+utils::ArenaString ToArenaString(const std::string& text) {
+  return utils::ArenaString(text.data(), text.size());
+}
+
+// |prefix| and |suffix| must be static, e.g. string literals.
+utils::Rope WrapText(const char* prefix, const utils::Rope& text, const char* suffix) {
+  utils::RopeBuilder builder;
+  builder.Append(utils::Rope::Reference(prefix));
+  builder.Append(text);
+  builder.Append(utils::Rope::Reference(suffix));
+  return builder.Build();
+}
+
 template <typename MacroDefinition>
-const MacroDefinition* GetMacroDefinition(const std::list<MacroDefinition>& macro_definitions,
-                                          const std::string& name) {
-  for (auto it = macro_definitions.rbegin(); it != macro_definitions.rend(); ++it) {
-    if (it->name == name) {
-      return &(*it);
+std::size_t FindMacroDefinition(const std::vector<std::shared_ptr<const MacroDefinition>>& macro_definitions,
+                                std::size_t visible_macro_definitions_num,
+                                ast::SymbolId name) {
+  for (std::size_t i = std::min(visible_macro_definitions_num, macro_definitions.size()); i > 0; --i) {
+    if (macro_definitions[i - 1]->name == name) {
+      return i - 1;
     }
   }
 
-  return nullptr;
+  return macro_definitions.size();
 }
+
+// Bounds the depth of the macro calls followed while checking a macro for constant output, recursive macros aren't
+// folded.
+constexpr int kMaxFoldedCallDepth = 16;
 }  // namespace
 
+// Checks that nodes render the same way wherever they are expanded, collecting the command macros they call. Argument
+// references are allowed only where they refer to arguments given by the checked nodes themselves.
+class HtmlVisitor::ConstantChecker : public boost::static_visitor<bool> {
+ public:
+  using Dependencies = std::vector<std::pair<ast::SymbolId, std::size_t>>;
+
+  ConstantChecker(const HtmlVisitor* visitor, int call_depth, Dependencies* dependencies)
+      : visitor_(visitor), call_depth_(call_depth), dependencies_(dependencies) {}
+
+  bool operator()(const ast::Program& program) const { return AreConstant(program.nodes); }
+  bool operator()(const ast::PlainText& plain_text) const { return true; }
+  bool operator()(const ast::HtmlEntity& html_entity) const { return true; }
+  bool operator()(const ast::Paragraph& paragraph) const { return AreConstant(paragraph.nodes); }
+  bool operator()(const ast::ParagraphBreaker& paragraph_breaker) const { return true; }
+  bool operator()(const ast::Argument& argument) const { return AreConstant(argument.nodes); }
+  bool operator()(const ast::ArgumentRef& argument_ref) const { return call_depth_ > 0; }
+  bool operator()(const ast::OuterArgumentRef& outer_argument_ref) const { return call_depth_ > 1; }
+  // Math formulas are numbered in the order of rendering.
+  bool operator()(const ast::InlinedMathText& inlined_math_text) const { return false; }
+  bool operator()(const ast::MathText& math_text) const { return false; }
+  bool operator()(const ast::CommandMacro& command_macro) const { return false; }
+  bool operator()(const ast::EnvironmentMacro& environment_macro) const { return false; }
+  bool operator()(const ast::UnescapedCommand& unescaped_command) const { return (*this)(unescaped_command.body); }
+  bool operator()(const ast::NparagraphCommand& nparagraph_command) const {
+    return (*this)(nparagraph_command.body);
+  }
+  bool operator()(const ast::Environment& environment) const { return false; }
+  bool operator()(const ast::VerbatimEnvironment& verbatim_environment) const { return true; }
+
+  bool operator()(const ast::Command& command) const {
+    if (call_depth_ >= kMaxFoldedCallDepth) {
+      return false;
+    }
+
+    const std::size_t command_macro_index = visitor_->FindDefinedCommandMacro(command.name);
+    if (command_macro_index == visitor_->defined_command_macros_.size()) {
+      return false;
+    }
+    const ast::CommandMacro& command_macro = *visitor_->defined_command_macros_[command_macro_index];
+    dependencies_->emplace_back(command.name, command_macro_index);
+
+    // Arguments are evaluated at the call site, the body within the frame of the call.
+    return AreConstant(command.default_arguments) && AreConstant(command.arguments) &&
+           AreConstant(command_macro.default_arguments) &&
+           ConstantChecker(visitor_, call_depth_ + 1, dependencies_)(command_macro.body);
+  }
+
+ private:
+  bool AreConstant(const std::list<ast::Argument>& arguments) const {
+    return std::all_of(arguments.begin(), arguments.end(),
+                       [this](const ast::Argument& argument) { return (*this)(argument); });
+  }
+
+  template <typename Node>
+  bool AreConstant(const std::list<Node>& nodes) const {
+    return std::all_of(nodes.begin(), nodes.end(),
+                       [this](const Node& node) { return boost::apply_visitor(*this, node); });
+  }
+
+  const HtmlVisitor* visitor_;  // Not owned.
+  const int call_depth_;
+  Dependencies* dependencies_;  // Not owned.
+};
+
+// Starts visits of the nodes held by variants.
+class HtmlVisitor::NodeStarter : public boost::static_visitor<void> {
+ public:
+  explicit NodeStarter(HtmlVisitor* visitor) : visitor_(visitor) {}
+
+  template <typename Node>
+  void operator()(const Node& node) const {
+    visitor_->Visit(node);
+  }
+
+ private:
+  HtmlVisitor* visitor_;  // Not owned.
+};
+
 Result Result::Failure(const std::string& error_message) {
-  return {false, "", "", error_message, false};
+  return {false, {}, {}, error_message, false};
 }
 
-Result Result::Success(const std::string& escaped, const std::string& unescaped, bool breaks_paragraph) {
-  return {true, escaped, unescaped, "", breaks_paragraph};
+Result Result::Success(utils::Rope escaped, utils::Rope unescaped, bool breaks_paragraph) {
+  return {true, std::move(escaped), std::move(unescaped), "", breaks_paragraph};
 }
 
+HtmlVisitor::HtmlVisitor(const ast::SymbolTable* symbol_table) : symbol_table_(symbol_table) {}
+
 Result HtmlVisitor::operator()(const ast::Program& program) {
-  return JoinNodeResults(program.nodes);
+  return Evaluate(MakeVisitTask(program));
 }
 
-Result HtmlVisitor::operator()(const ast::PlainText& plain_text) {
-  const auto it = kLookupTableSymbols.find(plain_text.text);
-  if (it != kLookupTableSymbols.end()) {
-    return Result::Success(it->second, it->second);
+bool HtmlVisitor::RenderTopLevelNodes(const ast::Program& program,
+                                      std::vector<std::string>* node_outputs,
+                                      std::string* error_message) {
+  if (!node_outputs) {
+    return false;
+  }
+
+  const std::string cached_math_text_span_id_prefix = math_text_span_id_prefix_;
+  const int cached_math_text_span_num = math_text_span_num_;
+  math_text_span_id_prefix_ += std::string(kBlockIdPlaceholder) + "-";
+
+  bool is_successful = true;
+  node_outputs->clear();
+  node_outputs->reserve(program.nodes.size());
+  for (const ast::ProgramNode& node : program.nodes) {
+    math_text_span_num_ = 0;
+    const Result result = Evaluate(MakeVisitTask(node));
+    if (!result.is_successful) {
+      if (error_message) {
+        *error_message = result.error_message;
+      }
+      is_successful = false;
+      break;
+    }
+    node_outputs->emplace_back();
+    result.escaped.AppendTo(&node_outputs->back());
   }
 
-  return Result::Success(EscapeStringForHtml(FormatText(plain_text.text)), plain_text.text);
+  math_text_span_id_prefix_ = cached_math_text_span_id_prefix;
+  math_text_span_num_ = cached_math_text_span_num;
+  return is_successful;
 }
 
-Result HtmlVisitor::operator()(const ast::Paragraph& paragraph) {
-  Result result = JoinNodeResults(paragraph.nodes);
-  if (!result.is_successful) {
-    return result;
-  }
+void HtmlVisitor::SetSymbolTable(const ast::SymbolTable* symbol_table) {
+  symbol_table_ = symbol_table;
+}
 
-  std::string formatted_result = FormatText(result.escaped);
-  if (formatted_result.empty() || formatted_result == " ") {
-    return result;
-  }
+void HtmlVisitor::SetMaxExpansionDepth(int max_expansion_depth) {
+  max_expansion_depth_ = std::max(max_expansion_depth, 0);
+}
+
+HtmlVisitor::Task HtmlVisitor::MakeVisitTask(const ast::Program& program) {
+  return {Task::Type::kVisitProgram, &program};
+}
+
+HtmlVisitor::Task HtmlVisitor::MakeVisitTask(const ast::Argument& argument) {
+  return {Task::Type::kVisitArgument, &argument};
+}
+
+HtmlVisitor::Task HtmlVisitor::MakeVisitTask(const ast::ProgramNode& program_node) {
+  return {Task::Type::kVisitProgramNode, &program_node};
+}
+
+HtmlVisitor::Task HtmlVisitor::MakeVisitTask(const ast::ParagraphNode& paragraph_node) {
+  return {Task::Type::kVisitParagraphNode, &paragraph_node};
+}
+
+HtmlVisitor::Task HtmlVisitor::MakeVisitTask(const ast::ArgumentNode& argument_node) {
+  return {Task::Type::kVisitArgumentNode, &argument_node};
+}
 
-  if (active_environment_definitions_num_ == 0 && !result.breaks_paragraph) {
-    result.escaped = "<p>" + result.escaped + "</p>";
-    result.unescaped = "<p>" + result.unescaped + "</p>";
+Result HtmlVisitor::Evaluate(const Task& root_task) {
+  const std::size_t tasks_base = tasks_.size();
+  const std::size_t results_base = results_.size();
+
+  tasks_.push_back(root_task);
+  while (tasks_.size() > tasks_base) {
+    const Task task = tasks_.back();
+    tasks_.pop_back();
+    RunTask(task);
+
+    if (results_.size() > results_base && !results_.back().is_successful) {
+      const Result failure = std::move(results_.back());
+      while (tasks_.size() > tasks_base) {
+        const Task aborted_task = tasks_.back();
+        tasks_.pop_back();
+        AbortTask(aborted_task, failure);
+      }
+
+      results_.erase(results_.begin() + results_base, results_.end());
+      return failure;
+    }
   }
 
+  Result result = std::move(results_.back());
+  results_.pop_back();
   return result;
 }
 
-Result HtmlVisitor::operator()(const ast::ParagraphBreaker& paragraph_breaker) {
-  return Result::Success("", "");
+void HtmlVisitor::RunTask(const Task& task) {
+  switch (task.type) {
+    case Task::Type::kVisitProgram:
+      Visit(*static_cast<const ast::Program*>(task.node));
+      break;
+
+    case Task::Type::kVisitArgument:
+      Visit(*static_cast<const ast::Argument*>(task.node));
+      break;
+
+    case Task::Type::kVisitProgramNode:
+      boost::apply_visitor(NodeStarter(this), *static_cast<const ast::ProgramNode*>(task.node));
+      break;
+
+    case Task::Type::kVisitParagraphNode:
+      boost::apply_visitor(NodeStarter(this), *static_cast<const ast::ParagraphNode*>(task.node));
+      break;
+
+    case Task::Type::kVisitArgumentNode:
+      boost::apply_visitor(NodeStarter(this), *static_cast<const ast::ArgumentNode*>(task.node));
+      break;
+
+    case Task::Type::kJoinResults:
+      JoinResults(task.index);
+      break;
+
+    case Task::Type::kFinishParagraph:
+      FinishParagraph(&results_.back());
+      break;
+
+    case Task::Type::kFinishUnescapedCommand:
+      results_.back().escaped = results_.back().unescaped;
+      break;
+
+    case Task::Type::kFinishNparagraphCommand:
+      results_.back().breaks_paragraph = true;
+      break;
+
+    case Task::Type::kFinishArgument:
+      FinishArgument(task);
+      break;
+
+    case Task::Type::kFinishCommand:
+      FinishCommand(task, results_.back());
+      break;
+
+    case Task::Type::kContinueEnvironment:
+      ContinueEnvironment(task);
+      break;
+
+    case Task::Type::kFinishEnvironment:
+      FinishEnvironment(task, results_.back());
+      break;
+  }
+}
+
+void HtmlVisitor::AbortTask(const Task& task, const Result& failure) {
+  switch (task.type) {
+    case Task::Type::kFinishArgument:
+      active_frame_index_ = task.cached_active_frame_index;
+      command_macros_visibility_limit_ = task.cached_command_macros_visibility_limit;
+      environment_macros_visibility_limit_ = task.cached_environment_macros_visibility_limit;
+      break;
+
+    case Task::Type::kFinishCommand:
+      FinishCommand(task, failure);
+      break;
+
+    case Task::Type::kContinueEnvironment:
+      if (environment_expansions_.back().stage != EnvironmentExpansion::Stage::kProgram) {
+        LeaveEnvironmentMacroProgram(environment_expansions_.back());
+      }
+      break;
+
+    case Task::Type::kFinishEnvironment:
+      FinishEnvironment(task, failure);
+      break;
+
+    default:
+      break;
+  }
 }
 
-Result HtmlVisitor::operator()(const ast::Argument& argument) {
-  return JoinNodeResults(argument.nodes);
+void HtmlVisitor::Visit(const ast::Program& program) {
+  VisitNodes(program.nodes);
 }
 
-Result HtmlVisitor::operator()(const ast::ArgumentRef& argument_ref) {
-  const Result* argument = GetArgumentByReference(argument_ref.argument_id - 1, false);
-  if (!argument) {
-    return Result::Failure("Invalid argument reference.");
+void HtmlVisitor::Visit(const ast::PlainText& plain_text) {
+  if (const char* replacement = symbols::FindLookupTableSymbol(plain_text.text.data(), plain_text.text.size())) {
+    const utils::Rope symbol = utils::Rope::Reference(replacement);
+    results_.push_back(Result::Success(symbol, symbol));
+    return;
   }
+  const utils::Rope text = utils::Rope::Reference(plain_text.text.data(), plain_text.text.size());
+
+  // The buffer is reused by all plain texts of the thread, only the copy of the result is allocated, and only if the
+  // formatting has changed the text.
+  static thread_local std::string escaped;
+  escaped.clear();
+  utils::AppendFormattedHtml(plain_text.text, &escaped);
+  results_.push_back(Result::Success(escaped == plain_text.text ? text : utils::Rope(ToArenaString(escaped)), text));
+}
+
+void HtmlVisitor::Visit(const ast::HtmlEntity& html_entity) {
+  const utils::Rope text = utils::Rope::Reference(html_entity.text.data(), html_entity.text.size());
+  results_.push_back(Result::Success(text, text));
+}
 
-  return *argument;
+void HtmlVisitor::Visit(const ast::Paragraph& paragraph) {
+  tasks_.push_back({Task::Type::kFinishParagraph, &paragraph});
+  VisitNodes(paragraph.nodes);
 }
 
-Result HtmlVisitor::operator()(const ast::OuterArgumentRef& outer_argument_ref) {
-  const Result* argument = GetArgumentByReference(outer_argument_ref.argument_id - 1, true);
-  if (!argument) {
-    return Result::Failure("Invalid outer argument reference.");
+void HtmlVisitor::FinishParagraph(Result* result) {
+  if (result->escaped.IsBlank()) {
+    return;
   }
 
-  return *argument;
+  if (active_environment_definitions_num_ == 0 && !result->breaks_paragraph) {
+    result->escaped = WrapText("<p>", result->escaped, "</p>");
+    result->unescaped = WrapText("<p>", result->unescaped, "</p>");
+  }
+}
+
+void HtmlVisitor::Visit(const ast::ParagraphBreaker& paragraph_breaker) {
+  results_.push_back(Result::Success({}, {}));
+}
+
+void HtmlVisitor::Visit(const ast::Argument& argument) {
+  VisitNodes(argument.nodes);
+}
+
+void HtmlVisitor::Visit(const ast::ArgumentRef& argument_ref) {
+  VisitArgument(argument_ref.argument_id - 1, false, "Invalid argument reference.");
 }
 
-Result HtmlVisitor::operator()(const ast::InlinedMathText& math_text) {
-  std::string render_result = RenderMathFormula(math_text.text, true, &math_text_span_num_);
-  return Result::Success(render_result, render_result);
+void HtmlVisitor::Visit(const ast::OuterArgumentRef& outer_argument_ref) {
+  VisitArgument(outer_argument_ref.argument_id - 1, true, "Invalid outer argument reference.");
 }
 
-Result HtmlVisitor::operator()(const ast::MathText& math_text) {
-  std::string render_result = RenderMathFormula(math_text.text, false, &math_text_span_num_);
-  return Result::Success(render_result, render_result);
+void HtmlVisitor::Visit(const ast::InlinedMathText& math_text) {
+  const utils::Rope render_result(
+      ToArenaString(RenderMathFormula(math_text.text, true, math_text_span_id_prefix_, &math_text_span_num_)));
+  results_.push_back(Result::Success(render_result, render_result));
 }
 
-Result HtmlVisitor::operator()(const ast::CommandMacro& command_macro) {
-  if (command_macro.arguments_num.get_value_or(0) < command_macro.default_arguments.size()) {
-    return Result::Failure("Invalid number of arguments for command macro " + command_macro.name + ".");
+void HtmlVisitor::Visit(const ast::MathText& math_text) {
+  const utils::Rope render_result(
+      ToArenaString(RenderMathFormula(math_text.text, false, math_text_span_id_prefix_, &math_text_span_num_)));
+  results_.push_back(Result::Success(render_result, render_result));
+}
+
+void HtmlVisitor::Visit(const ast::CommandMacro& command_macro) {
+  const std::size_t arguments_num = command_macro.arguments_num.get_value_or(0);
+  if (arguments_num < command_macro.default_arguments.size()) {
+    results_.push_back(
+        Result::Failure("Invalid number of arguments for command macro " + GetName(command_macro.name) + "."));
+    return;
   }
 
-  defined_command_macros_.push_back(command_macro);
-  return Result::Success("", "");
+  defined_command_macros_.push_back(BindDefinition(command_macro));
+  results_.push_back(Result::Success({}, {}));
 }
 
-Result HtmlVisitor::operator()(const ast::EnvironmentMacro& environment_macro) {
-  if (environment_macro.arguments_num.get_value_or(0) < environment_macro.default_arguments.size()) {
-    return Result::Failure("Invalid number of arguments for environment macro " + environment_macro.name + ".");
+void HtmlVisitor::Visit(const ast::EnvironmentMacro& environment_macro) {
+  const std::size_t arguments_num = environment_macro.arguments_num.get_value_or(0);
+  if (arguments_num < environment_macro.default_arguments.size()) {
+    results_.push_back(Result::Failure("Invalid number of arguments for environment macro " +
+                                       GetName(environment_macro.name) + "."));
+    return;
   }
 
-  defined_environment_macros_.push_back(environment_macro);
-  return Result::Success("", "");
+  defined_environment_macros_.push_back(BindDefinition(environment_macro));
+  results_.push_back(Result::Success({}, {}));
 }
 
-Result HtmlVisitor::operator()(const ast::Command& command) {
-  const ast::CommandMacro* command_macro_ptr = GetDefinedCommandMacro(command.name);
-  if (!command_macro_ptr) {
-    return Result::Failure("Command macro " + command.name + " is not defined yet.");
+void HtmlVisitor::Visit(const ast::Command& command) {
+  if (profiler_) {
+    BeginProfiledExpansion();
   }
+  tasks_.push_back({Task::Type::kFinishCommand, &command});
 
-  std::vector<Result> args;
-  Result intermediate_result = PrepareMacroArguments(command, *command_macro_ptr, &args);
-  if (!intermediate_result.is_successful) {
-    return intermediate_result;
+  const std::size_t command_macro_index = FindDefinedCommandMacro(command.name);
+  if (command_macro_index == defined_command_macros_.size()) {
+    results_.push_back(Result::Failure("Command macro " + GetName(command.name) + " is not defined yet."));
+    return;
   }
+  const ast::CommandMacro& command_macro = *defined_command_macros_[command_macro_index];
 
-  arguments_stack_.push_back(std::move(args));
-  intermediate_result = (*this)(command_macro_ptr->body);
-  arguments_stack_.pop_back();
+  ArgumentsFrame frame;
+  Result intermediate_result = PrepareMacroArguments(command, command_macro, &frame);
+  if (!intermediate_result.is_successful) {
+    results_.push_back(std::move(intermediate_result));
+    return;
+  }
+  if (IsExpansionDepthExceeded()) {
+    results_.push_back(Result::Failure("Command macro " + GetName(command.name) + " is nested deeper than " +
+                                       std::to_string(max_expansion_depth_) + " expansions."));
+    return;
+  }
 
-  return intermediate_result;
+  tasks_.back().is_expanded = true;
+  PushArgumentsFrame(std::move(frame));
+  VisitMacroProgram(command_macro.body, folded_command_macros_, command_macro_index);
 }
 
-Result HtmlVisitor::operator()(const ast::UnescapedCommand& unescaped_command) {
-  Result result = (*this)(unescaped_command.body);
+void HtmlVisitor::FinishCommand(const Task& task, const Result& result) {
+  if (task.is_expanded) {
+    PopArgumentsFrame();
+  }
 
-  if (result.is_successful) {
-    result.escaped = result.unescaped;
+  if (profiler_) {
+    EndProfiledExpansion("\\" + GetName(static_cast<const ast::Command*>(task.node)->name), result);
   }
+}
 
-  return result;
+void HtmlVisitor::Visit(const ast::UnescapedCommand& unescaped_command) {
+  tasks_.push_back({Task::Type::kFinishUnescapedCommand, &unescaped_command});
+  tasks_.push_back(MakeVisitTask(unescaped_command.body));
 }
 
-Result HtmlVisitor::operator()(const ast::NparagraphCommand& nparagraph_command) {
-  Result result = (*this)(nparagraph_command.body);
+void HtmlVisitor::Visit(const ast::NparagraphCommand& nparagraph_command) {
+  tasks_.push_back({Task::Type::kFinishNparagraphCommand, &nparagraph_command});
+  tasks_.push_back(MakeVisitTask(nparagraph_command.body));
+}
 
-  if (result.is_successful) {
-    result.breaks_paragraph = true;
+void HtmlVisitor::Visit(const ast::Environment& environment) {
+  if (profiler_) {
+    BeginProfiledExpansion();
   }
+  tasks_.push_back({Task::Type::kFinishEnvironment, &environment});
 
-  return result;
-}
-
-Result HtmlVisitor::operator()(const ast::Environment& environment) {
   if (environment.name != environment.end_name) {
-    return Result::Failure("Environment name doesn't match the end name: " + environment.name + " != " +
-                           environment.end_name);
+    results_.push_back(Result::Failure("Environment name doesn't match the end name: " + GetName(environment.name) +
+                                       " != " + GetName(environment.end_name)));
+    return;
   }
 
-  const ast::EnvironmentMacro* environment_macro_ptr = GetDefinedEnvironmentMacro(environment.name);
-  if (!environment_macro_ptr) {
-    return Result::Failure("Environment macro " + environment.name + " is not defined yet.");
+  const std::size_t environment_macro_index = FindDefinedEnvironmentMacro(environment.name);
+  if (environment_macro_index == defined_environment_macros_.size()) {
+    results_.push_back(Result::Failure("Environment macro " + GetName(environment.name) + " is not defined yet."));
+    return;
   }
 
-  std::vector<Result> args;
-  Result intermediate_result = PrepareMacroArguments(environment, *environment_macro_ptr, &args);
+  EnvironmentExpansion expansion;
+  expansion.environment_macro = defined_environment_macros_[environment_macro_index];
+  expansion.environment_macro_index = environment_macro_index;
+
+  ArgumentsFrame frame;
+  Result intermediate_result = PrepareMacroArguments(environment, *expansion.environment_macro, &frame);
   if (!intermediate_result.is_successful) {
-    return intermediate_result;
+    results_.push_back(std::move(intermediate_result));
+    return;
+  }
+  if (IsExpansionDepthExceeded()) {
+    results_.push_back(Result::Failure("Environment macro " + GetName(environment.name) + " is nested deeper than " +
+                                       std::to_string(max_expansion_depth_) + " expansions."));
+    return;
   }
 
-  std::size_t cached_defined_command_macros_num = defined_command_macros_.size();
+  expansion.cached_defined_command_macros_num = defined_command_macros_.size();
+  expansion.caller_definitions_owner = definitions_owner_;
+  environment_expansions_.push_back(std::move(expansion));
+
+  tasks_.back().is_expanded = true;
+  PushArgumentsFrame(std::move(frame));
+
+  const EnvironmentExpansion& current_expansion = environment_expansions_.back();
+  EnterEnvironmentMacroProgram(current_expansion);
+  tasks_.push_back({Task::Type::kContinueEnvironment, &environment});
+  VisitMacroProgram(current_expansion.environment_macro->pre_program, folded_environment_pre_programs_,
+                    current_expansion.environment_macro_index);
+}
+
+void HtmlVisitor::ContinueEnvironment(const Task& task) {
+  EnvironmentExpansion& expansion = environment_expansions_.back();
+  const Result result = std::move(results_.back());
+  results_.pop_back();
+
+  expansion.escaped.Append(result.escaped);
+  expansion.unescaped.Append(result.unescaped);
+
+  switch (expansion.stage) {
+    case EnvironmentExpansion::Stage::kPreProgram:
+      LeaveEnvironmentMacroProgram(expansion);
+      expansion.stage = EnvironmentExpansion::Stage::kProgram;
+      tasks_.push_back(task);
+      tasks_.push_back(MakeVisitTask(static_cast<const ast::Environment*>(task.node)->program));
+      break;
+
+    case EnvironmentExpansion::Stage::kProgram:
+      expansion.breaks_paragraph = result.breaks_paragraph;
+      expansion.stage = EnvironmentExpansion::Stage::kPostProgram;
+      EnterEnvironmentMacroProgram(expansion);
+      tasks_.push_back(task);
+      VisitMacroProgram(expansion.environment_macro->post_program, folded_environment_post_programs_,
+                        expansion.environment_macro_index);
+      break;
+
+    case EnvironmentExpansion::Stage::kPostProgram:
+      LeaveEnvironmentMacroProgram(expansion);
+      results_.push_back(
+          Result::Success(expansion.escaped.Build(), expansion.unescaped.Build(), expansion.breaks_paragraph));
+      break;
+  }
+}
 
-  const auto rollback = [&]() {
+void HtmlVisitor::FinishEnvironment(const Task& task, const Result& result) {
+  if (task.is_expanded) {
+    const std::size_t cached_defined_command_macros_num =
+        environment_expansions_.back().cached_defined_command_macros_num;
     while (cached_defined_command_macros_num < defined_command_macros_.size()) {
       defined_command_macros_.pop_back();
     }
 
-    arguments_stack_.pop_back();
-  };
-
-  arguments_stack_.push_back(std::move(args));
+    PopArgumentsFrame();
+    environment_expansions_.pop_back();
+  }
 
-  std::string escaped;
-  std::string unescaped;
-  bool breaks_paragraph;
+  if (profiler_) {
+    EndProfiledExpansion("\\begin{" + GetName(static_cast<const ast::Environment*>(task.node)->name) + "}", result);
+  }
+}
 
+void HtmlVisitor::EnterEnvironmentMacroProgram(const EnvironmentExpansion& expansion) {
   active_environment_definitions_num_ += 1;
-  intermediate_result = (*this)(environment_macro_ptr->pre_program);
+  definitions_owner_ = expansion.environment_macro;
+}
+
+void HtmlVisitor::LeaveEnvironmentMacroProgram(const EnvironmentExpansion& expansion) {
+  definitions_owner_ = expansion.caller_definitions_owner;
   active_environment_definitions_num_ -= 1;
-  if (intermediate_result.is_successful) {
-    escaped += intermediate_result.escaped;
-    unescaped += intermediate_result.unescaped;
-  } else {
-    rollback();
-    return intermediate_result;
+}
+
+void HtmlVisitor::Visit(const ast::VerbatimEnvironment& verbatim_environment) {
+  const utils::Rope content =
+      utils::Rope::Reference(verbatim_environment.content.data(), verbatim_environment.content.size());
+  const utils::Rope html_text = WrapText("<pre>", content, "</pre>");
+  results_.push_back(Result::Success(html_text, html_text));
+}
+
+template <typename Node>
+void HtmlVisitor::VisitNodes(const std::list<Node>& nodes) {
+  // The result of a single node is already the joined one.
+  if (nodes.size() != 1) {
+    Task join_task{Task::Type::kJoinResults, &nodes};
+    join_task.index = nodes.size();
+    tasks_.push_back(join_task);
   }
 
-  intermediate_result = (*this)(environment.program);
-  if (intermediate_result.is_successful) {
-    escaped += intermediate_result.escaped;
-    unescaped += intermediate_result.unescaped;
-    breaks_paragraph = intermediate_result.breaks_paragraph;
-  } else {
-    rollback();
-    return intermediate_result;
+  // Nodes are visited in order, so the first one is scheduled last.
+  for (auto node_it = nodes.rbegin(); node_it != nodes.rend(); ++node_it) {
+    tasks_.push_back(MakeVisitTask(*node_it));
   }
+}
 
-  active_environment_definitions_num_ += 1;
-  intermediate_result = (*this)(environment_macro_ptr->post_program);
-  active_environment_definitions_num_ -= 1;
-  if (intermediate_result.is_successful) {
-    escaped += intermediate_result.escaped;
-    unescaped += intermediate_result.unescaped;
-  } else {
-    rollback();
-    return intermediate_result;
+void HtmlVisitor::JoinResults(std::size_t results_num) {
+  const auto first_result = results_.end() - results_num;
+
+  utils::RopeBuilder escaped;
+  utils::RopeBuilder unescaped;
+  bool breaks_paragraph = false;
+  for (auto result_it = first_result; result_it != results_.end(); ++result_it) {
+    escaped.Append(result_it->escaped);
+    unescaped.Append(result_it->unescaped);
+    breaks_paragraph |= result_it->breaks_paragraph;
   }
 
-  rollback();
-  return Result::Success(escaped, unescaped, breaks_paragraph);
+  results_.erase(first_result, results_.end());
+  results_.push_back(Result::Success(escaped.Build(), unescaped.Build(), breaks_paragraph));
 }
 
-Result HtmlVisitor::operator()(const ast::VerbatimEnvironment& verbatim_environment) {
-  std::string html_text = "<pre>" + verbatim_environment.content + "</pre>";
+void HtmlVisitor::VisitArgument(int index, bool is_outer, const char* error_message) {
+  int frame_index = active_frame_index_;
+  if (is_outer && frame_index >= 0) {
+    frame_index = arguments_stack_[frame_index].caller_frame_index;
+  }
+  if (index < 0 || frame_index < 0 ||
+      arguments_stack_[frame_index].arguments.size() <= static_cast<std::size_t>(index)) {
+    results_.push_back(Result::Failure(error_message));
+    return;
+  }
+
+  const ArgumentsFrame& frame = arguments_stack_[frame_index];
+  if (frame.results[index]) {
+    results_.push_back(*frame.results[index]);
+    return;
+  }
 
-  return Result::Success(html_text, html_text);
+  // Evaluates the argument as if it was done at the call site: within the caller's frame and with macros defined by
+  // the macro body itself hidden. Math is numbered in the order of evaluation, so a math formula of an argument takes
+  // its number when the argument is first referenced.
+  Task finish_task{Task::Type::kFinishArgument, frame.arguments[index]};
+  finish_task.index = index;
+  finish_task.frame_index = frame_index;
+  finish_task.cached_active_frame_index = active_frame_index_;
+  finish_task.cached_command_macros_visibility_limit = command_macros_visibility_limit_;
+  finish_task.cached_environment_macros_visibility_limit = environment_macros_visibility_limit_;
+  tasks_.push_back(finish_task);
+
+  active_frame_index_ = frame.caller_frame_index;
+  command_macros_visibility_limit_ = frame.visible_command_macros_num;
+  environment_macros_visibility_limit_ = frame.visible_environment_macros_num;
+  tasks_.push_back(MakeVisitTask(*frame.arguments[index]));
 }
 
-template <typename Node>
-Result HtmlVisitor::JoinNodeResults(const std::list<Node>& nodes) {
-  std::ostringstream escaped;
-  std::ostringstream unescaped;
+void HtmlVisitor::FinishArgument(const Task& task) {
+  active_frame_index_ = task.cached_active_frame_index;
+  command_macros_visibility_limit_ = task.cached_command_macros_visibility_limit;
+  environment_macros_visibility_limit_ = task.cached_environment_macros_visibility_limit;
 
-  bool breaks_paragraph = false;
-  for (const auto& node : nodes) {
-    Result child_result = boost::apply_visitor(*this, node);
-    if (!child_result.is_successful) {
-      return child_result;
+  // Frames pushed during the evaluation are already popped, but the stack might have been reallocated.
+  arguments_stack_[task.frame_index].results[task.index] = results_.back();
+}
+
+template <typename Macro>
+std::shared_ptr<const Macro> HtmlVisitor::BindDefinition(const Macro& macro) const {
+  if (definitions_owner_) {
+    return std::shared_ptr<const Macro>(definitions_owner_, &macro);
+  }
+  return std::make_shared<const Macro>(macro);
+}
+
+void HtmlVisitor::FoldConstantMacros() {
+  folded_command_macros_.assign(defined_command_macros_.size(), nullptr);
+  for (std::size_t i = 0; i < defined_command_macros_.size(); ++i) {
+    const ast::CommandMacro& command_macro = *defined_command_macros_[i];
+    // Shadowed definitions are never expanded.
+    if (command_macro.arguments_num.get_value_or(0) == 0 && FindDefinedCommandMacro(command_macro.name) == i) {
+      folded_command_macros_[i] = FoldMacroProgram(command_macro.body);
     }
+  }
 
-    escaped << child_result.escaped;
-    unescaped << child_result.unescaped;
-    breaks_paragraph |= child_result.breaks_paragraph;
+  folded_environment_pre_programs_.assign(defined_environment_macros_.size(), nullptr);
+  folded_environment_post_programs_.assign(defined_environment_macros_.size(), nullptr);
+  active_environment_definitions_num_ += 1;
+  for (std::size_t i = 0; i < defined_environment_macros_.size(); ++i) {
+    const ast::EnvironmentMacro& environment_macro = *defined_environment_macros_[i];
+    if (FindDefinedEnvironmentMacro(environment_macro.name) == i) {
+      folded_environment_pre_programs_[i] = FoldMacroProgram(environment_macro.pre_program);
+      folded_environment_post_programs_[i] = FoldMacroProgram(environment_macro.post_program);
+    }
   }
+  active_environment_definitions_num_ -= 1;
+}
 
-  return Result::Success(escaped.str(), unescaped.str(), breaks_paragraph);
-};
+template <typename Program>
+std::shared_ptr<const HtmlVisitor::FoldedMacro> HtmlVisitor::FoldMacroProgram(const Program& program) {
+  auto folded_macro = std::make_shared<FoldedMacro>();
+  if (!ConstantChecker(this, 0, &folded_macro->dependencies)(program)) {
+    return nullptr;
+  }
+
+  PushArgumentsFrame(ArgumentsFrame());
+  folded_macro->result = Evaluate(MakeVisitTask(program));
+  PopArgumentsFrame();
+
+  if (!folded_macro->result.is_successful) {
+    return nullptr;
+  }
+  return folded_macro;
+}
+
+template <typename Program>
+void HtmlVisitor::VisitMacroProgram(const Program& program,
+                                    const std::vector<std::shared_ptr<const FoldedMacro>>& folded_programs,
+                                    std::size_t definition_index) {
+  // Definitions made after the folding, e.g. by the document, have larger indices.
+  if (definition_index < folded_programs.size() && folded_programs[definition_index] &&
+      IsFoldedMacroValid(*folded_programs[definition_index])) {
+    results_.push_back(folded_programs[definition_index]->result);
+    return;
+  }
+
+  tasks_.push_back(MakeVisitTask(program));
+}
+
+bool HtmlVisitor::IsExpansionDepthExceeded() const {
+  return arguments_stack_.size() >= max_expansion_depth_;
+}
+
+bool HtmlVisitor::IsFoldedMacroValid(const FoldedMacro& folded_macro) const {
+  for (const auto& dependency : folded_macro.dependencies) {
+    if (FindDefinedCommandMacro(dependency.first) != dependency.second) {
+      return false;
+    }
+  }
+  return true;
+}
 
 template <typename Macro, typename MacroDefinition>
 Result HtmlVisitor::PrepareMacroArguments(const Macro& macro,
                                           const MacroDefinition& macro_definition,
-                                          std::vector<Result>* output_args) {
-  if (!output_args) {
+                                          ArgumentsFrame* output_frame) {
+  if (!output_frame) {
     return Result::Failure("No place for preparing macro arguments is provided.");
   }
 
   int default_args_num = macro_definition.default_arguments.size();
   int redefined_default_args_num = macro.default_arguments.size();
   if (redefined_default_args_num > default_args_num) {
-    return Result::Failure("Macro " + macro.name + " has more default arguments than it's been defined. " +
+    return Result::Failure("Macro " + GetName(macro.name) + " has more default arguments than it's been defined. " +
                            "Expected " + std::to_string(default_args_num) + ", got " +
                            std::to_string(redefined_default_args_num) + ".");
   }
@@ -374,57 +788,83 @@ Result HtmlVisitor::PrepareMacroArguments(const Macro& macro,
   int args_num = macro_definition.default_arguments.size() + macro.arguments.size();
   int expected_args_num = macro_definition.arguments_num.get_value_or(0);
   if (args_num != expected_args_num) {
-    return Result::Failure("Macro " + macro.name + " has invalid number of arguments. " + "Expected " +
+    return Result::Failure("Macro " + GetName(macro.name) + " has invalid number of arguments. " + "Expected " +
                            std::to_string(expected_args_num) + ", got " + std::to_string(args_num) + ".");
   }
 
-  const auto get_argument = [&](int i) {
-    const auto list_at = [](const std::list<ast::Argument>& arguments, int index) {
-      return *std::next(arguments.begin(), index);
-    };
+  // Default arguments given at the call site override the leading default arguments of the definition.
+  utils::ArenaVector<const ast::Argument*>& args = output_frame->arguments;
+  args.reserve(args_num);
+  for (const auto& argument : macro.default_arguments) {
+    args.push_back(&argument);
+  }
+  auto default_argument_it = std::next(macro_definition.default_arguments.begin(), redefined_default_args_num);
+  for (; default_argument_it != macro_definition.default_arguments.end(); ++default_argument_it) {
+    args.push_back(&(*default_argument_it));
+  }
+  for (const auto& argument : macro.arguments) {
+    args.push_back(&argument);
+  }
 
-    if (i < redefined_default_args_num) {
-      return list_at(macro.default_arguments, i);
-    } else if (i < default_args_num) {
-      return list_at(macro_definition.default_arguments, i);
-    } else {
-      return list_at(macro.arguments, i - default_args_num);
-    }
-  };
+  output_frame->results.resize(args_num);
+  return Result::Success({}, {});
+}
 
-  output_args->resize(args_num);
-  for (int i = 0; i < args_num; ++i) {
-    Result child_result = (*this)(get_argument(i));
-    if (!child_result.is_successful) {
-      return child_result;
-    }
+void HtmlVisitor::SetProfiler(MacroProfiler* profiler) {
+  profiler_ = profiler;
+}
+
+void HtmlVisitor::BeginProfiledExpansion() {
+  profiled_expansions_.push_back({MacroProfiler::Clock::now(), MacroProfiler::Clock::duration::zero()});
+}
+
+void HtmlVisitor::EndProfiledExpansion(const std::string& name, const Result& result) {
+  const MacroProfiler::Clock::time_point finish = MacroProfiler::Clock::now();
+  const ProfiledExpansion expansion = profiled_expansions_.back();
+  profiled_expansions_.pop_back();
 
-    output_args->at(i) = std::move(child_result);
+  const MacroProfiler::Clock::duration inclusive_time = finish - expansion.start;
+  if (!profiled_expansions_.empty()) {
+    profiled_expansions_.back().nested_time += inclusive_time;
   }
 
-  return Result::Success("", "");
+  profiler_->RecordExpansion(name, expansion.start, finish, inclusive_time - expansion.nested_time,
+                             result.escaped.size());
 }
 
-const ast::CommandMacro* HtmlVisitor::GetDefinedCommandMacro(const std::string& name) const {
-  return GetMacroDefinition(defined_command_macros_, name);
+void HtmlVisitor::PushArgumentsFrame(ArgumentsFrame&& frame) {
+  frame.caller_frame_index = active_frame_index_;
+  frame.visible_command_macros_num = GetVisibleCommandMacrosNum();
+  frame.visible_environment_macros_num = GetVisibleEnvironmentMacrosNum();
+
+  arguments_stack_.push_back(std::move(frame));
+  active_frame_index_ = static_cast<int>(arguments_stack_.size()) - 1;
 }
 
-const ast::EnvironmentMacro* HtmlVisitor::GetDefinedEnvironmentMacro(const std::string& name) const {
-  return GetMacroDefinition(defined_environment_macros_, name);
+void HtmlVisitor::PopArgumentsFrame() {
+  active_frame_index_ = arguments_stack_.back().caller_frame_index;
+  arguments_stack_.pop_back();
 }
 
-const Result* HtmlVisitor::GetArgumentByReference(int index, bool is_outer) const {
-  int arguments_stack_index = static_cast<int>(arguments_stack_.size()) - (is_outer ? 2 : 1);
-  if (index < 0 || arguments_stack_index < 0) {
-    return nullptr;
-  }
-  const auto& arguments = arguments_stack_[arguments_stack_index];
+const std::string& HtmlVisitor::GetName(ast::SymbolId name) const {
+  return symbol_table_->GetName(name);
+}
 
-  if (arguments.size() <= index) {
-    return nullptr;
-  }
+std::size_t HtmlVisitor::FindDefinedCommandMacro(ast::SymbolId name) const {
+  return FindMacroDefinition(defined_command_macros_, command_macros_visibility_limit_, name);
+}
+
+std::size_t HtmlVisitor::FindDefinedEnvironmentMacro(ast::SymbolId name) const {
+  return FindMacroDefinition(defined_environment_macros_, environment_macros_visibility_limit_, name);
+}
 
-  return &arguments[index];
+std::size_t HtmlVisitor::GetVisibleCommandMacrosNum() const {
+  return std::min(command_macros_visibility_limit_, defined_command_macros_.size());
 }
+
+std::size_t HtmlVisitor::GetVisibleEnvironmentMacrosNum() const {
+  return std::min(environment_macros_visibility_limit_, defined_environment_macros_.size());
+}
+
 }  // namespace html_converter
 }  // namespace lightex
@@ -1,68 +1,275 @@
 #pragma once
 
+#include <cstddef>
+#include <limits>
+#include <list>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <lightex/ast/ast.h>
+#include <lightex/ast/symbol_table.h>
+#include <lightex/html_converter/macro_profiler.h>
+#include <lightex/utils/arena.h>
+#include <lightex/utils/rope.h>
 
-#include <boost/variant/static_visitor.hpp>
+#include <boost/optional/optional.hpp>
 
 namespace lightex {
 namespace html_converter {
 
+// Texts refer to the arena of the render, the program and the definitions, so results must not outlive any of them.
 struct Result {
   bool is_successful;
 
-  std::string escaped;
-  std::string unescaped;
+  utils::Rope escaped;
+  utils::Rope unescaped;
   std::string error_message;
 
   bool breaks_paragraph;
 
   static Result Failure(const std::string& error_message);
-  static Result Success(const std::string& escaped, const std::string& unescaped, bool breaks_paragraph = false);
+  static Result Success(utils::Rope escaped, utils::Rope unescaped, bool breaks_paragraph = false);
 };
 
-class HtmlVisitor : public boost::static_visitor<Result> {
+// Arguments of a single macro call. Arguments are evaluated lazily, the first time the macro body references them,
+// and the result is cached for later references.
+struct ArgumentsFrame {
+  utils::ArenaVector<const ast::Argument*> arguments;  // Not owned.
+  utils::ArenaVector<boost::optional<Result>> results;
+
+  // Frame that was active when the macro was called. Arguments are evaluated within it.
+  int caller_frame_index = -1;
+
+  // Numbers of macros that were visible when the macro was called.
+  std::size_t visible_command_macros_num = 0;
+  std::size_t visible_environment_macros_num = 0;
+};
+
+// Macro expansions nested deeper than this fail, e.g. those of endlessly recursive macros.
+constexpr int kDefaultMaxExpansionDepth = 1024;
+
+// Renders programs into HTML. The visitor walks the AST and expands macros with a work stack of its own instead of
+// recursion, so its thread stack usage doesn't depend on the program: the depth of a render is bounded by the maximum
+// expansion depth and by the nesting of the input, which the workspace checks before parsing.
+class HtmlVisitor {
  public:
-  HtmlVisitor() {}
+  // |symbol_table| must be the table the visited programs were parsed with.
+  explicit HtmlVisitor(const ast::SymbolTable* symbol_table);
 
   Result operator()(const ast::Program& program);
-  Result operator()(const ast::PlainText& plain_text);
-  Result operator()(const ast::Paragraph& paragraph);
-  Result operator()(const ast::ParagraphBreaker& paragraph_breaker);
-  Result operator()(const ast::Argument& argument);
-  Result operator()(const ast::ArgumentRef& argument_ref);
-  Result operator()(const ast::OuterArgumentRef& outer_argument_ref);
-  Result operator()(const ast::InlinedMathText& inlined_math_text);
-  Result operator()(const ast::MathText& math_text);
-  Result operator()(const ast::CommandMacro& command_macro);
-  Result operator()(const ast::EnvironmentMacro& environment_macro);
-  Result operator()(const ast::Command& command);
-  Result operator()(const ast::UnescapedCommand& unescaped_command);
-  Result operator()(const ast::NparagraphCommand& nparagraph_command);
-  Result operator()(const ast::Environment& environment);
-  Result operator()(const ast::VerbatimEnvironment& verbatim_environment);
+
+  // Makes the visitor name symbols with |symbol_table|, which must have the names of its definitions, e.g. be made on
+  // top of the table the definitions were parsed with.
+  void SetSymbolTable(const ast::SymbolTable* symbol_table);
+
+  // Renders the top-level nodes of |program| one by one into |node_outputs|, as many outputs as there are nodes, in
+  // order. Nodes see the macros defined by the ones before them and number their math formulas on their own, with
+  // kBlockIdPlaceholder in the ids (see block_diff.h), so an output doesn't depend on the formulas of other nodes.
+  bool RenderTopLevelNodes(const ast::Program& program,
+                           std::vector<std::string>* node_outputs,
+                           std::string* error_message);
+
+  // Makes expansions of macros nested deeper than |max_expansion_depth| calls fail. Copies of the visitor keep the
+  // limit.
+  void SetMaxExpansionDepth(int max_expansion_depth);
+
+  // Makes the visitor report every macro expansion to |profiler|, nullptr turns profiling off. Copies of the visitor
+  // keep reporting to the same profiler.
+  void SetProfiler(MacroProfiler* profiler);
+
+  // Renders in advance the argument-free command macros and the environment pre and post programs whose output is
+  // the same wherever they are expanded: free of math, macro definitions and references to outer arguments, and only
+  // calling macros which are constant as well. Their expansions append the stored output afterwards. Meant to be
+  // called once the style is visited; later definitions which shadow a macro used by a stored output disable it.
+  void FoldConstantMacros();
 
  private:
+  class ConstantChecker;
+  class NodeStarter;
+
+  // Step of an evaluation, see Evaluate(). Visits push the result of their node onto results_, either at once or
+  // through the tasks they schedule, the other tasks finish the results on top of results_.
+  struct Task {
+    enum class Type {
+      kVisitProgram,
+      kVisitArgument,
+      kVisitProgramNode,
+      kVisitParagraphNode,
+      kVisitArgumentNode,
+      // Replaces the top |index| results with their concatenation.
+      kJoinResults,
+      kFinishParagraph,
+      kFinishUnescapedCommand,
+      kFinishNparagraphCommand,
+      // Caches the result of argument |index| of frame |frame_index| and returns to the frame it was referenced from.
+      kFinishArgument,
+      kFinishCommand,
+      kContinueEnvironment,
+      kFinishEnvironment,
+    };
+
+    Type type;
+    const void* node;  // Not owned.
+
+    std::size_t index = 0;
+    int frame_index = -1;
+    int cached_active_frame_index = -1;
+    std::size_t cached_command_macros_visibility_limit = 0;
+    std::size_t cached_environment_macros_visibility_limit = 0;
+    // Whether the command or environment got as far as pushing its arguments frame.
+    bool is_expanded = false;
+  };
+
+  // State of an environment expansion, from its arguments frame up to its rollback.
+  struct EnvironmentExpansion {
+    enum class Stage {
+      kPreProgram,
+      kProgram,
+      kPostProgram,
+    };
+
+    // Holds the definition, whose nested definitions are bound to it.
+    std::shared_ptr<const ast::EnvironmentMacro> environment_macro;
+    std::size_t environment_macro_index;
+    std::size_t cached_defined_command_macros_num;
+    // Definitions made by the environment body belong to the caller's program.
+    std::shared_ptr<const void> caller_definitions_owner;
+
+    Stage stage = Stage::kPreProgram;
+    utils::RopeBuilder escaped;
+    utils::RopeBuilder unescaped;
+    bool breaks_paragraph = false;
+  };
+
+  struct FoldedMacro {
+    Result result;
+    // Command macros the output was rendered with, as (name, definition index) pairs. The output is valid as long as
+    // the names resolve to the same definitions.
+    std::vector<std::pair<ast::SymbolId, std::size_t>> dependencies;
+  };
+
+  struct ProfiledExpansion {
+    MacroProfiler::Clock::time_point start;
+    MacroProfiler::Clock::duration nested_time;
+  };
+
+  static Task MakeVisitTask(const ast::Program& program);
+  static Task MakeVisitTask(const ast::Argument& argument);
+  static Task MakeVisitTask(const ast::ProgramNode& program_node);
+  static Task MakeVisitTask(const ast::ParagraphNode& paragraph_node);
+  static Task MakeVisitTask(const ast::ArgumentNode& argument_node);
+
+  // Runs tasks until |root_task| and everything it has scheduled are done. A failed result stops the evaluation: the
+  // remaining tasks are aborted, which undoes the state changes they were due to undo, and the failure is returned.
+  Result Evaluate(const Task& root_task);
+  void RunTask(const Task& task);
+  void AbortTask(const Task& task, const Result& failure);
+
+  // Visits of nodes, which push a result or schedule the tasks making it.
+  void Visit(const ast::Program& program);
+  void Visit(const ast::PlainText& plain_text);
+  void Visit(const ast::HtmlEntity& html_entity);
+  void Visit(const ast::Paragraph& paragraph);
+  void Visit(const ast::ParagraphBreaker& paragraph_breaker);
+  void Visit(const ast::Argument& argument);
+  void Visit(const ast::ArgumentRef& argument_ref);
+  void Visit(const ast::OuterArgumentRef& outer_argument_ref);
+  void Visit(const ast::InlinedMathText& inlined_math_text);
+  void Visit(const ast::MathText& math_text);
+  void Visit(const ast::CommandMacro& command_macro);
+  void Visit(const ast::EnvironmentMacro& environment_macro);
+  void Visit(const ast::Command& command);
+  void Visit(const ast::UnescapedCommand& unescaped_command);
+  void Visit(const ast::NparagraphCommand& nparagraph_command);
+  void Visit(const ast::Environment& environment);
+  void Visit(const ast::VerbatimEnvironment& verbatim_environment);
+
   template <typename Node>
-  Result JoinNodeResults(const std::list<Node>& nodes);
+  void VisitNodes(const std::list<Node>& nodes);
+  void JoinResults(std::size_t results_num);
+  void FinishParagraph(Result* result);
+
+  // Evaluates argument |index| of the active frame, or of its caller's frame if |is_outer|, unless it's cached.
+  void VisitArgument(int index, bool is_outer, const char* error_message);
+  void FinishArgument(const Task& task);
+
+  void FinishCommand(const Task& task, const Result& result);
+  void ContinueEnvironment(const Task& task);
+  void FinishEnvironment(const Task& task, const Result& result);
+  // Pre and post programs are evaluated as parts of the definition.
+  void EnterEnvironmentMacroProgram(const EnvironmentExpansion& expansion);
+  void LeaveEnvironmentMacroProgram(const EnvironmentExpansion& expansion);
+
+  // Renders the program of a macro definition in advance, returns nullptr if its output isn't constant.
+  template <typename Program>
+  std::shared_ptr<const FoldedMacro> FoldMacroProgram(const Program& program);
+
+  // Output of the program, which must belong to the definition, rendered in advance or scheduled for evaluation.
+  template <typename Program>
+  void VisitMacroProgram(const Program& program,
+                         const std::vector<std::shared_ptr<const FoldedMacro>>& folded_programs,
+                         std::size_t definition_index);
+  bool IsFoldedMacroValid(const FoldedMacro& folded_macro) const;
+
+  bool IsExpansionDepthExceeded() const;
+
+  void BeginProfiledExpansion();
+  void EndProfiledExpansion(const std::string& name, const Result& result);
 
   template <typename Macro, typename MacroDefinition>
   Result PrepareMacroArguments(const Macro& macro,
                                const MacroDefinition& macro_definition,
-                               std::vector<Result>* output_args);
+                               ArgumentsFrame* output_frame);
+
+  // Makes a definition of |macro|, which belongs to the program being visited.
+  template <typename Macro>
+  std::shared_ptr<const Macro> BindDefinition(const Macro& macro) const;
+
+  void PushArgumentsFrame(ArgumentsFrame&& frame);
+  void PopArgumentsFrame();
 
-  const ast::CommandMacro* GetDefinedCommandMacro(const std::string& name) const;
-  const ast::EnvironmentMacro* GetDefinedEnvironmentMacro(const std::string& name) const;
-  const Result* GetArgumentByReference(int index, bool is_outer) const;
+  const std::string& GetName(ast::SymbolId name) const;
+  // Index of the visible definition in defined_command_macros_ or defined_environment_macros_, the number of
+  // definitions if there is none.
+  std::size_t FindDefinedCommandMacro(ast::SymbolId name) const;
+  std::size_t FindDefinedEnvironmentMacro(ast::SymbolId name) const;
+  std::size_t GetVisibleCommandMacrosNum() const;
+  std::size_t GetVisibleEnvironmentMacrosNum() const;
+
+  const ast::SymbolTable* symbol_table_;  // Not owned.
+  MacroProfiler* profiler_ = nullptr;      // Not owned.
+  std::size_t max_expansion_depth_ = kDefaultMaxExpansionDepth;
+  utils::ArenaVector<ProfiledExpansion> profiled_expansions_;
 
   int active_environment_definitions_num_ = 0;
   int math_text_span_num_ = 0;
-  std::vector<std::vector<Result>> arguments_stack_;
+  std::string math_text_span_id_prefix_ = "mathTextSpan";
+
+  // Work stack of the evaluation and the results of the finished tasks.
+  utils::ArenaVector<Task> tasks_;
+  utils::ArenaVector<Result> results_;
+  utils::ArenaVector<EnvironmentExpansion> environment_expansions_;
+
+  utils::ArenaVector<ArgumentsFrame> arguments_stack_;
+  int active_frame_index_ = -1;
+  std::size_t command_macros_visibility_limit_ = std::numeric_limits<std::size_t>::max();
+  std::size_t environment_macros_visibility_limit_ = std::numeric_limits<std::size_t>::max();
+
+  // Definitions nested into the programs of an environment macro share the AST of the enclosing definition, so
+  // entering the environment makes them without copying anything. Copies of the visitor share all definitions.
+  std::vector<std::shared_ptr<const ast::CommandMacro>> defined_command_macros_;
+  std::vector<std::shared_ptr<const ast::EnvironmentMacro>> defined_environment_macros_;
+  // Definition whose program is being expanded, nullptr for programs given to the visitor, which don't outlive the
+  // visit and whose definitions are copied.
+  std::shared_ptr<const void> definitions_owner_;
 
-  std::list<ast::CommandMacro> defined_command_macros_;
-  std::list<ast::EnvironmentMacro> defined_environment_macros_;
+  // Outputs of FoldConstantMacros() indexed as the definitions, nullptr for the macros which aren't constant. Shared
+  // between copies of the visitor.
+  std::vector<std::shared_ptr<const FoldedMacro>> folded_command_macros_;
+  std::vector<std::shared_ptr<const FoldedMacro>> folded_environment_pre_programs_;
+  std::vector<std::shared_ptr<const FoldedMacro>> folded_environment_post_programs_;
 };
 
 }  // namespace html_converter
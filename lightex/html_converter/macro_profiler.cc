@@ -0,0 +1,98 @@
+#include <lightex/html_converter/macro_profiler.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <utility>
+
+namespace lightex {
+namespace html_converter {
+namespace {
+
+double ToMicroseconds(MacroProfiler::Clock::duration duration) {
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+double ToMilliseconds(MacroProfiler::Clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Macro names consist of letters, braces and backslashes only.
+std::string EscapeStringForJson(const std::string& unescaped) {
+  std::string escaped;
+  for (char c : unescaped) {
+    if (c == '\\' || c == '"') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+}  // namespace
+
+MacroProfiler::MacroProfiler(bool records_timeline) : records_timeline_(records_timeline), origin_(Clock::now()) {}
+
+void MacroProfiler::RecordExpansion(const std::string& name,
+                                    Clock::time_point start,
+                                    Clock::time_point finish,
+                                    Clock::duration exclusive_time,
+                                    std::size_t bytes_num) {
+  std::unique_lock<std::mutex> lock(mtx_);
+
+  MacroStats& stats = stats_[name];
+  stats.calls_num += 1;
+  stats.inclusive_time += finish - start;
+  stats.exclusive_time += exclusive_time;
+  stats.bytes_num += bytes_num;
+
+  if (records_timeline_) {
+    expansions_.push_back({name, start, finish - start, bytes_num, std::this_thread::get_id()});
+  }
+}
+
+std::map<std::string, MacroProfiler::MacroStats> MacroProfiler::GetStats() const {
+  std::unique_lock<std::mutex> lock(mtx_);
+  return stats_;
+}
+
+void MacroProfiler::WriteReport(std::ostream* out) const {
+  std::vector<std::pair<std::string, MacroStats>> stats;
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    stats.assign(stats_.begin(), stats_.end());
+  }
+  std::sort(stats.begin(), stats.end(), [](const std::pair<std::string, MacroStats>& a,
+                                           const std::pair<std::string, MacroStats>& b) {
+    return a.second.exclusive_time > b.second.exclusive_time;
+  });
+
+  *out << "macro\tcalls\tinclusive_ms\texclusive_ms\tbytes\n";
+  *out << std::fixed << std::setprecision(3);
+  for (const auto& macro_stats : stats) {
+    *out << macro_stats.first << '\t' << macro_stats.second.calls_num << '\t'
+         << ToMilliseconds(macro_stats.second.inclusive_time) << '\t'
+         << ToMilliseconds(macro_stats.second.exclusive_time) << '\t' << macro_stats.second.bytes_num << '\n';
+  }
+}
+
+void MacroProfiler::WriteChromeTrace(std::ostream* out) const {
+  std::unique_lock<std::mutex> lock(mtx_);
+
+  // Trace viewers expect small numeric thread ids.
+  std::map<std::thread::id, int> thread_ids;
+
+  *out << "{\"traceEvents\":[";
+  *out << std::fixed << std::setprecision(3);
+  for (std::size_t i = 0; i < expansions_.size(); ++i) {
+    const Expansion& expansion = expansions_[i];
+    const int thread_id = thread_ids.emplace(expansion.thread_id, static_cast<int>(thread_ids.size())).first->second;
+
+    *out << (i > 0 ? ",\n" : "\n");
+    *out << "{\"name\":\"" << EscapeStringForJson(expansion.name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread_id
+         << ",\"ts\":" << ToMicroseconds(expansion.start - origin_) << ",\"dur\":" << ToMicroseconds(expansion.duration)
+         << ",\"args\":{\"bytes\":" << expansion.bytes_num << "}}";
+  }
+  *out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+}  // namespace html_converter
+}  // namespace lightex
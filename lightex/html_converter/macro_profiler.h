@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lightex {
+namespace html_converter {
+
+// Collects statistics of macro expansions done by HtmlVisitor: call count, inclusive and exclusive time and bytes of
+// escaped output per macro, and optionally every single expansion as a timeline. Macros are named "\name" for
+// commands and "\begin{name}" for environments. Safe to share between visitors rendering on different threads.
+class MacroProfiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct MacroStats {
+    std::uint64_t calls_num = 0;
+    Clock::duration inclusive_time = Clock::duration::zero();
+    // Inclusive time minus the time of the nested expansions.
+    Clock::duration exclusive_time = Clock::duration::zero();
+    std::uint64_t bytes_num = 0;
+  };
+
+  explicit MacroProfiler(bool records_timeline);
+
+  void RecordExpansion(const std::string& name,
+                       Clock::time_point start,
+                       Clock::time_point finish,
+                       Clock::duration exclusive_time,
+                       std::size_t bytes_num);
+
+  std::map<std::string, MacroStats> GetStats() const;
+
+  // Writes a tab separated table of the statistics, the macros with the largest exclusive time first.
+  void WriteReport(std::ostream* out) const;
+
+  // Writes the timeline in the Chrome trace event format, which chrome://tracing and Perfetto can open. Only the
+  // statistics are recorded without the timeline, so the trace is empty then.
+  void WriteChromeTrace(std::ostream* out) const;
+
+ private:
+  struct Expansion {
+    std::string name;
+    Clock::time_point start;
+    Clock::duration duration;
+    std::size_t bytes_num;
+    std::thread::id thread_id;
+  };
+
+  const bool records_timeline_;
+  const Clock::time_point origin_;
+
+  mutable std::mutex mtx_;
+  std::map<std::string, MacroStats> stats_;
+  std::vector<Expansion> expansions_;
+};
+
+}  // namespace html_converter
+}  // namespace lightex
@@ -0,0 +1,331 @@
+#include <lightex/lexer/lexer.h>
+
+#include <cstring>
+#include <limits>
+
+namespace lightex {
+namespace lexer {
+namespace {
+
+const char kVerbatimEnvironmentName[] = "{verbatim}";
+
+bool IsLetter(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Characters which may start a token other than kText.
+bool IsTokenStart(char c) {
+  switch (c) {
+    case '\\':
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case '$':
+    case '#':
+    case '%':
+    case '\n':
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+class TokenCollector : public TokenConsumer {
+ public:
+  explicit TokenCollector(std::vector<Token>* tokens) : tokens_(tokens) {}
+
+  bool Consume(const Token& token) override {
+    tokens_->push_back(token);
+    return true;
+  }
+
+ private:
+  std::vector<Token>* tokens_;  // Not owned.
+};
+
+class Lexer {
+ public:
+  Lexer(const std::string& input, std::size_t first, TokenConsumer* consumer)
+      : data_(input.data()), size_(input.size()), position_(first), consumer_(consumer) {}
+
+  // Returns false if the consumer has stopped the lexing.
+  bool Run() {
+    while (position_ < size_ && !is_stopped_) {
+      switch (data_[position_]) {
+        case '\\':
+          LexBackslash();
+          break;
+
+        case '{':
+          Emit(TokenType::kOpenBrace, position_ + 1);
+          break;
+
+        case '}':
+          Emit(TokenType::kCloseBrace, position_ + 1);
+          break;
+
+        case '[':
+          Emit(TokenType::kOpenBracket, position_ + 1);
+          break;
+
+        case ']':
+          Emit(TokenType::kCloseBracket, position_ + 1);
+          break;
+
+        case '$':
+          LexMath();
+          break;
+
+        case '#':
+          LexArgumentRef();
+          break;
+
+        case '%':
+          LexComment();
+          break;
+
+        case '\n':
+          LexLineBreak();
+          break;
+
+        default:
+          LexText();
+      }
+    }
+
+    ConsumePendingToken();
+    return !is_stopped_;
+  }
+
+ private:
+  // Emits the token [position_, last) and moves past it. Adjacent text tokens are merged, so a token is held back
+  // until the next one is known.
+  void Emit(TokenType type, std::size_t last) {
+    if (type == TokenType::kText && has_pending_token_ && pending_token_.type == TokenType::kText &&
+        pending_token_.last == position_) {
+      pending_token_.last = static_cast<std::uint32_t>(last);
+    } else {
+      ConsumePendingToken();
+      pending_token_ = {type, static_cast<std::uint32_t>(position_), static_cast<std::uint32_t>(last)};
+      has_pending_token_ = true;
+    }
+    position_ = last;
+  }
+
+  void ConsumePendingToken() {
+    if (has_pending_token_ && !is_stopped_) {
+      is_stopped_ = !consumer_->Consume(pending_token_);
+    }
+    has_pending_token_ = false;
+  }
+
+  bool StartsWith(std::size_t position, const char* prefix) const {
+    const std::size_t prefix_size = std::strlen(prefix);
+    return position + prefix_size <= size_ && std::memcmp(data_ + position, prefix, prefix_size) == 0;
+  }
+
+  void LexText() {
+    std::size_t last = position_ + 1;
+    while (last < size_ && !IsTokenStart(data_[last])) {
+      ++last;
+    }
+    Emit(TokenType::kText, last);
+  }
+
+  void LexBackslash() {
+    const std::size_t name_first = position_ + 1;
+    if (name_first == size_) {
+      Emit(TokenType::kText, name_first);
+      return;
+    }
+
+    if (!IsLetter(data_[name_first])) {
+      Emit(TokenType::kControlSymbol, name_first + 1);
+      return;
+    }
+
+    std::size_t last = name_first + 1;
+    while (last < size_ && IsLetter(data_[last])) {
+      ++last;
+    }
+
+    const bool is_begin = last - name_first == 5 && StartsWith(name_first, "begin");
+    Emit(TokenType::kCommandName, last);
+    if (is_begin) {
+      LexVerbatimEnvironmentStart();
+    }
+  }
+
+  // The verbatim environment is the only place where the lexical rules change: its content is taken as is up to the
+  // first backslash.
+  void LexVerbatimEnvironmentStart() {
+    std::size_t name_first = position_;
+    while (name_first < size_ && (data_[name_first] == ' ' || data_[name_first] == '\t')) {
+      ++name_first;
+    }
+    if (!StartsWith(name_first, kVerbatimEnvironmentName)) {
+      return;
+    }
+
+    if (name_first > position_) {
+      Emit(TokenType::kText, name_first);
+    }
+    Emit(TokenType::kOpenBrace, position_ + 1);
+    Emit(TokenType::kText, position_ + sizeof(kVerbatimEnvironmentName) - 3);
+    Emit(TokenType::kCloseBrace, position_ + 1);
+
+    std::size_t last = position_;
+    while (last < size_ && data_[last] != '\\') {
+      ++last;
+    }
+    if (last > position_) {
+      Emit(TokenType::kVerbatimText, last);
+    }
+  }
+
+  void LexMath() {
+    const bool is_display = StartsWith(position_, "$$");
+    const TokenType delimiter_type = is_display ? TokenType::kDisplayMathDelimiter : TokenType::kMathDelimiter;
+    Emit(delimiter_type, position_ + (is_display ? 2 : 1));
+
+    std::size_t last = position_;
+    while (last < size_ && data_[last] != '$') {
+      last += (data_[last] == '\\' && last + 1 < size_ && data_[last + 1] == '$') ? 2 : 1;
+    }
+    if (last > position_) {
+      Emit(TokenType::kMathText, last);
+    }
+
+    if (position_ < size_) {
+      const bool is_display_end = is_display && StartsWith(position_, "$$");
+      Emit(is_display_end ? TokenType::kDisplayMathDelimiter : TokenType::kMathDelimiter,
+           position_ + (is_display_end ? 2 : 1));
+    }
+  }
+
+  void LexArgumentRef() {
+    const bool is_outer = StartsWith(position_, "##");
+    std::size_t last = position_ + (is_outer ? 2 : 1);
+    if (last < size_ && (data_[last] == '+' || data_[last] == '-')) {
+      ++last;
+    }
+    if (last == size_ || !IsDigit(data_[last])) {
+      Emit(TokenType::kText, position_ + 1);
+      return;
+    }
+
+    while (last < size_ && IsDigit(data_[last])) {
+      ++last;
+    }
+    Emit(is_outer ? TokenType::kOuterArgumentRef : TokenType::kArgumentRef, last);
+  }
+
+  void LexComment() {
+    std::size_t last = position_ + 1;
+    while (last < size_ && data_[last] != '\n') {
+      ++last;
+    }
+    Emit(TokenType::kComment, last < size_ ? last + 1 : last);
+  }
+
+  void LexLineBreak() {
+    std::size_t last_line_break = position_;
+    for (std::size_t i = position_ + 1; i < size_ && (data_[i] == ' ' || data_[i] == '\n'); ++i) {
+      if (data_[i] == '\n') {
+        last_line_break = i;
+      }
+    }
+
+    if (last_line_break == position_) {
+      LexText();
+    } else {
+      Emit(TokenType::kParagraphBreak, last_line_break + 1);
+    }
+  }
+
+  const char* data_;
+  std::size_t size_;
+  std::size_t position_;
+
+  Token pending_token_ = {};
+  bool has_pending_token_ = false;
+  bool is_stopped_ = false;
+
+  // Not owned.
+  TokenConsumer* consumer_;
+};
+}  // namespace
+
+bool Tokenize(const std::string& input, std::vector<Token>* tokens, std::string* error_message) {
+  return Tokenize(input, 0, tokens, error_message);
+}
+
+bool Tokenize(const std::string& input, std::size_t first, std::vector<Token>* tokens, std::string* error_message) {
+  if (!tokens) {
+    return false;
+  }
+
+  TokenCollector collector(tokens);
+  return ForEachToken(input, first, &collector, error_message);
+}
+
+bool ForEachToken(const std::string& input, std::size_t first, TokenConsumer* consumer, std::string* error_message) {
+  if (!consumer) {
+    return false;
+  }
+
+  if (input.size() > std::numeric_limits<std::uint32_t>::max()) {
+    if (error_message) {
+      *error_message = "Input is too large to be tokenized.";
+    }
+    return false;
+  }
+
+  Lexer lexer(input, first, consumer);
+  return lexer.Run();
+}
+
+const char* GetTokenTypeName(TokenType type) {
+  switch (type) {
+    case TokenType::kText:
+      return "TEXT";
+    case TokenType::kControlSymbol:
+      return "CONTROL_SYMBOL";
+    case TokenType::kCommandName:
+      return "COMMAND_NAME";
+    case TokenType::kOpenBrace:
+      return "OPEN_BRACE";
+    case TokenType::kCloseBrace:
+      return "CLOSE_BRACE";
+    case TokenType::kOpenBracket:
+      return "OPEN_BRACKET";
+    case TokenType::kCloseBracket:
+      return "CLOSE_BRACKET";
+    case TokenType::kMathDelimiter:
+      return "MATH_DELIMITER";
+    case TokenType::kDisplayMathDelimiter:
+      return "DISPLAY_MATH_DELIMITER";
+    case TokenType::kMathText:
+      return "MATH_TEXT";
+    case TokenType::kArgumentRef:
+      return "ARGUMENT_REF";
+    case TokenType::kOuterArgumentRef:
+      return "OUTER_ARGUMENT_REF";
+    case TokenType::kComment:
+      return "COMMENT";
+    case TokenType::kParagraphBreak:
+      return "PARAGRAPH_BREAK";
+    case TokenType::kVerbatimText:
+      return "VERBATIM_TEXT";
+  }
+  return "UNKNOWN";
+}
+
+}  // namespace lexer
+}  // namespace lightex
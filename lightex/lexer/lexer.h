@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lightex {
+namespace lexer {
+
+enum class TokenType : std::uint8_t {
+  // Run of plain text, white space and characters which don't start any other token.
+  kText,
+  // Backslash followed by a non-letter, e.g. "\%" or "\,".
+  kControlSymbol,
+  // Backslash followed by letters, e.g. "\begin".
+  kCommandName,
+  kOpenBrace,
+  kCloseBrace,
+  kOpenBracket,
+  kCloseBracket,
+  // "$" and "$$".
+  kMathDelimiter,
+  kDisplayMathDelimiter,
+  // Everything between math delimiters.
+  kMathText,
+  // "#1" and "##1".
+  kArgumentRef,
+  kOuterArgumentRef,
+  // From "%" up to and including the end of the line.
+  kComment,
+  // Two or more line breaks separated by spaces only.
+  kParagraphBreak,
+  // Content of the verbatim environment.
+  kVerbatimText,
+};
+
+// Half-open range [first, last) of byte offsets into the input.
+struct Token {
+  TokenType type;
+  std::uint32_t first;
+  std::uint32_t last;
+};
+
+// Splits the input into a flat stream of tokens which follows the lexical rules of the grammar (see
+// grammar/grammar.h). The tokens cover the whole input without gaps, so every byte belongs to exactly one token.
+// Tokenization never fails on malformed markup, that is left for the parser to report; it fails only on inputs which
+// don't fit into 32-bit offsets.
+bool Tokenize(const std::string& input, std::vector<Token>* tokens, std::string* error_message);
+// Tokenizes the part of |input| from |first| on as if it was the whole input. Offsets of the tokens are still relative
+// to the beginning of |input|.
+bool Tokenize(const std::string& input, std::size_t first, std::vector<Token>* tokens, std::string* error_message);
+
+class TokenConsumer {
+ public:
+  virtual ~TokenConsumer() = default;
+
+  // Returns false to stop the tokenization.
+  virtual bool Consume(const Token& token) = 0;
+};
+
+// Passes the tokens of Tokenize() to |consumer| in order as they are found, without storing them. Returns false if
+// the input can't be tokenized or the consumer has stopped the tokenization.
+bool ForEachToken(const std::string& input, std::size_t first, TokenConsumer* consumer, std::string* error_message);
+
+// Returns the name of the token type in upper snake case, e.g. "COMMAND_NAME".
+const char* GetTokenTypeName(TokenType type);
+
+}  // namespace lexer
+}  // namespace lightex
@@ -0,0 +1,81 @@
+#include <lightex/lexer/nesting_depth.h>
+
+#include <algorithm>
+
+namespace lightex {
+namespace lexer {
+namespace {
+
+bool IsCommand(const std::string& input, const Token& token, const char* name) {
+  return token.type == TokenType::kCommandName && input.compare(token.first, token.last - token.first, name) == 0;
+}
+
+// Stops at the first token nested deeper than the limit.
+class DepthChecker : public TokenConsumer {
+ public:
+  DepthChecker(const std::string& input, int max_depth) : input_(input), max_depth_(max_depth) {}
+
+  bool Consume(const Token& token) override {
+    depth_ += GetNestingDepthChange(input_, token);
+    if (depth_ > max_depth_) {
+      failed_offset_ = token.first;
+      return false;
+    }
+    return true;
+  }
+
+  bool IsExceeded() const { return depth_ > max_depth_; }
+  std::uint32_t GetFailedOffset() const { return failed_offset_; }
+
+ private:
+  const std::string& input_;
+  const int max_depth_;
+  int depth_ = 0;
+  std::uint32_t failed_offset_ = 0;
+};
+}  // namespace
+
+int GetNestingDepthChange(const std::string& input, const Token& token) {
+  switch (token.type) {
+    case TokenType::kOpenBrace:
+    case TokenType::kOpenBracket:
+      return 1;
+
+    case TokenType::kCloseBrace:
+    case TokenType::kCloseBracket:
+      return -1;
+
+    case TokenType::kCommandName:
+      if (IsCommand(input, token, "\\begin")) {
+        return 1;
+      }
+      if (IsCommand(input, token, "\\end")) {
+        return -1;
+      }
+      return 0;
+
+    default:
+      return 0;
+  }
+}
+
+bool CheckNestingDepth(const std::string& input, std::size_t first, int max_depth, std::string* error_message) {
+  // Every level is opened by at least one byte.
+  if (max_depth < 0 || input.size() - std::min(first, input.size()) <= static_cast<std::size_t>(max_depth)) {
+    return true;
+  }
+
+  DepthChecker checker(input, max_depth);
+  if (ForEachToken(input, first, &checker, error_message)) {
+    return true;
+  }
+
+  if (checker.IsExceeded() && error_message) {
+    *error_message = "Input is nested deeper than " + std::to_string(max_depth) + " levels at offset " +
+                     std::to_string(checker.GetFailedOffset()) + ".";
+  }
+  return false;
+}
+
+}  // namespace lexer
+}  // namespace lightex
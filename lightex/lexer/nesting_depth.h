@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+#include <lightex/lexer/lexer.h>
+
+namespace lightex {
+namespace lexer {
+
+// Change of the nesting depth made by |token| of |input|: 1 for tokens opening a group the grammar parses
+// recursively, i.e. braces, brackets and "\begin", -1 for the tokens closing them and 0 otherwise.
+int GetNestingDepthChange(const std::string& input, const Token& token);
+
+// Checks that groups of the part of the input from |first| on are nested at most |max_depth| levels deep in a single
+// pass over its tokens. The parser recurses on the thread stack for every level, so inputs can be checked before
+// parsing to keep its stack usage bounded. Fails with a description of the error, also if the input can't be
+// tokenized. Negative |max_depth| means no limit.
+bool CheckNestingDepth(const std::string& input, std::size_t first, int max_depth, std::string* error_message);
+
+}  // namespace lexer
+}  // namespace lightex
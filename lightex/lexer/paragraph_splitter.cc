@@ -0,0 +1,125 @@
+#include <lightex/lexer/paragraph_splitter.h>
+
+#include <algorithm>
+
+#include <lightex/lexer/lexer.h>
+#include <lightex/lexer/nesting_depth.h>
+
+namespace lightex {
+namespace lexer {
+namespace {
+
+bool IsBlank(const std::string& input, const Token& token) {
+  for (std::uint32_t i = token.first; i < token.last; ++i) {
+    if (input[i] != ' ' && input[i] != '\t' && input[i] != '\n' && input[i] != '\r') {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Index of the first token after |index| which isn't white space or a paragraph break, tokens.size() if there's none.
+std::size_t FindNextSignificantToken(const std::string& input, const std::vector<Token>& tokens, std::size_t index) {
+  for (std::size_t i = index + 1; i < tokens.size(); ++i) {
+    const Token& token = tokens[i];
+    if (token.type != TokenType::kParagraphBreak && !(token.type == TokenType::kText && IsBlank(input, token))) {
+      return i;
+    }
+  }
+  return tokens.size();
+}
+
+bool IsArgumentStart(const Token& token) {
+  return token.type == TokenType::kOpenBrace || token.type == TokenType::kOpenBracket;
+}
+
+// Indices of the paragraph breaks outside of braces, brackets and environments, but not at the very beginning of the
+// tokenized part of the input, which starts at |first|. Fails if the nesting is unbalanced, although only on closings
+// without a match for inputs that are the beginning of a longer one.
+bool FindTopLevelParagraphBreaks(const std::string& input,
+                                 std::size_t first,
+                                 const std::vector<Token>& tokens,
+                                 bool is_prefix,
+                                 std::vector<std::size_t>* break_indices) {
+  int depth = 0;
+  for (std::size_t i = 0; i < tokens.size(); ++i) {
+    const Token& token = tokens[i];
+    depth += GetNestingDepthChange(input, token);
+    if (token.type == TokenType::kParagraphBreak && depth == 0 && token.first > first) {
+      break_indices->push_back(i);
+    }
+
+    if (depth < 0) {
+      return false;
+    }
+  }
+
+  return is_prefix || depth == 0;
+}
+}  // namespace
+
+bool SplitAtTopLevelParagraphBreaks(const std::string& input,
+                                    std::size_t max_chunks_num,
+                                    std::size_t min_chunk_size,
+                                    std::vector<std::size_t>* chunk_offsets) {
+  if (!chunk_offsets || max_chunks_num < 2 || input.size() < 2 * min_chunk_size) {
+    return false;
+  }
+
+  std::vector<Token> tokens;
+  std::vector<std::size_t> break_indices;
+  if (!Tokenize(input, &tokens, nullptr) || !FindTopLevelParagraphBreaks(input, 0, tokens, false, &break_indices)) {
+    return false;
+  }
+
+  // Commands and environments take their arguments across white space, so "\x{a}\n\n{b}" is a single command. A
+  // break followed by an argument doesn't separate anything.
+  std::vector<std::size_t> break_offsets;
+  for (std::size_t break_index : break_indices) {
+    const std::size_t next_index = FindNextSignificantToken(input, tokens, break_index);
+    if (next_index == tokens.size() || !IsArgumentStart(tokens[next_index])) {
+      break_offsets.push_back(tokens[break_index].first);
+    }
+  }
+
+  chunk_offsets->clear();
+  chunk_offsets->push_back(0);
+  const std::size_t target_chunk_size = std::max(input.size() / max_chunks_num, min_chunk_size);
+  for (std::size_t offset : break_offsets) {
+    if (chunk_offsets->size() == max_chunks_num || input.size() - offset < min_chunk_size) {
+      break;
+    }
+    if (offset - chunk_offsets->back() >= target_chunk_size) {
+      chunk_offsets->push_back(offset);
+    }
+  }
+  chunk_offsets->push_back(input.size());
+
+  return chunk_offsets->size() > 2;
+}
+
+bool FindLastTopLevelParagraphBreak(const std::string& input, std::size_t first, std::size_t* break_offset) {
+  if (!break_offset) {
+    return false;
+  }
+
+  std::vector<Token> tokens;
+  std::vector<std::size_t> break_indices;
+  if (!Tokenize(input, first, &tokens, nullptr) ||
+      !FindTopLevelParagraphBreaks(input, first, tokens, true, &break_indices)) {
+    return false;
+  }
+
+  // Whether a break separates anything is known only once the token following it is.
+  for (auto break_index_it = break_indices.rbegin(); break_index_it != break_indices.rend(); ++break_index_it) {
+    const std::size_t next_index = FindNextSignificantToken(input, tokens, *break_index_it);
+    if (next_index < tokens.size() && !IsArgumentStart(tokens[next_index])) {
+      *break_offset = tokens[*break_index_it].first;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace lexer
+}  // namespace lightex
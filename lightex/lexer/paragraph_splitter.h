@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace lightex {
+namespace lexer {
+
+// Finds paragraph breaks outside of braces, brackets, environments and verbatim, where the input can be cut into
+// pieces that parse into consecutive parts of the same program. Picks at most |max_chunks_num| - 1 of them, so that
+// the chunks are of roughly equal size and none is shorter than |min_chunk_size| bytes, and stores the chunk
+// boundaries, from 0 to input.size(), into |chunk_offsets|.
+//
+// Returns false if the input can't be split, e.g. when it's too small or its nesting is unbalanced. A split is a
+// guess based on tokens only: chunks may still fail to parse separately while the whole input parses.
+bool SplitAtTopLevelParagraphBreaks(const std::string& input,
+                                    std::size_t max_chunks_num,
+                                    std::size_t min_chunk_size,
+                                    std::vector<std::size_t>* chunk_offsets);
+
+// Finds the last paragraph break at which SplitAtTopLevelParagraphBreaks could cut the part of |input| from |first| on,
+// which is the beginning of a longer input whose rest isn't known yet, e.g. when it is read from a stream. The break
+// must be followed by a token that shows it separates the parts around it, so inputs ending with a break aren't cut
+// there. Stores the offset of the break in |input| into |break_offset|; returns false if there is no such break.
+bool FindLastTopLevelParagraphBreak(const std::string& input, std::size_t first, std::size_t* break_offset);
+
+}  // namespace lexer
+}  // namespace lightex
@@ -0,0 +1,60 @@
+#include <lightex/patch_renderer/patch_renderer.h>
+
+#include <sstream>
+#include <vector>
+
+#include <lightex/ast/ast.h>
+#include <lightex/ast/symbol_table.h>
+#include <lightex/html_converter/html_visitor.h>
+#include <lightex/utils/arena.h>
+
+namespace lightex {
+namespace patch_renderer {
+
+PatchRenderer::PatchRenderer(std::shared_ptr<engine::Engine> engine) : engine_(engine) {}
+
+bool PatchRenderer::ParseProgramToPatch(const std::string& document_id,
+                                        const std::string& input,
+                                        std::string* error_message,
+                                        std::string* output) {
+  if (!output) {
+    return false;
+  }
+
+  std::shared_ptr<const style_cache::CompiledStyle> style = engine_->GetLoadedStyle();
+  ast::SymbolTable symbol_table(style->symbol_table.get());
+  ast::Program ast;
+  if (!engine_->ParseProgramToAst(input, &symbol_table, error_message, &ast)) {
+    return false;
+  }
+
+  std::vector<std::string> block_htmls;
+  {
+    utils::Arena arena;
+    utils::ArenaScope arena_scope(&arena);
+
+    html_converter::HtmlVisitor visitor_copy = engine_->CopyHtmlVisitor(*style, &symbol_table);
+    if (!visitor_copy.RenderTopLevelNodes(ast, &block_htmls, error_message)) {
+      return false;
+    }
+  }
+
+  std::vector<html_converter::BlockPatchOperation> operations;
+  {
+    std::unique_lock<std::mutex> lock(documents_mtx_);
+    html_converter::DiffBlocks(std::move(block_htmls), &documents_[document_id], &operations);
+  }
+
+  std::ostringstream patch;
+  html_converter::WriteBlockPatch(operations, &patch);
+  *output = patch.str();
+  return true;
+}
+
+void PatchRenderer::ForgetDocument(const std::string& document_id) {
+  std::unique_lock<std::mutex> lock(documents_mtx_);
+  documents_.erase(document_id);
+}
+
+}  // namespace patch_renderer
+}  // namespace lightex
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <lightex/engine/engine.h>
+#include <lightex/html_converter/block_diff.h>
+
+namespace lightex {
+namespace patch_renderer {
+
+// Renders programs to HTML with the loaded style of the engine, and outputs them as patches against the previous
+// render of the same document (see html_converter/block_diff.h). Thread safe.
+class PatchRenderer {
+ public:
+  explicit PatchRenderer(std::shared_ptr<engine::Engine> engine);
+
+  // The render of |document_id| is kept until ForgetDocument().
+  bool ParseProgramToPatch(const std::string& document_id,
+                           const std::string& input,
+                           std::string* error_message,
+                           std::string* output);
+  void ForgetDocument(const std::string& document_id);
+
+ private:
+  std::shared_ptr<engine::Engine> engine_;
+
+  std::map<std::string, html_converter::DocumentBlocks> documents_;
+  std::mutex documents_mtx_;
+};
+
+}  // namespace patch_renderer
+}  // namespace lightex
@@ -0,0 +1,164 @@
+#include <lightex/stream_renderer/stream_renderer.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <lightex/ast/ast.h>
+#include <lightex/ast/symbol_table.h>
+#include <lightex/html_converter/html_visitor.h>
+#include <lightex/lexer/nesting_depth.h>
+#include <lightex/lexer/paragraph_splitter.h>
+#include <lightex/utils/arena.h>
+#include <lightex/utils/utf8_utils.h>
+
+namespace lightex {
+namespace stream_renderer {
+namespace {
+
+// Inputs are read in pieces of this size, and cut into blocks once at least this much of them is pending.
+const std::size_t kReadSize = 64 * 1024;
+// A block which fails to parse is retried along with up to twice as much input this many times, in case the input
+// following it makes it parse, before the error is reported.
+const int kMaxBlockRetriesNum = 2;
+
+// Normalizes the read part of |raw_input| that can be normalized without the input following it, all of it once
+// |is_input_read|, and moves it to the end of |normalized_input|.
+bool AppendNormalizedInput(bool is_input_read,
+                           std::string* raw_input,
+                           std::uint64_t* raw_input_offset,
+                           std::string* normalized_input,
+                           std::string* error_message) {
+  const std::size_t normalizable_size =
+      is_input_read ? raw_input->size() : utils::GetNormalizablePrefixSize(*raw_input);
+  std::string normalized_part;
+  std::size_t invalid_offset = 0;
+  if (!utils::NormalizeUtf8Input(raw_input->substr(0, normalizable_size), &normalized_part, &invalid_offset)) {
+    if (error_message) {
+      *error_message = engine::kInvalidUtf8Error + std::to_string(*raw_input_offset + invalid_offset);
+    }
+    return false;
+  }
+
+  *normalized_input += normalized_part;
+  raw_input->erase(0, normalizable_size);
+  *raw_input_offset += normalizable_size;
+  return true;
+}
+
+bool RenderBlock(const ast::Program& ast,
+                 html_converter::HtmlVisitor* visitor,
+                 std::string* error_message,
+                 std::ostream* out) {
+  utils::Arena arena;
+  utils::ArenaScope arena_scope(&arena);
+
+  html_converter::Result result = (*visitor)(ast);
+  if (!result.is_successful) {
+    if (error_message) {
+      *error_message = result.error_message;
+    }
+    return false;
+  }
+
+  const auto write_fragment = [out](const char* data, std::size_t size) {
+    return static_cast<bool>(out->write(data, size));
+  };
+  if (!result.escaped.ForEachFragment(write_fragment)) {
+    if (error_message) {
+      *error_message = "Failed to write the output.";
+    }
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+StreamRenderer::StreamRenderer(std::shared_ptr<const engine::Engine> engine) : engine_(engine) {}
+
+bool StreamRenderer::Render(std::istream* in, std::ostream* out, std::string* error_message) const {
+  if (!in || !out) {
+    return false;
+  }
+
+  // The visitor is copied outside of the arenas of the blocks, which it outlives along with the macros they define.
+  // Names of all blocks are interned into a table of the stream.
+  std::shared_ptr<const style_cache::CompiledStyle> style = engine_->GetLoadedStyle();
+  ast::SymbolTable symbol_table(style->symbol_table.get());
+  html_converter::HtmlVisitor visitor = engine_->CopyHtmlVisitor(*style, &symbol_table);
+
+  // Bytes read but not normalized yet, and normalized input, which isn't rendered yet from |pending_first| on. The
+  // rendered part is dropped once it is at least as large as the rest, so every byte is moved a bounded number of
+  // times.
+  std::string raw_input;
+  std::uint64_t raw_input_offset = 0;
+  std::string pending_input;
+  std::size_t pending_first = 0;
+  // Pending input is cut only once it grows to this size, so that every byte is tokenized a bounded number of times
+  // even when blocks are much larger than the pieces read.
+  std::size_t next_cut_size = kReadSize;
+  int block_retries_num = 0;
+
+  std::vector<char> buffer(kReadSize);
+  bool is_input_read = false;
+  while (!is_input_read) {
+    in->read(buffer.data(), buffer.size());
+    if (in->bad()) {
+      if (error_message) {
+        *error_message = "Failed to read the input.";
+      }
+      return false;
+    }
+    raw_input.append(buffer.data(), in->gcount());
+    is_input_read = in->eof();
+
+    if (!AppendNormalizedInput(is_input_read, &raw_input, &raw_input_offset, &pending_input, error_message)) {
+      return false;
+    }
+    const std::size_t pending_size = pending_input.size() - pending_first;
+    if (!is_input_read && pending_size < next_cut_size) {
+      continue;
+    }
+
+    if (!lexer::CheckNestingDepth(pending_input, pending_first, engine_->GetMaxNestingDepth(), error_message)) {
+      return false;
+    }
+
+    std::size_t block_last = pending_input.size();
+    if (!is_input_read && !lexer::FindLastTopLevelParagraphBreak(pending_input, pending_first, &block_last)) {
+      next_cut_size = 2 * pending_size;
+      continue;
+    }
+
+    // A block may fail to parse on its own while it parses along with the input that follows.
+    ast::Program ast;
+    std::string parsing_error_message;
+    if (!engine::Engine::ParseRangeToAst(pending_input, pending_first, block_last, &symbol_table,
+                                         &parsing_error_message, &ast)) {
+      if (is_input_read || block_retries_num == kMaxBlockRetriesNum) {
+        if (error_message) {
+          *error_message = parsing_error_message;
+        }
+        return false;
+      }
+      ++block_retries_num;
+      next_cut_size = 2 * pending_size;
+      continue;
+    }
+
+    if (!RenderBlock(ast, &visitor, error_message, out)) {
+      return false;
+    }
+    block_retries_num = 0;
+    pending_first = block_last;
+    if (pending_first >= pending_input.size() - pending_first) {
+      pending_input.erase(0, pending_first);
+      pending_first = 0;
+    }
+    next_cut_size = pending_input.size() - pending_first + kReadSize;
+  }
+
+  return true;
+}
+
+}  // namespace stream_renderer
+}  // namespace lightex
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include <lightex/engine/engine.h>
+
+namespace lightex {
+namespace stream_renderer {
+
+// Renders inputs to HTML block by block as they are read (see lexer/paragraph_splitter.h), with memory bounded by the
+// largest block, using the loaded style and the limits of the engine.
+class StreamRenderer {
+ public:
+  explicit StreamRenderer(std::shared_ptr<const engine::Engine> engine);
+
+  // Every block is written once it is rendered, so a failure leaves the output of the blocks before it written. The
+  // AST cache isn't used. Thread safe.
+  bool Render(std::istream* in, std::ostream* out, std::string* error_message) const;
+
+ private:
+  std::shared_ptr<const engine::Engine> engine_;
+};
+
+}  // namespace stream_renderer
+}  // namespace lightex
@@ -0,0 +1,105 @@
+#include <lightex/style_cache/style_cache.h>
+
+#include <utility>
+
+namespace lightex {
+namespace style_cache {
+
+CompiledStyle::CompiledStyle()
+    : symbol_table(std::make_shared<ast::SymbolTable>()),
+      html_visitor(symbol_table.get()),
+      text_visitor(symbol_table.get()) {}
+
+CompiledStyle::CompiledStyle(const CompiledStyle& base_style)
+    : symbol_table(std::make_shared<ast::SymbolTable>(*base_style.symbol_table)),
+      html_visitor(base_style.html_visitor),
+      text_visitor(base_style.text_visitor),
+      source_size_bytes(base_style.source_size_bytes) {
+  html_visitor.SetSymbolTable(symbol_table.get());
+  text_visitor.SetSymbolTable(symbol_table.get());
+}
+
+StyleCache::StyleCache(std::uint64_t max_size_bytes) : max_size_bytes_(max_size_bytes) {}
+
+std::shared_ptr<const CompiledStyle> StyleCache::Get(const std::string& style_id,
+                                                     const Compiler& compiler,
+                                                     std::string* error_message) {
+  std::promise<CompilationResult> promise;
+  std::shared_future<CompilationResult> result;
+  bool is_compiled_here = false;
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto it = entries_.find(style_id);
+    if (it != entries_.end()) {
+      ++stats_.hits_num;
+      if (it->second.is_compiled) {
+        lru_style_ids_.splice(lru_style_ids_.begin(), lru_style_ids_, it->second.lru_it);
+      }
+      result = it->second.result;
+    } else {
+      ++stats_.misses_num;
+      result = promise.get_future().share();
+      entries_[style_id].result = result;
+      is_compiled_here = true;
+    }
+  }
+
+  // Somebody else is compiling the style, or has already compiled it.
+  if (!is_compiled_here) {
+    const CompilationResult& compilation_result = result.get();
+    if (!compilation_result.style && error_message) {
+      *error_message = compilation_result.error_message;
+    }
+    return compilation_result.style;
+  }
+
+  CompilationResult compilation_result;
+  compilation_result.style = compiler(style_id, &compilation_result.error_message);
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto it = entries_.find(style_id);
+    if (compilation_result.style) {
+      lru_style_ids_.push_front(style_id);
+      it->second.is_compiled = true;
+      it->second.size_bytes = compilation_result.style->source_size_bytes;
+      it->second.lru_it = lru_style_ids_.begin();
+      stats_.size_bytes += compilation_result.style->source_size_bytes;
+      ++stats_.styles_num;
+      TrimToMaxSize();
+    } else {
+      entries_.erase(it);
+    }
+  }
+
+  promise.set_value(compilation_result);
+  if (!compilation_result.style && error_message) {
+    *error_message = compilation_result.error_message;
+  }
+  return compilation_result.style;
+}
+
+void StyleCache::SetMaxSizeBytes(std::uint64_t max_size_bytes) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  max_size_bytes_ = max_size_bytes;
+  TrimToMaxSize();
+}
+
+Stats StyleCache::GetStats() const {
+  std::unique_lock<std::mutex> lock(mtx_);
+  return stats_;
+}
+
+void StyleCache::TrimToMaxSize() {
+  while (stats_.size_bytes > max_size_bytes_ && !lru_style_ids_.empty()) {
+    auto it = entries_.find(lru_style_ids_.back());
+    stats_.size_bytes -= it->second.size_bytes;
+    --stats_.styles_num;
+    ++stats_.evictions_num;
+
+    entries_.erase(it);
+    lru_style_ids_.pop_back();
+  }
+}
+
+}  // namespace style_cache
+}  // namespace lightex
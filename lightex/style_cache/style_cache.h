@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <lightex/ast/symbol_table.h>
+#include <lightex/html_converter/html_visitor.h>
+#include <lightex/text_converter/text_visitor.h>
+
+namespace lightex {
+namespace style_cache {
+
+// Macro definitions of a style, ready to render programs with: visitors are copied from it for every program, which
+// is parsed on top of |symbol_table|.
+struct CompiledStyle {
+  CompiledStyle();
+  // Copies the definitions and the names of |base_style|, e.g. to compile another style on top of it.
+  CompiledStyle(const CompiledStyle& base_style);
+  CompiledStyle& operator=(const CompiledStyle&) = delete;
+
+  // Names of the definitions, no more are interned once the style is compiled.
+  std::shared_ptr<ast::SymbolTable> symbol_table;
+  html_converter::HtmlVisitor html_visitor;
+  text_converter::TextVisitor text_visitor;
+
+  // Size of the style files the style is compiled from, which weighs it in the cache. It isn't the memory the style
+  // takes, which is larger: the definitions are AST nodes, copied into every visitor.
+  std::uint64_t source_size_bytes = 0;
+};
+
+struct Stats {
+  std::uint64_t hits_num = 0;
+  std::uint64_t misses_num = 0;
+  std::uint64_t evictions_num = 0;
+  // Total source size of the cached styles.
+  std::uint64_t size_bytes = 0;
+  std::size_t styles_num = 0;
+};
+
+// In-memory LRU cache of compiled styles, bounded by the total size of their sources. Missing styles are compiled on demand
+// outside of the lock, so compiling one style doesn't block requests for other ones; concurrent requests for a style
+// which is being compiled wait for that compilation instead of starting another one. Failed compilations aren't
+// cached.
+//
+// Styles stay alive while they are in use, even if they have already been evicted.
+class StyleCache {
+ public:
+  using Compiler =
+      std::function<std::shared_ptr<const CompiledStyle>(const std::string& style_id, std::string* error_message)>;
+
+  explicit StyleCache(std::uint64_t max_size_bytes);
+
+  // Returns the style with the given id, compiling it with |compiler| if it isn't cached. Returns nullptr on failure.
+  std::shared_ptr<const CompiledStyle> Get(const std::string& style_id,
+                                           const Compiler& compiler,
+                                           std::string* error_message);
+
+  void SetMaxSizeBytes(std::uint64_t max_size_bytes);
+  Stats GetStats() const;
+
+ private:
+  struct CompilationResult {
+    std::shared_ptr<const CompiledStyle> style;
+    std::string error_message;
+  };
+
+  struct Entry {
+    std::shared_future<CompilationResult> result;
+    bool is_compiled = false;
+    std::uint64_t size_bytes = 0;
+    // Position in lru_style_ids_, valid once the style is compiled.
+    std::list<std::string>::iterator lru_it;
+  };
+
+  // Should be called under the lock.
+  void TrimToMaxSize();
+
+  mutable std::mutex mtx_;
+  std::uint64_t max_size_bytes_;
+  std::unordered_map<std::string, Entry> entries_;
+  // Ids of compiled styles, the most recently used first.
+  std::list<std::string> lru_style_ids_;
+  Stats stats_;
+};
+
+}  // namespace style_cache
+}  // namespace lightex
@@ -0,0 +1,672 @@
+// Generated by utils/generate_symbol_tables.py, do not edit.
+
+#include <lightex/symbols/symbol_tables.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace lightex {
+namespace symbols {
+namespace {
+
+// FNV-1a with a seeded offset basis, followed by the MurmurHash3 finalizer: the low bits of plain FNV-1a depend on
+// too few input bits for keys this short.
+inline std::uint32_t Hash(const char* data, std::size_t size, std::uint32_t seed) {
+  std::uint32_t hash = 0x811c9dc5u ^ seed;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 0x01000193u;
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+// Hash and displace: the first hash picks a displacement, which is either the seed of the second hash or, if
+// negative, -1 - slot for buckets with a single key.
+template <std::size_t Size>
+std::size_t FindSlot(const std::int32_t (&displacements)[Size], const char* data, std::size_t size) {
+  const std::int32_t displacement = displacements[Hash(data, size, 0) % Size];
+  if (displacement < 0) {
+    return static_cast<std::size_t>(-1 - displacement);
+  }
+  return Hash(data, size, static_cast<std::uint32_t>(displacement)) % Size;
+}
+
+inline bool Equals(const char* key, const char* data, std::size_t size) {
+  return std::strlen(key) == size && std::memcmp(key, data, size) == 0;
+}
+
+const std::int32_t kLookupTableSymbolDisplacements[] = {
+    8, -6, 2, 0, 0, 0,
+};
+const char* const kLookupTableSymbols[] = {
+    "--", "~", ">>", "\\,", "---", "<<",
+};
+const char* const kLookupTableSymbolReplacements[] = {
+    "&ndash;", "&nbsp;", "&raquo;", "&thinsp;", "&mdash;", "&laquo;",
+};
+
+const std::int32_t kHtmlEntityNameDisplacements[] = {
+    0, 0, 1, -2123, 0, -2122, 0, 0, -2118, -2114, -2107, -2106, -2104, 0, 0, 0, -2101, 0, 0, 2, 0, 0, -2096, 1, 0, 4, 1,
+    -2092, 0, 0, 0, 0, -2091, 0, -2089, 0, 0, -2088, -2087, -2082, 0, 0, -2077, 0, 0, 2, 3, -2073, 0, 1, -2072, 0, 0,
+    -2070, 0, 1, 1, 0, 0, 3, -2068, 0, -2066, 0, 1, 0, -2065, -2062, 1, 0, 1, 1, -2060, 0, -2057, 0, 3, 1, 0, -2054,
+    -2052, 0, -2049, -2048, 0, -2046, 0, 0, -2045, 0, 2, 0, 1, -2044, 1, 0, -2038, -2037, -2036, 1, -2035, -2034, 1, 0,
+    0, 2, 2, 2, -2029, -2026, 0, -2025, -2022, 0, 1, 0, 0, 1, 3, 0, 0, -2021, 0, 0, -2019, -2018, -2017, 0, -2012, 0,
+    -2011, 0, -2008, 1, -2007, 1, -2006, 0, 0, 2, -2004, -2000, -1995, 1, 1, 1, -1994, 2, -1993, 2, 0, 0, -1988, -1985,
+    -1984, 0, -1980, 0, 1, -1978, -1977, -1971, 1, -1970, 0, 1, -1969, 3, -1968, 0, 0, -1964, -1962, 1, 0, 0, 3, -1959,
+    0, -1958, -1954, 0, 0, -1949, 1, -1947, -1946, 1, -1944, 2, 0, 0, -1943, 0, -1941, 0, -1939, 2, 1, 1, -1938, 0, 0,
+    -1937, -1936, 1, 0, 1, 0, 1, -1934, 0, 1, 0, -1933, 0, 1, 0, -1932, 2, 0, 1, 3, 0, 0, 0, 0, 5, 0, 7, 0, 1, -1928, 0,
+    -1927, -1924, 0, -1919, -1918, 0, 0, 0, 0, -1916, 0, -1913, 0, -1912, -1909, 0, -1906, 0, -1900, 0, 0, -1898, -1896,
+    0, 2, -1894, 0, 4, -1893, 1, 0, 0, 1, 3, -1888, 0, -1886, 0, 0, -1884, 0, -1880, -1877, 0, -1876, 1, 0, -1874,
+    -1873, 0, 0, 3, -1872, 0, 1, 0, 1, 2, 0, 0, -1868, 0, -1866, 0, -1863, 0, 0, 1, 2, 2, 1, 0, -1861, -1858, 0, 1,
+    -1854, 1, -1852, -1851, -1843, 0, -1842, 0, -1841, 0, 0, 1, 0, 1, 1, -1840, 0, -1839, 4, 0, -1838, 0, 0, 2, 0,
+    -1835, -1834, -1833, -1831, -1829, -1825, 0, 0, 0, -1821, -1812, 0, 0, -1809, -1806, 0, -1801, -1800, -1799, 1, 1,
+    -1793, -1789, 0, -1785, -1780, 0, 0, 0, 0, -1779, -1778, -1776, -1775, -1771, 0, 2, -1768, -1764, 0, -1760, 0, 2, 0,
+    1, -1759, -1758, 0, 0, -1754, 0, -1751, 0, 1, -1750, -1748, 0, 0, -1741, 0, 2, -1738, 0, 6, -1737, 10, 0, 1, 0, 1,
+    2, 1, 1, -1735, -1733, -1731, 2, 0, -1730, 2, 1, 2, 0, 0, 0, 3, 0, -1728, 1, -1727, 0, -1707, 0, -1705, 1, -1702,
+    -1694, -1693, 3, -1691, -1688, 2, 0, -1686, 1, -1683, 1, 3, 0, 0, -1678, 0, -1677, 3, 0, 2, 0, 1, 0, 0, 0, -1674, 0,
+    -1673, -1669, -1668, 0, 1, -1663, 3, -1662, 0, 3, 0, 2, 0, 1, 0, -1658, 1, 1, 0, 1, -1645, 0, 2, 2, -1641, -1640, 2,
+    2, -1639, -1637, 0, -1636, 0, -1635, -1627, -1626, 0, -1623, 0, 0, -1620, 0, 0, -1618, 0, 3, 0, -1614, -1613, 0, 0,
+    0, -1611, 1, 0, -1610, 0, 1, 1, -1607, 2, 7, 0, 1, 5, 0, -1605, 0, -1603, -1599, 0, -1598, -1595, 0, 0, -1592,
+    -1591, -1588, -1579, -1578, 0, 1, 0, 0, 0, -1575, 0, 4, 0, 0, -1571, -1570, -1569, 0, -1567, 0, 0, -1563, 3, -1561,
+    4, 1, 0, 0, -1560, 1, 0, 0, -1558, -1557, -1556, 0, 0, -1555, 1, 1, -1553, 4, 0, -1552, 0, 0, 0, 1, -1551, -1548,
+    -1547, -1539, 1, 0, 0, -1538, -1535, -1531, 5, 8, 3, 1, 0, 0, 0, -1529, 1, 0, 2, -1524, -1522, 1, 1, -1521, 0,
+    -1518, -1516, -1513, 0, 0, 1, -1512, 0, 0, -1509, -1503, -1501, 7, -1498, 0, 0, 2, -1497, -1494, -1493, -1487, 1,
+    -1483, 1, 0, 0, -1482, 0, -1477, 0, -1475, 1, 0, -1473, -1469, 0, 0, -1467, 0, 0, 1, 0, -1461, 0, 0, 0, 3, -1457, 9,
+    6, -1452, 0, 0, 0, 0, 0, 2, -1450, 5, 2, 2, 1, 3, 5, 0, -1445, -1442, 0, 0, 1, 0, 0, -1441, 0, 0, 1, 0, 8, 0, 0,
+    -1436, -1435, 11, -1434, -1433, 2, 2, -1431, 1, -1428, 0, 0, 1, -1427, -1426, 0, -1425, 0, 0, 0, 3, 0, 12, 3, 0,
+    -1424, 1, 0, -1422, 0, 0, -1420, 0, 4, 1, 1, -1417, -1415, -1413, -1412, 3, -1406, -1405, 0, 2, -1402, 1, 1, 0, 6,
+    -1398, -1392, 0, -1391, -1387, 1, 0, -1385, -1383, 0, 0, -1382, 1, -1381, 0, 0, 0, -1378, 1, -1377, 0, 0, 1, 0, 0,
+    -1376, -1370, 3, -1367, -1366, -1364, 3, 3, 0, 1, -1363, 1, 0, 0, -1362, -1358, -1357, 0, -1356, -1355, 0, 0, 0, 0,
+    0, 0, -1341, 1, 0, -1338, 2, -1336, 1, 0, 1, 1, 0, -1335, 0, -1332, 0, 6, 1, 8, -1331, 0, 0, 0, 6, -1330, -1328, 1,
+    3, 2, -1326, -1324, 0, -1323, 0, 0, 0, 2, 0, 0, -1321, 1, 1, -1318, 0, 1, 0, 0, -1316, 0, -1311, 0, -1310, -1308, 1,
+    0, 0, -1307, -1305, 0, 0, 0, 0, -1298, 0, 2, -1297, 0, 1, -1296, 7, -1291, 1, -1288, -1285, -1280, 1, 4, 0, 2, 1, 0,
+    0, -1276, 0, -1275, -1274, 1, 2, -1271, 0, -1270, -1269, 0, -1267, 0, 7, -1266, 1, 0, 0, -1265, 1, 6, -1262, -1259,
+    3, 1, 0, -1257, 0, 3, -1256, 0, 0, -1255, 0, 0, -1254, 0, 0, 0, -1249, 1, 0, -1248, -1246, -1245, 0, -1243, 1,
+    -1241, 0, -1235, 0, 0, 0, 0, 6, -1232, 3, 2, -1227, 0, 0, 0, 4, 3, 0, 0, -1225, -1224, 3, 0, 0, -1220, 3, 0, -1218,
+    0, -1216, 1, 0, -1212, 1, 3, -1210, 1, 5, 5, 0, 4, -1209, 0, 1, 7, 2, -1208, -1205, 0, 0, 2, 5, 0, -1202, -1199,
+    -1196, 1, 1, 2, -1195, -1192, 0, 1, 6, 0, 0, 0, 12, -1190, -1189, -1186, 3, -1177, -1175, -1174, 0, -1170, -1168,
+    -1166, -1165, 0, 16, 0, 0, 0, 2, 0, 0, 0, -1164, 3, -1161, 3, -1149, 1, -1147, -1146, 1, -1145, -1144, -1141, 4,
+    -1140, 0, -1138, 3, -1137, -1135, 3, 0, 2, 1, 0, 0, 0, 0, 1, -1133, 1, 3, 0, -1132, 0, 1, 0, -1131, -1130, 0, 1, 0,
+    -1128, -1127, -1126, 0, -1123, -1116, 0, -1113, -1112, 0, -1110, -1109, -1108, -1107, 0, -1105, 0, 0, 0, 6, 1,
+    -1103, 0, 0, -1101, 0, -1099, 0, -1098, 0, 17, 1, -1090, 0, 0, 0, 1, -1088, 0, 1, -1087, -1086, 2, -1085, 1, 0, 0,
+    2, 0, -1082, 0, -1077, -1075, -1073, 3, 2, 0, 0, -1070, 1, -1069, 0, 0, 0, 0, -1065, 0, 0, 0, 0, 3, -1064, -1060,
+    -1059, -1057, -1056, -1053, 8, -1052, 0, 0, -1050, -1049, 2, -1047, 0, -1041, 0, -1039, -1037, 2, -1035, -1034,
+    -1032, -1030, 0, 0, -1026, 0, 0, 2, -1024, 21, 15, -1022, -1021, 1, -1020, 0, -1014, 0, 0, -1009, -1007, 0, 0, 2,
+    -1005, 0, 0, -999, -996, 0, -993, 0, -986, 7, -984, 0, -980, 0, -978, -973, 0, 2, -969, -965, 8, 2, 0, -962, 0, 0,
+    1, -959, 0, -957, -953, 1, 0, -952, 0, -950, -949, -948, -943, -939, -937, 1, -935, 0, 1, -933, 10, 5, -932, 0, 0,
+    0, 0, -930, -929, -926, 0, 0, 4, -919, -912, 10, 0, -911, 1, 0, 0, 9, 0, 1, 1, 0, -910, -909, 0, 0, 0, 3, 3, -907,
+    -906, 8, -902, -901, 6, -900, -896, 0, -895, 1, 0, 0, 0, 1, -893, 0, 0, -889, -887, 0, 0, -886, -885, -882, -881, 1,
+    -879, 4, -872, -870, 4, 0, 8, 1, 3, -869, 0, 11, 0, 2, 1, 3, 2, -868, 1, -866, -865, -863, 1, 1, 7, 7, 51, 0, -856,
+    1, 1, 0, 7, -853, 2, 0, 0, 1, 4, 0, 1, 1, 3, -852, 0, 0, -850, -845, 4, -839, -835, 7, 0, 0, -833, 1, -832, -831, 0,
+    0, 3, 0, -830, 0, -829, 2, -827, 0, 0, 1, 3, 0, -824, -821, -820, 2, -816, 0, -815, -814, -813, 0, -812, 0, -810,
+    -809, 0, -804, 0, -796, 4, 0, -790, 0, 3, 6, -787, 0, 2, 1, 0, -786, 1, -781, 0, -779, 0, 6, 0, -776, 4, -775, 4, 8,
+    -773, 9, 1, -765, -762, -761, -759, 0, 1, -756, 10, 0, -754, -747, -744, 0, 0, 0, 0, -740, 0, -739, -735, 12, 0, 0,
+    -734, 0, 0, -732, 0, 0, -729, 11, 0, 0, -728, 0, 0, 1, 0, 1, 1, 0, -723, 1, -719, -718, 4, -716, 1, 0, 10, 1, 0, 1,
+    -715, 0, -714, -713, -711, 0, 0, 0, 0, -708, 4, -707, 3, -706, 0, -705, -702, 3, 0, -699, -697, -696, 0, -688, 5,
+    -687, -685, -680, 0, -678, 1, -676, -674, -672, -667, -665, -664, 2, -661, 0, -657, 6, 0, 0, 4, -655, 0, 0, -654, 0,
+    0, 6, 3, -653, -650, -647, 0, -645, 0, -634, 0, 0, 0, 0, 0, 1, 4, 0, 22, 4, 6, 12, 0, 10, 0, 0, -631, -628, 0, 0,
+    -622, 0, 0, -619, -617, 1, -614, 0, 14, 0, 2, 9, 2, 0, -610, 2, -608, 0, 11, -595, 1, 0, 0, 3, 0, 0, 0, 0, 1, -591,
+    2, 0, -590, 2, 0, 1, 9, -589, -583, 0, -582, -579, -569, -568, 0, 0, -566, 2, 4, -565, -562, 2, 4, 1, 2, 1, 10,
+    -561, -560, 1, -559, -558, -557, 0, -554, -553, 1, -549, 0, -548, 0, -547, 1, -543, -539, 0, 1, -537, -535, 0, 0,
+    -534, 0, -529, -527, -526, 0, -524, -522, 1, 0, 0, -519, 0, 0, -513, 1, 9, 0, 65, 0, 3, 0, 0, -510, 1, 0, -507, 1,
+    0, 0, -505, 0, 3, 1, 0, -503, 0, 0, 4, 3, 0, 0, 0, 0, -501, -499, 0, -498, 0, 7, 0, 1, 0, -497, 1, -495, -494, 0,
+    -492, -491, 0, -489, -488, -484, -483, -480, -479, -477, 0, -476, 6, 0, 3, -475, -474, 0, 0, 0, 0, 0, 0, -471, -467,
+    0, 0, -462, -460, 0, -453, 4, -452, 0, -450, -449, 0, 1, 2, 0, -441, 2, 0, 0, 0, 0, -435, -431, 0, -429, 7, 1, 0, 5,
+    -428, 0, 6, 0, -426, 0, 1, -424, -423, -420, 0, -419, 0, -418, -417, 0, -416, -414, 5, 0, 0, -413, 0, -411, -410, 0,
+    0, -409, 1, -402, 0, 1, 3, 5, 14, -398, -397, -389, -385, -380, 10, 1, 0, 3, -378, -375, 1, -369, 0, 6, 1, 0, 2,
+    -367, 4, -365, 0, 2, -363, 0, 0, 0, -356, 12, 0, -354, 0, 0, -343, 5, 0, 5, 0, 0, -336, -334, -333, -332, -331, 0,
+    4, 0, -330, 0, 0, 0, -329, 1, -328, -321, 1, 0, -319, 3, -318, 0, -317, 0, -315, 1, -308, -306, 3, 3, 0, 1, -304, 1,
+    4, -300, -298, -297, 0, 7, -290, -288, 0, -287, -286, 0, -283, 0, 0, 6, -280, -275, 0, 0, -274, -269, 6, 1, 18, 1,
+    0, -266, 0, 7, -265, -262, -258, 0, 0, 0, 0, 0, 0, 11, 1, 8, 0, 1, 1, 11, 0, 1, 0, 0, -256, -254, 0, 2, -253, 2, 1,
+    -251, 4, -250, -249, -248, 3, -247, 0, -245, 1, 67, 17, 0, -241, 6, 0, -236, -227, 1, -224, -223, 0, -221, 1, -220,
+    0, 0, 0, -219, 22, -217, 0, 18, -215, -214, -212, 7, 0, -207, -203, 0, 14, 2, 20, -201, -196, 0, 6, -194, 0, 2, 0,
+    0, 3, -193, -190, 0, -189, 23, -187, 0, 0, 0, -186, -183, -180, 4, 6, 0, -178, 0, 1, 0, 0, 0, 0, -176, -175, 0,
+    -170, 0, 1, 0, -168, 0, 10, -165, 2, -163, 0, 0, 1, 0, 1, 0, -162, 5, 0, -156, 0, 0, 12, -154, -151, -150, 0, 0, 0,
+    -149, 12, -147, -146, 0, 0, 9, 0, 8, -145, 0, -144, 0, 0, 6, 0, 0, -142, 1, 0, -140, 2, -136, 0, 0, 0, -135, 1, 0,
+    0, 0, 0, -133, -129, 0, 0, 11, 0, -127, -124, -123, 0, 3, -121, -119, -115, 0, -111, 0, 0, 4, -104, -99, -97, -94,
+    2, -93, -92, -87, 4, 0, 0, -86, -85, 4, 1, 3, 3, 0, -84, -79, -76, 25, 10, 0, -74, 0, 2, 0, -73, 0, 0, -71, 2, -70,
+    -65, 0, 0, 0, -64, 1, 0, -62, -59, -54, 1, 0, -49, -48, -46, -43, 6, 14, -37, 4, 24, 0, 9, -36, 0, 0, 0, 0, -35, 1,
+    0, 0, -34, 0, 2, 2, -29, 0, 37, 0, -25, 3, 0, 0, 4, -23, 0, -15, 8, -7, 4, -2,
+};
+const char* const kHtmlEntityNames[] = {
+    "raquo", "Vfr", "Hopf", "wedgeq", "NotSucceedsTilde", "varkappa", "lowbar", "bne", "triangleleft", "lmidot",
+    "copysr", "NotTildeFullEqual", "Updownarrow", "topbot", "Cdot", "agrave", "utilde", "leftharpoonup", "boxdl",
+    "Iopf", "LeftDownTeeVector", "nleftrightarrow", "QUOT", "nvHarr", "cuepr", "Zeta", "frac78", "puncsp", "nbump",
+    "grave", "capcup", "succ", "SHCHcy", "les", "lbrkslu", "sqsube", "lates", "models", "vprop", "notnivc", "pm",
+    "angzarr", "ltrie", "DownLeftVector", "gesdotol", "niv", "raemptyv", "Theta", "rcy", "Icirc", "ogon", "Sup",
+    "rightleftharpoons", "frac13", "larrpl", "gimel", "wscr", "angmsdaf", "tshcy", "SquareSubset", "geq", "mcy", "ordf",
+    "nis", "xi", "mnplus", "gtreqless", "boxhu", "sdotb", "ratail", "Cfr", "ncongdot", "larrb", "Barwed", "geqslant",
+    "Larr", "leq", "questeq", "hopf", "phiv", "dcaron", "ldquo", "Uogon", "iiiint", "rfloor", "supsetneq", "omid",
+    "notindot", "boxUL", "darr", "REG", "eogon", "ThickSpace", "there4", "plusdu", "lbrke", "nsucc", "Scaron",
+    "NegativeVeryThinSpace", "cirmid", "capand", "Vcy", "rsqb", "reals", "supe", "strns", "npar", "ldsh",
+    "NotGreaterEqual", "eparsl", "lvnE", "laemptyv", "bNot", "siml", "frac18", "efDot", "vdash", "FilledSmallSquare",
+    "LeftUpVectorBar", "sstarf", "Darr", "sigma", "tstrok", "mapstoleft", "zigrarr", "ominus", "pluse", "Proportional",
+    "ngsim", "rpargt", "bsol", "khcy", "eta", "LowerLeftArrow", "nsimeq", "Eta", "rarrc", "boxdR", "LeftRightArrow",
+    "scnap", "Eopf", "LeftDoubleBracket", "bernou", "nvDash", "yfr", "nabla", "lpar", "jmath", "xoplus",
+    "DoubleLeftRightArrow", "dscy", "NotLess", "smeparsl", "Hat", "ReverseElement", "Cscr", "circ", "mlcp", "nrtri",
+    "sqsub", "late", "female", "curlyeqsucc", "odiv", "boxDl", "emacr", "coprod", "ohbar", "NotLeftTriangle", "ZHcy",
+    "cirE", "piv", "fcy", "eqslantless", "nmid", "ngt", "dharr", "Dot", "rarrfs", "Omega", "Zscr", "gjcy", "Upsi",
+    "UpTee", "mcomma", "lesseqgtr", "Qscr", "hArr", "Abreve", "Equal", "timesd", "Uarrocir", "nltrie", "rarr", "gnE",
+    "roang", "LongLeftRightArrow", "abreve", "simrarr", "Ecaron", "qprime", "lsqb", "nsub", "djcy", "ntgl", "subnE",
+    "CounterClockwiseContourIntegral", "thetav", "risingdotseq", "hfr", "ccupssm", "lsquo", "RightUpVectorBar",
+    "ssetmn", "frac25", "rdquo", "subsub", "GreaterTilde", "nrarrc", "LessSlantEqual", "Hscr", "Ocirc", "tbrk", "ord",
+    "curvearrowleft", "emptyset", "NotElement", "succapprox", "period", "vltri", "bsolb", "lHar", "Dfr", "LessGreater",
+    "marker", "Tcy", "clubsuit", "longmapsto", "blacktriangleright", "emsp13", "larrhk", "DoubleLeftTee", "boxbox",
+    "gtrsim", "searhk", "mDDot", "oscr", "slarr", "iinfin", "prurel", "MediumSpace", "IOcy", "Mfr", "GJcy",
+    "triangleright", "filig", "twixt", "delta", "squ", "scirc", "backcong", "LeftArrowRightArrow", "Uparrow", "lacute",
+    "urcorn", "PrecedesSlantEqual", "nvlArr", "ang", "demptyv", "jcirc", "xvee", "subplus", "xrArr", "in", "cups",
+    "Poincareplane", "bnequiv", "supsim", "Bopf", "subsetneq", "Dstrok", "quest", "sol", "mu", "ssmile", "smile",
+    "swarhk", "Verbar", "Psi", "Umacr", "numsp", "sscr", "propto", "xhArr", "Conint", "quot", "gvertneqq", "trade",
+    "timesbar", "lmoust", "rceil", "Lang", "equiv", "erarr", "eopf", "blk14", "barvee", "circlearrowright", "njcy",
+    "iexcl", "downarrow", "Epsilon", "npr", "NotVerticalBar", "lang", "Ascr", "Longleftarrow", "nLeftrightarrow",
+    "Zopf", "rBarr", "tfr", "HumpEqual", "ngeqq", "lap", "LeftUpTeeVector", "Colone", "pound", "squarf", "nsqsube",
+    "malt", "yacy", "lsimg", "Uring", "ges", "hyphen", "ufr", "tcaron", "simplus", "nwnear", "ange", "nsc", "xnis",
+    "igrave", "Vee", "SOFTcy", "YAcy", "oint", "para", "bigotimes", "blacktriangle", "NotLessEqual", "ugrave", "vnsup",
+    "simgE", "Jsercy", "trpezium", "starf", "OpenCurlyQuote", "equals", "RightDoubleBracket", "Aogon", "lobrk", "Rscr",
+    "UpperRightArrow", "nshortparallel", "supne", "bsolhsub", "gnap", "LeftTeeVector", "uArr", "Lt", "odash", "els",
+    "Iukcy", "NotSucceeds", "gtrarr", "pitchfork", "sopf", "equest", "Oacute", "ohm", "DoubleLongRightArrow", "angsph",
+    "ufisht", "thickapprox", "isinsv", "succsim", "angmsdab", "Gcirc", "ltdot", "uuml", "sube", "apid", "ac",
+    "DiacriticalAcute", "Yuml", "Jukcy", "Square", "rightthreetimes", "rlhar", "uscr", "uring", "Kcy", "scedil",
+    "imped", "nvge", "laquo", "nleqq", "rlm", "Rsh", "ic", "gneq", "acute", "Therefore", "umacr", "lrarr", "nvsim",
+    "nsup", "NegativeThinSpace", "ncaron", "minusdu", "varsigma", "approx", "OverParenthesis", "profline", "nLtv",
+    "gfr", "cwint", "vert", "boxDr", "Topf", "mfr", "ContourIntegral", "gt", "Tscr", "cire", "Re", "downdownarrows",
+    "xrarr", "sqsubseteq", "Emacr", "seArr", "cacute", "angmsdae", "scap", "CapitalDifferentialD", "UpArrow", "upsi",
+    "napid", "isins", "CupCap", "setminus", "dlcorn", "aogon", "sum", "lmoustache", "lrm", "NotGreaterLess", "xcap",
+    "sqsup", "notinva", "Nscr", "Lstrok", "eqcolon", "fscr", "notni", "tdot", "boxminus", "rotimes", "ofcir", "CHcy",
+    "boxhU", "ncong", "vellip", "copy", "lE", "sce", "lnsim", "eqslantgtr", "fpartint", "Assign", "Vvdash", "Lsh",
+    "angmsdah", "wp", "blacksquare", "swarrow", "Sqrt", "harrw", "zeetrf", "Cconint", "varpi", "dagger", "napE", "vscr",
+    "le", "prec", "NotTilde", "RightDownTeeVector", "eng", "DoubleUpArrow", "otilde", "updownarrow", "shcy", "congdot",
+    "LeftTriangle", "nsmid", "UnionPlus", "boxHD", "zeta", "Delta", "Sfr", "cirscir", "NotDoubleVerticalBar", "larr",
+    "mdash", "Dcaron", "Igrave", "Hfr", "dbkarow", "MinusPlus", "nVDash", "Iogon", "scnsim", "rsquo", "CircleMinus",
+    "clubs", "sqsupe", "cedil", "hcirc", "NotTildeEqual", "curvearrowright", "angrtvbd", "Element", "leqq",
+    "LeftTriangleEqual", "trisb", "infin", "frac38", "Iota", "iogon", "gtquest", "inodot", "verbar", "exist",
+    "CirclePlus", "rharu", "nsubseteq", "GreaterEqualLess", "precneqq", "cap", "gel", "Ograve", "rightsquigarrow",
+    "subne", "hamilt", "frac16", "nwarhk", "Yacute", "boxdr", "gopf", "rAarr", "sacute", "Wscr", "mp", "bsime", "udhar",
+    "LeftTee", "Cacute", "circlearrowleft", "scnE", "LeftCeiling", "Gfr", "rarrbfs", "GT", "varpropto", "scE", "mstpos",
+    "NotLessTilde", "precsim", "yicy", "Colon", "curlyeqprec", "cudarrl", "permil", "nequiv", "minus", "awint",
+    "LeftTriangleBar", "LJcy", "Product", "div", "ndash", "lharu", "boxH", "frac58", "shy", "ngE", "zwnj", "ngeqslant",
+    "rarrtl", "eth", "Vscr", "vsubnE", "dotplus", "nVdash", "SubsetEqual", "Ll", "uHar", "nacute", "NotCongruent",
+    "angmsdac", "odsold", "utri", "amp", "leftrightarrows", "hstrok", "LessLess", "lozenge", "nwarrow", "ijlig",
+    "larrbfs", "andand", "rbbrk", "range", "upharpoonleft", "NotRightTriangle", "urcorner", "andv", "ltquest", "erDot",
+    "TSHcy", "times", "Lcaron", "quaternions", "Sub", "plusb", "egsdot", "Oslash", "nsqsupe", "fflig", "supedot",
+    "lnapprox", "luruhar", "LeftAngleBracket", "OverBrace", "iecy", "capcap", "theta", "zfr", "subedot", "gesl",
+    "rightleftarrows", "gnapprox", "midcir", "nprcue", "diamond", "qopf", "ocir", "sbquo", "rhard", "blk12", "xmap",
+    "Mscr", "it", "Zdot", "map", "nLt", "veeeq", "rationals", "Lscr", "subsup", "xscr", "NotSquareSuperset", "ascr",
+    "ImaginaryI", "FilledVerySmallSquare", "Vopf", "scpolint", "ograve", "mumap", "zcaron", "imath", "prap", "Pr",
+    "Alpha", "AMP", "supdot", "frac12", "ltcir", "rbarr", "topf", "profalar", "succnapprox", "sim",
+    "NegativeMediumSpace", "lceil", "Bumpeq", "eacute", "napos", "race", "wreath", "ouml", "lltri", "cupcap", "ltcc",
+    "plustwo", "smt", "gtdot", "aleph", "rnmid", "boxUR", "cscr", "iukcy", "nlsim", "xfr", "lurdshar", "minusb",
+    "Tstrok", "male", "or", "rmoust", "yucy", "lscr", "lEg", "supmult", "bigcap", "lotimes", "nsupE", "lneqq", "micro",
+    "Tfr", "lesges", "xuplus", "circleddash", "gnsim", "ast", "Omacr", "Gcedil", "eg", "supseteq", "nearrow",
+    "looparrowleft", "nge", "hscr", "NotLessSlantEqual", "Cap", "Bernoullis", "thetasym", "xdtri", "nrarrw", "lBarr",
+    "dwangle", "order", "Egrave", "boxHu", "gsim", "iscr", "llcorner", "CircleDot", "sup", "uplus", "subsim", "subdot",
+    "TripleDot", "YUcy", "cfr", "ncup", "simne", "Rang", "natural", "uarr", "ovbar", "npreceq", "auml", "epsi",
+    "mapstoup", "Succeeds", "pluscir", "Utilde", "SquareSubsetEqual", "Udblac", "ntrianglerighteq", "Dashv", "Odblac",
+    "Yfr", "lcedil", "vartriangleright", "el", "bigwedge", "ap", "naturals", "LongRightArrow", "doublebarwedge",
+    "Otimes", "nsubE", "orderof", "ell", "icy", "lessgtr", "Lleftarrow", "rbrke", "UnderBrace", "hearts", "lnap",
+    "UpArrowBar", "oopf", "gtrdot", "xsqcup", "frac45", "langd", "cupor", "Uopf", "NotEqualTilde", "Kopf", "boxvH",
+    "Hcirc", "OverBracket", "ncap", "rmoustache", "dfisht", "circledR", "triangledown", "NoBreak", "VerticalLine", "lt",
+    "vsubne", "ordm", "boxh", "RightTriangleBar", "varsupsetneq", "brvbar", "frac15", "ltri", "mscr", "downharpoonleft",
+    "curarrm", "bbrktbrk", "nopf", "doteq", "hookleftarrow", "prcue", "lhard", "xlarr", "drbkarow", "Jcirc", "bcong",
+    "NotRightTriangleEqual", "mopf", "LeftArrowBar", "succneqq", "Scy", "bnot", "iacute", "DoubleLongLeftArrow",
+    "xharr", "nleq", "yacute", "Downarrow", "RightUpTeeVector", "ge", "csup", "olcross", "Gt", "Not", "epsiv",
+    "planckh", "nsupset", "trie", "rharul", "notnivb", "longrightarrow", "acE", "hercon", "Star", "nfr", "forkv",
+    "nhpar", "capbrcup", "ForAll", "prnap", "subrarr", "therefore", "DoubleDownArrow", "CloseCurlyDoubleQuote", "Escr",
+    "EmptySmallSquare", "gvnE", "softcy", "pfr", "vopf", "succnsim", "Aacute", "lsh", "apacir", "telrec", "bottom",
+    "rx", "subseteq", "nbumpe", "cupcup", "ldca", "not", "InvisibleTimes", "leftharpoondown", "RightTriangle",
+    "straightphi", "af", "NotSubset", "glE", "Phi", "cwconint", "complexes", "nvdash", "cemptyv", "chi",
+    "DownLeftVectorBar", "jsercy", "pointint", "angmsdad", "NotSucceedsSlantEqual", "Zfr", "Icy", "Kappa",
+    "UpEquilibrium", "ThinSpace", "Yscr", "Union", "ropf", "nleqslant", "frac14", "olarr", "omicron", "backprime",
+    "fork", "lesseqqgtr", "twoheadleftarrow", "nvap", "DifferentialD", "Kscr", "ecy", "Mopf", "varrho", "otimesas",
+    "NotSupersetEqual", "parsim", "oror", "phmmat", "lbbrk", "macr", "Sigma", "NotLeftTriangleEqual", "zdot", "Bcy",
+    "DownLeftTeeVector", "Kfr", "andslope", "ffr", "rarrw", "spadesuit", "ifr", "rcub", "apE", "jscr", "maltese",
+    "hardcy", "nle", "ecolon", "boxv", "ruluhar", "Zcy", "phone", "Vdash", "OElig", "hoarr", "ReverseUpEquilibrium",
+    "nsccue", "Mcy", "yuml", "fjlig", "fllig", "NegativeThickSpace", "kscr", "pr", "DD", "xutri", "suphsub",
+    "measuredangle", "NotNestedGreaterGreater", "Rfr", "becaus", "nparsl", "comp", "aelig", "intprod", "cong",
+    "submult", "pcy", "dotminus", "bowtie", "nlt", "half", "olt", "wedge", "vcy", "gesdot", "RightVector", "Tab",
+    "ntrianglelefteq", "spar", "acirc", "downharpoonright", "Wfr", "checkmark", "Rightarrow", "lesdotor",
+    "ExponentialE", "fnof", "nisd", "lne", "simeq", "Gscr", "sup3", "rthree", "amalg", "tau", "otimes", "Ffr", "cupdot",
+    "LeftUpVector", "langle", "nsime", "frac35", "boxhD", "DownBreve", "gcirc", "boxDL", "blank", "DoubleRightArrow",
+    "wopf", "Ccirc", "HARDcy", "isinv", "Cup", "hairsp", "lesdot", "npart", "NotGreaterFullEqual", "pertenk", "nrarr",
+    "mldr", "longleftrightarrow", "Atilde", "sharp", "Itilde", "digamma", "uhblk", "doteqdot", "precapprox",
+    "LessFullEqual", "NotPrecedesEqual", "Ifr", "comma", "curlyvee", "qint", "nearhk", "prop", "vrtri", "circledcirc",
+    "Uarr", "deg", "backsim", "caron", "HilbertSpace", "cularrp", "boxVR", "ShortUpArrow", "Vdashl", "num", "Gbreve",
+    "percnt", "szlig", "gtlPar", "gescc", "zwj", "pre", "RightArrowBar", "nvle", "rtimes", "NotSubsetEqual",
+    "varsubsetneqq", "Iuml", "integers", "veebar", "Idot", "nbsp", "vsupne", "between", "Intersection", "nlArr",
+    "dashv", "Barv", "wcirc", "SuchThat", "cuvee", "bdquo", "rHar", "Qfr", "rbrace", "Fcy", "OverBar", "NotLessGreater",
+    "RightArrow", "aring", "frac34", "kappa", "lrhard", "DownTeeArrow", "Congruent", "diam", "NotGreaterGreater",
+    "vnsub", "psi", "angmsdag", "cudarrr", "approxeq", "RightDownVectorBar", "Ncy", "centerdot", "iiint", "plussim",
+    "ngtr", "ulcrop", "varepsilon", "ltimes", "bump", "ubreve", "boxVH", "sup1", "vDash", "ncedil", "imof",
+    "RightCeiling", "rarrpl", "esim", "circledast", "operp", "Fouriertrf", "Ufr", "GreaterLess", "topfork", "aacute",
+    "tscr", "rsh", "ii", "circledS", "VerticalTilde", "boxplus", "nsupe", "twoheadrightarrow", "ecirc", "smallsetminus",
+    "preceq", "ucirc", "Fscr", "acy", "Kcedil", "afr", "prnE", "ocirc", "DoubleRightTee", "dtri", "lsime", "mid",
+    "rarrb", "varsupsetneqq", "hbar", "angmsd", "nedot", "block", "Lcy", "wedbar", "curren", "perp", "squf", "Pfr",
+    "boxvr", "NotSquareSubset", "ltrif", "dot", "lessdot", "xwedge", "vBarv", "lneq", "frown", "ensp", "int",
+    "NotCupCap", "nvlt", "Uuml", "cdot", "tscy", "epsilon", "NotLessLess", "dlcrop", "planck", "Longrightarrow", "dArr",
+    "jfr", "iprod", "orslope", "dharl", "efr", "GreaterSlantEqual", "nlarr", "supE", "Ubreve", "NotPrecedes",
+    "HumpDownHump", "lthree", "uopf", "bepsi", "Backslash", "Jscr", "lAtail", "swarr", "image", "ENG", "LeftTeeArrow",
+    "DotEqual", "upharpoonright", "TildeFullEqual", "vee", "Dopf", "and", "lrtri", "Tilde", "breve", "supsub", "amacr",
+    "escr", "Eogon", "Ugrave", "loarr", "par", "bemptyv", "divide", "Acirc", "LeftFloor", "ddarr", "Ofr", "oast",
+    "prsim", "PrecedesTilde", "nsim", "Ecy", "notniva", "wr", "NotSucceedsEqual", "NestedGreaterGreater", "nsce",
+    "jukcy", "hybull", "lg", "sfr", "eDDot", "nges", "Dscr", "srarr", "bumpe", "lessapprox", "Popf", "intlarhk",
+    "horbar", "urcrop", "ring", "nu", "Gamma", "egs", "ZeroWidthSpace", "lrhar", "swnwar", "kcedil", "rbrkslu",
+    "Integral", "Lambda", "nexist", "boxVL", "nshortmid", "prnsim", "OpenCurlyDoubleQuote", "nless", "SupersetEqual",
+    "Coproduct", "bot", "tprime", "bigsqcup", "RightFloor", "lopf", "lparlt", "emptyv", "Beta", "Ecirc", "DZcy",
+    "mapsto", "Implies", "nsucceq", "ncy", "bsemi", "Hacek", "Pi", "copf", "gE", "subE", "bigtriangleup", "lfloor",
+    "supseteqq", "DDotrahd", "rtrif", "utdot", "KJcy", "RBarr", "tritime", "prime", "eDot", "And", "bumpE", "nvgt",
+    "divideontimes", "ape", "InvisibleComma", "Zacute", "uharl", "Ycirc", "Gopf", "thksim", "roarr", "hellip",
+    "DownArrowUpArrow", "ntlg", "ocy", "Oscr", "Rho", "LeftDownVectorBar", "glj", "kjcy", "Gg", "leqslant",
+    "longleftarrow", "RuleDelayed", "Jopf", "npolint", "osol", "larrsim", "gg", "supsetneqq", "ne", "cuwed", "plus",
+    "kgreen", "part", "VerticalSeparator", "dstrok", "Edot", "sung", "UnderBracket", "nesim", "alefsym", "ljcy", "ofr",
+    "smashp", "diams", "iiota", "Xfr", "Vert", "DownTee", "Iacute", "hkswarow", "nexists", "popf", "rarrlp",
+    "RightTriangleEqual", "Imacr", "LeftUpDownVector", "lAarr", "dotsquare", "rarrhk", "ApplyFunction", "rArr",
+    "seswar", "preccurlyeq", "cylcty", "flat", "middot", "Wcirc", "edot", "rcedil", "midast", "boxur", "boxHU",
+    "multimap", "divonx", "Zcaron", "nspar", "rightharpoonup", "notinvc", "roplus", "Ccedil", "conint", "VDash",
+    "Lmidot", "CloseCurlyQuote", "ubrcy", "fltns", "NotSquareSupersetEqual", "Bfr", "Agrave", "NotHumpEqual", "lozf",
+    "npre", "NotSuperset", "DotDot", "nparallel", "napprox", "sqsupset", "nltri", "lopar", "Ntilde", "bigcirc",
+    "rarrsim", "rightarrow", "sext", "LongLeftArrow", "ultri", "latail", "supsup", "Euml", "bigtriangledown", "icirc",
+    "bigstar", "bumpeq", "empty", "shortparallel", "natur", "pscr", "cupbrcap", "vzigzag", "lambda", "Cayleys", "robrk",
+    "Rcedil", "gtrless", "nrightarrow", "tcedil", "Upsilon", "ulcorner", "NotPrecedesSlantEqual", "leftleftarrows",
+    "radic", "smid", "Vbar", "xodot", "ldrdhar", "UpperLeftArrow", "rang", "gEl", "realine", "lsquor", "crarr",
+    "gacute", "gbreve", "scsim", "triangleq", "blacktriangleleft", "boxVl", "vangrt", "rightrightarrows", "nLl",
+    "profsurf", "iquest", "ldrushar", "NotNestedLessLess", "semi", "timesb", "because", "sccue", "RightTeeArrow",
+    "utrif", "bigcup", "Omicron", "homtht", "subset", "vartheta", "boxhd", "sime", "Laplacetrf", "UnderBar",
+    "gtreqqless", "harr", "rtri", "prE", "rsquor", "nharr", "eqsim", "egrave", "RightUpDownVector", "rppolint", "Nu",
+    "Gammad", "Ccaron", "Iscr", "dblac", "NewLine", "iocy", "ltrPar", "Ucirc", "HorizontalLine", "setmn", "lbarr",
+    "star", "Amacr", "Ubrcy", "DoubleDot", "curarr", "RightAngleBracket", "looparrowright", "bsim", "nvrArr", "dtrif",
+    "sigmaf", "mho", "SquareIntersection", "tosa", "supplus", "boxvL", "Tcaron", "Sum", "gtrapprox", "supnE",
+    "DownArrowBar", "lesg", "gsiml", "lbrace", "LessEqualGreater", "eplus", "rpar", "easter", "nsubseteqq", "succeq",
+    "xlArr", "trianglelefteq", "swArr", "vArr", "LeftDownVector", "gneqq", "geqq", "imacr", "sqcaps", "xcirc", "racute",
+    "DownRightVectorBar", "AElig", "DiacriticalGrave", "compfn", "expectation", "emsp14", "hksearow", "dtdot", "aopf",
+    "daleth", "zacute", "quatint", "SHcy", "Lcedil", "KHcy", "Qopf", "emsp", "Chi", "triminus", "fopf", "rrarr",
+    "lbrack", "Racute", "ee", "vBar", "VeryThinSpace", "tridot", "rdsh", "nprec", "esdot", "llarr", "loang", "suplarr",
+    "rfisht", "caret", "LeftRightVector", "loplus", "ShortDownArrow", "nlE", "NotLeftTriangleBar", "Cross", "ffilig",
+    "dash", "isindot", "Int", "scy", "Breve", "shortmid", "prod", "Supset", "TRADE", "Because", "equivDD", "oline",
+    "Nfr", "suphsol", "LeftArrow", "ntilde", "bullet", "sqcup", "uparrow", "zopf", "rdca", "Sopf", "boxUr",
+    "NotGreaterSlantEqual", "boxvl", "ccedil", "Proportion", "commat", "oelig", "ni", "coloneq", "Uacute",
+    "RightDownVector", "lesssim", "GreaterEqual", "EqualTilde", "DownRightTeeVector", "curlywedge", "Otilde", "rscr",
+    "nvinfin", "dollar", "Scedil", "Dagger", "SucceedsTilde", "primes", "dscr", "itilde", "ccaron", "boxHd",
+    "fallingdotseq", "Or", "searrow", "Ncedil", "phi", "rlarr", "qscr", "eqcirc", "iff", "ogt", "nwArr", "nang", "lArr",
+    "Rarr", "backsimeq", "Equilibrium", "ccaps", "NotReverseElement", "uwangle", "SucceedsEqual", "Gcy", "cup",
+    "ecaron", "smtes", "parallel", "acd", "Precedes", "circeq", "target", "boxvR", "dHar", "NJcy",
+    "DoubleLongLeftRightArrow", "Cedilla", "lhblk", "opar", "bprime", "nrArr", "sigmav", "complement", "omega", "lfr",
+    "nap", "larrtl", "colon", "Diamond", "frac56", "rho", "TScy", "asympeq", "realpart", "euro", "nsubset", "atilde",
+    "bfr", "Uscr", "Wopf", "cuesc", "upuparrows", "Tau", "ddotseq", "elinters", "Esim", "sect", "Rrightarrow", "lat",
+    "PrecedesEqual", "bigoplus", "eqvparsl", "nles", "uml", "Del", "orv", "leftrightarrow", "olcir", "ntriangleleft",
+    "euml", "solb", "udarr", "orarr", "EmptyVerySmallSquare", "tilde", "rightharpoondown", "frac23", "leftarrowtail",
+    "ulcorn", "isinE", "gla", "awconint", "Map", "Superset", "dopf", "DiacriticalDoubleAcute", "plusacir", "Acy",
+    "backepsilon", "loz", "gesdoto", "NotHumpDownHump", "VerticalBar", "rbrksld", "nvltrie", "imagline",
+    "NestedLessLess", "DownRightVector", "LeftVectorBar", "numero", "ccups", "imagpart", "NotTildeTilde", "ycirc",
+    "Auml", "lgE", "ggg", "heartsuit", "rangle", "tint", "jopf", "RightArrowLeftArrow", "Rcaron", "Yopf", "angst",
+    "rfr", "lcub", "udblac", "cularr", "duarr", "GreaterGreater", "ecir", "barwedge", "precnsim", "rangd", "kcy",
+    "gdot", "larrfs", "Mu", "TildeEqual", "vfr", "Lacute", "Leftarrow", "cent", "yopf", "Exists", "Fopf", "parsl",
+    "leftrightsquigarrow", "nLeftarrow", "rtrie", "lesdoto", "PlusMinus", "UpDownArrow", "DoubleUpDownArrow", "intcal",
+    "ratio", "lsaquo", "Xopf", "RightUpVector", "plankv", "ll", "rAtail", "Longleftrightarrow", "bopf", "Eacute",
+    "varphi", "nrtrie", "Sscr", "kopf", "nsupseteqq", "Sc", "smte", "TildeTilde", "nsupseteq", "Im", "UpTeeArrow",
+    "chcy", "csub", "bkarow", "NotSquareSubsetEqual", "csube", "oS", "gtcir", "scaron", "shchcy", "leg", "reg", "angle",
+    "ETH", "andd", "boxVr", "nGt", "sqcups", "rsaquo", "rdquor", "nGg", "Jfr", "CenterDot", "dcy", "notinE", "pi",
+    "exponentiale", "lagran", "zscr", "ffllig", "duhar", "ddagger", "upsilon", "gsime", "xotime", "drcrop", "weierp",
+    "bscr", "lsim", "CircleTimes", "beta", "capdot", "varr", "Sacute", "boxdL", "beth", "boxvh", "upsih", "precnapprox",
+    "simdot", "xopf", "Copf", "notinvb", "lrcorner", "IEcy", "gamma", "gscr", "check", "oplus", "mapstodown", "blk34",
+    "nscr", "NonBreakingSpace", "RoundImplies", "jcy", "Aopf", "yen", "NotGreater", "cir", "nesear", "triangle", "Ucy",
+    "DScy", "searr", "varsubsetneq", "sc", "odblac", "uuarr", "ltlarr", "thicksim", "lowast", "uogon", "Tcedil",
+    "boxuL", "toea", "simlE", "origof", "sqcap", "nwarr", "larrlp", "sup2", "rect", "boxDR", "DJcy", "rbrack", "odot",
+    "boxul", "nearr", "Subset", "LessTilde", "gtcc", "straightepsilon", "Efr", "UpArrowDownArrow", "excl", "NotEqual",
+    "Xi", "thorn", "rarrap", "IJlig", "DoubleVerticalBar", "rdldhar", "sdote", "vartriangleleft", "Pscr", "llhard",
+    "boxVh", "DownLeftRightVector", "varnothing", "uacute", "nldr", "COPY", "urtri", "Jcy", "yscr", "oslash", "triplus",
+    "infintie", "ycy", "xcup", "omacr", "oacute", "YIcy", "thkap", "Xscr", "epar", "bcy", "subsetneqq",
+    "LowerRightArrow", "blacktriangledown", "PartialD", "notin", "colone", "lstrok", "GreaterFullEqual", "square",
+    "ClockwiseContourIntegral", "biguplus", "Rarrtl", "nRightarrow", "plusmn", "harrcir", "kappav", "Bscr", "Ropf",
+    "forall", "sub", "lfisht", "nleftarrow", "top", "leftrightharpoons", "cirfnint", "DiacriticalDot", "spades", "ucy",
+    "RightTeeVector", "disin", "leftarrow", "caps", "THORN", "Leftrightarrow", "SquareSuperset", "qfr", "rcaron",
+    "real", "bigodot", "lnE", "dfr", "Lopf", "SquareSupersetEqual", "alpha", "SucceedsSlantEqual", "topcir", "cross",
+    "succcurlyeq", "dsol", "uharr", "sqsupseteq", "bbrk", "incare", "angrtvb", "DownArrow", "Nacute", "boxV", "Ycy",
+    "drcorn", "angmsdaa", "Wedge", "LT", "Ocy", "DoubleContourIntegral", "trianglerighteq", "lcaron", "ShortLeftArrow",
+    "tcy", "iuml", "nhArr", "ldquor", "Pcy", "ngeq", "SquareUnion", "Lfr", "diamondsuit", "sfrown", "RightVectorBar",
+    "ReverseEquilibrium", "nsube", "vsupnE", "angrt", "dzigrarr", "ShortRightArrow", "apos", "boxtimes",
+    "hookrightarrow", "lvertneqq", "sdot", "NotGreaterTilde", "ccirc", "rtriltri", "Mellintrf", "DoubleLeftArrow",
+    "Dcy", "Scirc", "iopf", "kfr", "DiacriticalTilde", "iota", "SmallCircle", "csupe", "plusdo", "supdsub", "bigvee",
+    "Prime", "UnderParenthesis", "die", "solbar", "gap", "Rcy", "dzcy", "asymp", "hslash", "lharul", "NotExists",
+    "leftthreetimes", "zcy", "lcy", "gne", "gl", "ctdot", "rightarrowtail", "gammad", "intercal", "Ncaron", "Gdot",
+    "dd", "gesles", "isin", "boxuR", "Afr", "boxUl", "ntriangleright", "ropar", "neArr", "nGtv", "lbrksld", "zhcy",
+    "blacklozenge", "Nopf", "bull", "Ouml", "minusd", "Oopf", "sqsubset", "RightTee", "rhov", "nvrtrie", "Hstrok",
+    "subseteqq", "thinsp", "wfr", "LeftVector", "Aring", "barwed", "simg", "NotRightTriangleBar", "elsdot", "supset",
+    "lescc", "gcy", "frasl",
+};
+const char* const kHtmlEntityCharacters[] = {
+    "\302\273", "\360\235\224\231", "\342\204\215", "\342\211\231", "\342\211\277\314\270", "\317\260", "_",
+    "=\342\203\245", "\342\227\203", "\305\200", "\342\204\227", "\342\211\207", "\342\207\225", "\342\214\266",
+    "\304\212", "\303\240", "\305\251", "\342\206\274", "\342\224\220", "\360\235\225\200", "\342\245\241",
+    "\342\206\256", "\"", "\342\244\204", "\342\213\236", "\316\226", "\342\205\236", "\342\200\210",
+    "\342\211\216\314\270", "`", "\342\251\207", "\342\211\273", "\320\251", "\342\251\275", "\342\246\215",
+    "\342\212\221", "\342\252\255\357\270\200", "\342\212\247", "\342\210\235", "\342\213\275", "\302\261",
+    "\342\215\274", "\342\212\264", "\342\206\275", "\342\252\204", "\342\210\213", "\342\246\263", "\316\230",
+    "\321\200", "\303\216", "\313\233", "\342\213\221", "\342\207\214", "\342\205\223", "\342\244\271", "\342\204\267",
+    "\360\235\223\214", "\342\246\255", "\321\233", "\342\212\217", "\342\211\245", "\320\274", "\302\252",
+    "\342\213\274", "\316\276", "\342\210\223", "\342\213\233", "\342\224\264", "\342\212\241", "\342\244\232",
+    "\342\204\255", "\342\251\255\314\270", "\342\207\244", "\342\214\206", "\342\251\276", "\342\206\236",
+    "\342\211\244", "\342\211\237", "\360\235\225\231", "\317\225", "\304\217", "\342\200\234", "\305\262",
+    "\342\250\214", "\342\214\213", "\342\212\213", "\342\246\266", "\342\213\265\314\270", "\342\225\235",
+    "\342\206\223", "\302\256", "\304\231", "\342\201\237\342\200\212", "\342\210\264", "\342\250\245", "\342\246\213",
+    "\342\212\201", "\305\240", "\342\200\213", "\342\253\257", "\342\251\204", "\320\222", "]", "\342\204\235",
+    "\342\212\207", "\302\257", "\342\210\246", "\342\206\262", "\342\211\261", "\342\247\243",
+    "\342\211\250\357\270\200", "\342\246\264", "\342\253\255", "\342\252\235", "\342\205\233", "\342\211\222",
+    "\342\212\242", "\342\227\274", "\342\245\230", "\342\213\206", "\342\206\241", "\317\203", "\305\247",
+    "\342\206\244", "\342\207\235", "\342\212\226", "\342\251\262", "\342\210\235", "\342\211\265", "\342\246\224",
+    "\\", "\321\205", "\316\267", "\342\206\231", "\342\211\204", "\316\227", "\342\244\263", "\342\225\222",
+    "\342\206\224", "\342\252\272", "\360\235\224\274", "\342\237\246", "\342\204\254", "\342\212\255",
+    "\360\235\224\266", "\342\210\207", "(", "\310\267", "\342\250\201", "\342\207\224", "\321\225", "\342\211\256",
+    "\342\247\244", "^", "\342\210\213", "\360\235\222\236", "\313\206", "\342\253\233", "\342\213\253", "\342\212\217",
+    "\342\252\255", "\342\231\200", "\342\213\237", "\342\250\270", "\342\225\226", "\304\223", "\342\210\220",
+    "\342\246\265", "\342\213\252", "\320\226", "\342\247\203", "\317\226", "\321\204", "\342\252\225", "\342\210\244",
+    "\342\211\257", "\342\207\202", "\302\250", "\342\244\236", "\316\251", "\360\235\222\265", "\321\223", "\317\222",
+    "\342\212\245", "\342\250\251", "\342\213\232", "\360\235\222\254", "\342\207\224", "\304\202", "\342\251\265",
+    "\342\250\260", "\342\245\211", "\342\213\254", "\342\206\222", "\342\211\251", "\342\237\255", "\342\237\267",
+    "\304\203", "\342\245\262", "\304\232", "\342\201\227", "[", "\342\212\204", "\321\222", "\342\211\271",
+    "\342\253\213", "\342\210\263", "\317\221", "\342\211\223", "\360\235\224\245", "\342\251\220", "\342\200\230",
+    "\342\245\224", "\342\210\226", "\342\205\226", "\342\200\235", "\342\253\225", "\342\211\263",
+    "\342\244\263\314\270", "\342\251\275", "\342\204\213", "\303\224", "\342\216\264", "\342\251\235", "\342\206\266",
+    "\342\210\205", "\342\210\211", "\342\252\270", ".", "\342\212\262", "\342\247\205", "\342\245\242",
+    "\360\235\224\207", "\342\211\266", "\342\226\256", "\320\242", "\342\231\243", "\342\237\274", "\342\226\270",
+    "\342\200\204", "\342\206\251", "\342\253\244", "\342\247\211", "\342\211\263", "\342\244\245", "\342\210\272",
+    "\342\204\264", "\342\206\220", "\342\247\234", "\342\212\260", "\342\201\237", "\320\201", "\360\235\224\220",
+    "\320\203", "\342\226\271", "\357\254\201", "\342\211\254", "\316\264", "\342\226\241", "\305\235", "\342\211\214",
+    "\342\207\206", "\342\207\221", "\304\272", "\342\214\235", "\342\211\274", "\342\244\202", "\342\210\240",
+    "\342\246\261", "\304\265", "\342\213\201", "\342\252\277", "\342\237\271", "\342\210\210",
+    "\342\210\252\357\270\200", "\342\204\214", "\342\211\241\342\203\245", "\342\253\210", "\360\235\224\271",
+    "\342\212\212", "\304\220", "?", "/", "\316\274", "\342\214\243", "\342\214\243", "\342\244\246", "\342\200\226",
+    "\316\250", "\305\252", "\342\200\207", "\360\235\223\210", "\342\210\235", "\342\237\272", "\342\210\257", "\"",
+    "\342\211\251\357\270\200", "\342\204\242", "\342\250\261", "\342\216\260", "\342\214\211", "\342\237\252",
+    "\342\211\241", "\342\245\261", "\360\235\225\226", "\342\226\221", "\342\212\275", "\342\206\273", "\321\232",
+    "\302\241", "\342\206\223", "\316\225", "\342\212\200", "\342\210\244", "\342\237\250", "\360\235\222\234",
+    "\342\237\270", "\342\207\216", "\342\204\244", "\342\244\217", "\360\235\224\261", "\342\211\217",
+    "\342\211\247\314\270", "\342\252\205", "\342\245\240", "\342\251\264", "\302\243", "\342\226\252", "\342\213\242",
+    "\342\234\240", "\321\217", "\342\252\217", "\305\256", "\342\251\276", "\342\200\220", "\360\235\224\262",
+    "\305\245", "\342\250\244", "\342\244\247", "\342\246\244", "\342\212\201", "\342\213\273", "\303\254",
+    "\342\213\201", "\320\254", "\320\257", "\342\210\256", "\302\266", "\342\250\202", "\342\226\264", "\342\211\260",
+    "\303\271", "\342\212\203\342\203\222", "\342\252\240", "\320\210", "\342\217\242", "\342\230\205", "\342\200\230",
+    "=", "\342\237\247", "\304\204", "\342\237\246", "\342\204\233", "\342\206\227", "\342\210\246", "\342\212\213",
+    "\342\237\210", "\342\252\212", "\342\245\232", "\342\207\221", "\342\211\252", "\342\212\235", "\342\252\225",
+    "\320\206", "\342\212\201", "\342\245\270", "\342\213\224", "\360\235\225\244", "\342\211\237", "\303\223",
+    "\316\251", "\342\237\271", "\342\210\242", "\342\245\276", "\342\211\210", "\342\213\263", "\342\211\277",
+    "\342\246\251", "\304\234", "\342\213\226", "\303\274", "\342\212\206", "\342\211\213", "\342\210\276", "\302\264",
+    "\305\270", "\320\204", "\342\226\241", "\342\213\214", "\342\207\214", "\360\235\223\212", "\305\257", "\320\232",
+    "\305\237", "\306\265", "\342\211\245\342\203\222", "\302\253", "\342\211\246\314\270", "\342\200\217",
+    "\342\206\261", "\342\201\243", "\342\252\210", "\302\264", "\342\210\264", "\305\253", "\342\207\206",
+    "\342\210\274\342\203\222", "\342\212\205", "\342\200\213", "\305\210", "\342\250\252", "\317\202", "\342\211\210",
+    "\342\217\234", "\342\214\222", "\342\211\252\314\270", "\360\235\224\244", "\342\210\261", "|", "\342\225\223",
+    "\360\235\225\213", "\360\235\224\252", "\342\210\256", ">", "\360\235\222\257", "\342\211\227", "\342\204\234",
+    "\342\207\212", "\342\237\266", "\342\212\221", "\304\222", "\342\207\230", "\304\207", "\342\246\254",
+    "\342\252\270", "\342\205\205", "\342\206\221", "\317\205", "\342\211\213\314\270", "\342\213\264", "\342\211\215",
+    "\342\210\226", "\342\214\236", "\304\205", "\342\210\221", "\342\216\260", "\342\200\216", "\342\211\271",
+    "\342\213\202", "\342\212\220", "\342\210\211", "\360\235\222\251", "\305\201", "\342\211\225", "\360\235\222\273",
+    "\342\210\214", "\342\203\233", "\342\212\237", "\342\250\265", "\342\246\277", "\320\247", "\342\225\250",
+    "\342\211\207", "\342\213\256", "\302\251", "\342\211\246", "\342\252\260", "\342\213\246", "\342\252\226",
+    "\342\250\215", "\342\211\224", "\342\212\252", "\342\206\260", "\342\246\257", "\342\204\230", "\342\226\252",
+    "\342\206\231", "\342\210\232", "\342\206\255", "\342\204\250", "\342\210\260", "\317\226", "\342\200\240",
+    "\342\251\260\314\270", "\360\235\223\213", "\342\211\244", "\342\211\272", "\342\211\201", "\342\245\235",
+    "\305\213", "\342\207\221", "\303\265", "\342\206\225", "\321\210", "\342\251\255", "\342\212\262", "\342\210\244",
+    "\342\212\216", "\342\225\246", "\316\266", "\316\224", "\360\235\224\226", "\342\247\202", "\342\210\246",
+    "\342\206\220", "\342\200\224", "\304\216", "\303\214", "\342\204\214", "\342\244\217", "\342\210\223",
+    "\342\212\257", "\304\256", "\342\213\251", "\342\200\231", "\342\212\226", "\342\231\243", "\342\212\222",
+    "\302\270", "\304\245", "\342\211\204", "\342\206\267", "\342\246\235", "\342\210\210", "\342\211\246",
+    "\342\212\264", "\342\247\215", "\342\210\236", "\342\205\234", "\316\231", "\304\257", "\342\251\274", "\304\261",
+    "|", "\342\210\203", "\342\212\225", "\342\207\200", "\342\212\210", "\342\213\233", "\342\252\265", "\342\210\251",
+    "\342\213\233", "\303\222", "\342\206\235", "\342\212\212", "\342\204\213", "\342\205\231", "\342\244\243",
+    "\303\235", "\342\224\214", "\360\235\225\230", "\342\207\233", "\305\233", "\360\235\222\262", "\342\210\223",
+    "\342\213\215", "\342\245\256", "\342\212\243", "\304\206", "\342\206\272", "\342\252\266", "\342\214\210",
+    "\360\235\224\212", "\342\244\240", ">", "\342\210\235", "\342\252\264", "\342\210\276", "\342\211\264",
+    "\342\211\276", "\321\227", "\342\210\267", "\342\213\236", "\342\244\270", "\342\200\260", "\342\211\242",
+    "\342\210\222", "\342\250\221", "\342\247\217", "\320\211", "\342\210\217", "\303\267", "\342\200\223",
+    "\342\206\274", "\342\225\220", "\342\205\235", "\302\255", "\342\211\247\314\270", "\342\200\214",
+    "\342\251\276\314\270", "\342\206\243", "\303\260", "\360\235\222\261", "\342\253\213\357\270\200", "\342\210\224",
+    "\342\212\256", "\342\212\206", "\342\213\230", "\342\245\243", "\305\204", "\342\211\242", "\342\246\252",
+    "\342\246\274", "\342\226\265", "&", "\342\207\206", "\304\247", "\342\252\241", "\342\227\212", "\342\206\226",
+    "\304\263", "\342\244\237", "\342\251\225", "\342\235\263", "\342\246\245", "\342\206\277", "\342\213\253",
+    "\342\214\235", "\342\251\232", "\342\251\273", "\342\211\223", "\320\213", "\303\227", "\304\275", "\342\204\215",
+    "\342\213\220", "\342\212\236", "\342\252\230", "\303\230", "\342\213\243", "\357\254\200", "\342\253\204",
+    "\342\252\211", "\342\245\246", "\342\237\250", "\342\217\236", "\320\265", "\342\251\213", "\316\270",
+    "\360\235\224\267", "\342\253\203", "\342\213\233\357\270\200", "\342\207\204", "\342\252\212", "\342\253\260",
+    "\342\213\240", "\342\213\204", "\360\235\225\242", "\342\212\232", "\342\200\232", "\342\207\201", "\342\226\222",
+    "\342\237\274", "\342\204\263", "\342\201\242", "\305\273", "\342\206\246", "\342\211\252\342\203\222",
+    "\342\211\232", "\342\204\232", "\342\204\222", "\342\253\223", "\360\235\223\215", "\342\212\220\314\270",
+    "\360\235\222\266", "\342\205\210", "\342\226\252", "\360\235\225\215", "\342\250\223", "\303\262", "\342\212\270",
+    "\305\276", "\304\261", "\342\252\267", "\342\252\273", "\316\221", "&", "\342\252\276", "\302\275", "\342\251\271",
+    "\342\244\215", "\360\235\225\245", "\342\214\256", "\342\252\272", "\342\210\274", "\342\200\213", "\342\214\210",
+    "\342\211\216", "\303\251", "\305\211", "\342\210\275\314\261", "\342\211\200", "\303\266", "\342\227\272",
+    "\342\251\206", "\342\252\246", "\342\250\247", "\342\252\252", "\342\213\227", "\342\204\265", "\342\253\256",
+    "\342\225\232", "\360\235\222\270", "\321\226", "\342\211\264", "\360\235\224\265", "\342\245\212", "\342\212\237",
+    "\305\246", "\342\231\202", "\342\210\250", "\342\216\261", "\321\216", "\360\235\223\201", "\342\252\213",
+    "\342\253\202", "\342\213\202", "\342\250\264", "\342\253\206\314\270", "\342\211\250", "\302\265",
+    "\360\235\224\227", "\342\252\223", "\342\250\204", "\342\212\235", "\342\213\247", "*", "\305\214", "\304\242",
+    "\342\252\232", "\342\212\207", "\342\206\227", "\342\206\253", "\342\211\261", "\360\235\222\275",
+    "\342\251\275\314\270", "\342\213\222", "\342\204\254", "\317\221", "\342\226\275", "\342\206\235\314\270",
+    "\342\244\216", "\342\246\246", "\342\204\264", "\303\210", "\342\225\247", "\342\211\263", "\360\235\222\276",
+    "\342\214\236", "\342\212\231", "\342\212\203", "\342\212\216", "\342\253\207", "\342\252\275", "\342\203\233",
+    "\320\256", "\360\235\224\240", "\342\251\202", "\342\211\206", "\342\237\253", "\342\231\256", "\342\206\221",
+    "\342\214\275", "\342\252\257\314\270", "\303\244", "\316\265", "\342\206\245", "\342\211\273", "\342\250\242",
+    "\305\250", "\342\212\221", "\305\260", "\342\213\255", "\342\253\244", "\305\220", "\360\235\224\234", "\304\274",
+    "\342\212\263", "\342\252\231", "\342\213\200", "\342\211\210", "\342\204\225", "\342\237\266", "\342\214\206",
+    "\342\250\267", "\342\253\205\314\270", "\342\204\264", "\342\204\223", "\320\270", "\342\211\266", "\342\207\232",
+    "\342\246\214", "\342\217\237", "\342\231\245", "\342\252\211", "\342\244\222", "\360\235\225\240", "\342\213\227",
+    "\342\250\206", "\342\205\230", "\342\246\221", "\342\251\205", "\360\235\225\214", "\342\211\202\314\270",
+    "\360\235\225\202", "\342\225\252", "\304\244", "\342\216\264", "\342\251\203", "\342\216\261", "\342\245\277",
+    "\302\256", "\342\226\277", "\342\201\240", "|", "<", "\342\212\212\357\270\200", "\302\272", "\342\224\200",
+    "\342\247\220", "\342\212\213\357\270\200", "\302\246", "\342\205\225", "\342\227\203", "\360\235\223\202",
+    "\342\207\203", "\342\244\274", "\342\216\266", "\360\235\225\237", "\342\211\220", "\342\206\251", "\342\211\274",
+    "\342\206\275", "\342\237\265", "\342\244\220", "\304\264", "\342\211\214", "\342\213\255", "\360\235\225\236",
+    "\342\207\244", "\342\252\266", "\320\241", "\342\214\220", "\303\255", "\342\237\270", "\342\237\267",
+    "\342\211\260", "\303\275", "\342\207\223", "\342\245\234", "\342\211\245", "\342\253\220", "\342\246\273",
+    "\342\211\253", "\342\253\254", "\317\265", "\342\204\216", "\342\212\203\342\203\222", "\342\211\234",
+    "\342\245\254", "\342\213\276", "\342\237\266", "\342\210\276\314\263", "\342\212\271", "\342\213\206",
+    "\360\235\224\253", "\342\253\231", "\342\253\262", "\342\251\211", "\342\210\200", "\342\252\271", "\342\245\271",
+    "\342\210\264", "\342\207\223", "\342\200\235", "\342\204\260", "\342\227\273", "\342\211\251\357\270\200",
+    "\321\214", "\360\235\224\255", "\360\235\225\247", "\342\213\251", "\303\201", "\342\206\260", "\342\251\257",
+    "\342\214\225", "\342\212\245", "\342\204\236", "\342\212\206", "\342\211\217\314\270", "\342\251\212",
+    "\342\244\266", "\302\254", "\342\201\242", "\342\206\275", "\342\212\263", "\317\225", "\342\201\241",
+    "\342\212\202\342\203\222", "\342\252\222", "\316\246", "\342\210\262", "\342\204\202", "\342\212\254",
+    "\342\246\262", "\317\207", "\342\245\226", "\321\230", "\342\250\225", "\342\246\253", "\342\213\241",
+    "\342\204\250", "\320\230", "\316\232", "\342\245\256", "\342\200\211", "\360\235\222\264", "\342\213\203",
+    "\360\235\225\243", "\342\251\275\314\270", "\302\274", "\342\206\272", "\316\277", "\342\200\265", "\342\213\224",
+    "\342\252\213", "\342\206\236", "\342\211\215\342\203\222", "\342\205\206", "\360\235\222\246", "\321\215",
+    "\360\235\225\204", "\317\261", "\342\250\266", "\342\212\211", "\342\253\263", "\342\251\226", "\342\204\263",
+    "\342\235\262", "\302\257", "\316\243", "\342\213\254", "\305\274", "\320\221", "\342\245\236", "\360\235\224\216",
+    "\342\251\230", "\360\235\224\243", "\342\206\235", "\342\231\240", "\360\235\224\246", "}", "\342\251\260",
+    "\360\235\222\277", "\342\234\240", "\321\212", "\342\211\260", "\342\211\225", "\342\224\202", "\342\245\250",
+    "\320\227", "\342\230\216", "\342\212\251", "\305\222", "\342\207\277", "\342\245\257", "\342\213\241", "\320\234",
+    "\303\277", "fj", "\357\254\202", "\342\200\213", "\360\235\223\200", "\342\211\272", "\342\205\205",
+    "\342\226\263", "\342\253\227", "\342\210\241", "\342\252\242\314\270", "\342\204\234", "\342\210\265",
+    "\342\253\275\342\203\245", "\342\210\201", "\303\246", "\342\250\274", "\342\211\205", "\342\253\201", "\320\277",
+    "\342\210\270", "\342\213\210", "\342\211\256", "\302\275", "\342\247\200", "\342\210\247", "\320\262",
+    "\342\252\200", "\342\207\200", "\011", "\342\213\254", "\342\210\245", "\303\242", "\342\207\202",
+    "\360\235\224\232", "\342\234\223", "\342\207\222", "\342\252\203", "\342\205\207", "\306\222", "\342\213\272",
+    "\342\252\207", "\342\211\203", "\360\235\222\242", "\302\263", "\342\213\214", "\342\250\277", "\317\204",
+    "\342\212\227", "\360\235\224\211", "\342\212\215", "\342\206\277", "\342\237\250", "\342\211\204", "\342\205\227",
+    "\342\225\245", "\314\221", "\304\235", "\342\225\227", "\342\220\243", "\342\207\222", "\360\235\225\250",
+    "\304\210", "\320\252", "\342\210\210", "\342\213\223", "\342\200\212", "\342\251\277", "\342\210\202\314\270",
+    "\342\211\247\314\270", "\342\200\261", "\342\206\233", "\342\200\246", "\342\237\267", "\303\203", "\342\231\257",
+    "\304\250", "\317\235", "\342\226\200", "\342\211\221", "\342\252\267", "\342\211\246", "\342\252\257\314\270",
+    "\342\204\221", ",", "\342\213\216", "\342\250\214", "\342\244\244", "\342\210\235", "\342\212\263", "\342\212\232",
+    "\342\206\237", "\302\260", "\342\210\275", "\313\207", "\342\204\213", "\342\244\275", "\342\225\240",
+    "\342\206\221", "\342\253\246", "#", "\304\236", "%", "\303\237", "\342\246\225", "\342\252\251", "\342\200\215",
+    "\342\252\257", "\342\207\245", "\342\211\244\342\203\222", "\342\213\212", "\342\212\210",
+    "\342\253\213\357\270\200", "\303\217", "\342\204\244", "\342\212\273", "\304\260", "\302\240",
+    "\342\212\213\357\270\200", "\342\211\254", "\342\213\202", "\342\207\215", "\342\212\243", "\342\253\247",
+    "\305\265", "\342\210\213", "\342\213\216", "\342\200\236", "\342\245\244", "\360\235\224\224", "}", "\320\244",
+    "\342\200\276", "\342\211\270", "\342\206\222", "\303\245", "\302\276", "\316\272", "\342\245\255", "\342\206\247",
+    "\342\211\241", "\342\213\204", "\342\211\253\314\270", "\342\212\202\342\203\222", "\317\210", "\342\246\256",
+    "\342\244\265", "\342\211\212", "\342\245\225", "\320\235", "\302\267", "\342\210\255", "\342\250\246",
+    "\342\211\257", "\342\214\217", "\317\265", "\342\213\211", "\342\211\216", "\305\255", "\342\225\254", "\302\271",
+    "\342\212\250", "\305\206", "\342\212\267", "\342\214\211", "\342\245\205", "\342\211\202", "\342\212\233",
+    "\342\246\271", "\342\204\261", "\360\235\224\230", "\342\211\267", "\342\253\232", "\303\241", "\360\235\223\211",
+    "\342\206\261", "\342\205\210", "\342\223\210", "\342\211\200", "\342\212\236", "\342\212\211", "\342\206\240",
+    "\303\252", "\342\210\226", "\342\252\257", "\303\273", "\342\204\261", "\320\260", "\304\266", "\360\235\224\236",
+    "\342\252\265", "\303\264", "\342\212\250", "\342\226\277", "\342\252\215", "\342\210\243", "\342\207\245",
+    "\342\253\214\357\270\200", "\342\204\217", "\342\210\241", "\342\211\220\314\270", "\342\226\210", "\320\233",
+    "\342\251\237", "\302\244", "\342\212\245", "\342\226\252", "\360\235\224\223", "\342\224\234",
+    "\342\212\217\314\270", "\342\227\202", "\313\231", "\342\213\226", "\342\213\200", "\342\253\251", "\342\252\207",
+    "\342\214\242", "\342\200\202", "\342\210\253", "\342\211\255", "<\342\203\222", "\303\234", "\304\213", "\321\206",
+    "\316\265", "\342\211\252\314\270", "\342\214\215", "\342\204\217", "\342\237\271", "\342\207\223",
+    "\360\235\224\247", "\342\250\274", "\342\251\227", "\342\207\203", "\360\235\224\242", "\342\251\276",
+    "\342\206\232", "\342\253\206", "\305\254", "\342\212\200", "\342\211\216", "\342\213\213", "\360\235\225\246",
+    "\317\266", "\342\210\226", "\360\235\222\245", "\342\244\233", "\342\206\231", "\342\204\221", "\305\212",
+    "\342\206\244", "\342\211\220", "\342\206\276", "\342\211\205", "\342\210\250", "\360\235\224\273", "\342\210\247",
+    "\342\212\277", "\342\210\274", "\313\230", "\342\253\224", "\304\201", "\342\204\257", "\304\230", "\303\231",
+    "\342\207\275", "\342\210\245", "\342\246\260", "\303\267", "\303\202", "\342\214\212", "\342\207\212",
+    "\360\235\224\222", "\342\212\233", "\342\211\276", "\342\211\276", "\342\211\201", "\320\255", "\342\210\214",
+    "\342\211\200", "\342\252\260\314\270", "\342\211\253", "\342\252\260\314\270", "\321\224", "\342\201\203",
+    "\342\211\266", "\360\235\224\260", "\342\251\267", "\342\251\276\314\270", "\360\235\222\237", "\342\206\222",
+    "\342\211\217", "\342\252\205", "\342\204\231", "\342\250\227", "\342\200\225", "\342\214\216", "\313\232",
+    "\316\275", "\316\223", "\342\252\226", "\342\200\213", "\342\207\213", "\342\244\252", "\304\267", "\342\246\220",
+    "\342\210\253", "\316\233", "\342\210\204", "\342\225\243", "\342\210\244", "\342\213\250", "\342\200\234",
+    "\342\211\256", "\342\212\207", "\342\210\220", "\342\212\245", "\342\200\264", "\342\250\206", "\342\214\213",
+    "\360\235\225\235", "\342\246\223", "\342\210\205", "\316\222", "\303\212", "\320\217", "\342\206\246",
+    "\342\207\222", "\342\252\260\314\270", "\320\275", "\342\201\217", "\313\207", "\316\240", "\360\235\225\224",
+    "\342\211\247", "\342\253\205", "\342\226\263", "\342\214\212", "\342\253\206", "\342\244\221", "\342\226\270",
+    "\342\213\260", "\320\214", "\342\244\220", "\342\250\273", "\342\200\262", "\342\211\221", "\342\251\223",
+    "\342\252\256", ">\342\203\222", "\342\213\207", "\342\211\212", "\342\201\243", "\305\271", "\342\206\277",
+    "\305\266", "\360\235\224\276", "\342\210\274", "\342\207\276", "\342\200\246", "\342\207\265", "\342\211\270",
+    "\320\276", "\360\235\222\252", "\316\241", "\342\245\231", "\342\252\244", "\321\234", "\342\213\231",
+    "\342\251\275", "\342\237\265", "\342\247\264", "\360\235\225\201", "\342\250\224", "\342\212\230", "\342\245\263",
+    "\342\211\253", "\342\253\214", "\342\211\240", "\342\213\217", "+", "\304\270", "\342\210\202", "\342\235\230",
+    "\304\221", "\304\226", "\342\231\252", "\342\216\265", "\342\211\202\314\270", "\342\204\265", "\321\231",
+    "\360\235\224\254", "\342\250\263", "\342\231\246", "\342\204\251", "\360\235\224\233", "\342\200\226",
+    "\342\212\244", "\303\215", "\342\244\246", "\342\210\204", "\360\235\225\241", "\342\206\254", "\342\212\265",
+    "\304\252", "\342\245\221", "\342\207\232", "\342\212\241", "\342\206\252", "\342\201\241", "\342\207\222",
+    "\342\244\251", "\342\211\274", "\342\214\255", "\342\231\255", "\302\267", "\305\264", "\304\227", "\305\227", "*",
+    "\342\224\224", "\342\225\251", "\342\212\270", "\342\213\207", "\305\275", "\342\210\246", "\342\207\200",
+    "\342\213\266", "\342\250\256", "\303\207", "\342\210\256", "\342\212\253", "\304\277", "\342\200\231", "\321\236",
+    "\342\226\261", "\342\213\243", "\360\235\224\205", "\303\200", "\342\211\217\314\270", "\342\247\253",
+    "\342\252\257\314\270", "\342\212\203\342\203\222", "\342\203\234", "\342\210\246", "\342\211\211", "\342\212\220",
+    "\342\213\252", "\342\246\205", "\303\221", "\342\227\257", "\342\245\264", "\342\206\222", "\342\234\266",
+    "\342\237\265", "\342\227\270", "\342\244\231", "\342\253\226", "\303\213", "\342\226\275", "\303\256",
+    "\342\230\205", "\342\211\217", "\342\210\205", "\342\210\245", "\342\231\256", "\360\235\223\205", "\342\251\210",
+    "\342\246\232", "\316\273", "\342\204\255", "\342\237\247", "\305\226", "\342\211\267", "\342\206\233", "\305\243",
+    "\316\245", "\342\214\234", "\342\213\240", "\342\207\207", "\342\210\232", "\342\210\243", "\342\253\253",
+    "\342\250\200", "\342\245\247", "\342\206\226", "\342\237\251", "\342\252\214", "\342\204\233", "\342\200\232",
+    "\342\206\265", "\307\265", "\304\237", "\342\211\277", "\342\211\234", "\342\227\202", "\342\225\242",
+    "\342\246\234", "\342\207\211", "\342\213\230\314\270", "\342\214\223", "\302\277", "\342\245\213",
+    "\342\252\241\314\270", ";", "\342\212\240", "\342\210\265", "\342\211\275", "\342\206\246", "\342\226\264",
+    "\342\213\203", "\316\237", "\342\210\273", "\342\212\202", "\317\221", "\342\224\254", "\342\211\203",
+    "\342\204\222", "_", "\342\252\214", "\342\206\224", "\342\226\271", "\342\252\263", "\342\200\231", "\342\206\256",
+    "\342\211\202", "\303\250", "\342\245\217", "\342\250\222", "\316\235", "\317\234", "\304\214", "\342\204\220",
+    "\313\235", "\012", "\321\221", "\342\246\226", "\303\233", "\342\224\200", "\342\210\226", "\342\244\214",
+    "\342\230\206", "\304\200", "\320\216", "\302\250", "\342\206\267", "\342\237\251", "\342\206\254", "\342\210\275",
+    "\342\244\203", "\342\226\276", "\317\202", "\342\204\247", "\342\212\223", "\342\244\251", "\342\253\200",
+    "\342\225\241", "\305\244", "\342\210\221", "\342\252\206", "\342\253\214", "\342\244\223",
+    "\342\213\232\357\270\200", "\342\252\220", "{", "\342\213\232", "\342\251\261", ")", "\342\251\256",
+    "\342\253\205\314\270", "\342\252\260", "\342\237\270", "\342\212\264", "\342\207\231", "\342\207\225",
+    "\342\207\203", "\342\211\251", "\342\211\247", "\304\253", "\342\212\223\357\270\200", "\342\227\257", "\305\225",
+    "\342\245\227", "\303\206", "`", "\342\210\230", "\342\204\260", "\342\200\205", "\342\244\245", "\342\213\261",
+    "\360\235\225\222", "\342\204\270", "\305\272", "\342\250\226", "\320\250", "\304\273", "\320\245", "\342\204\232",
+    "\342\200\203", "\316\247", "\342\250\272", "\360\235\225\227", "\342\207\211", "[", "\305\224", "\342\205\207",
+    "\342\253\250", "\342\200\212", "\342\227\254", "\342\206\263", "\342\212\200", "\342\211\220", "\342\207\207",
+    "\342\237\254", "\342\245\273", "\342\245\275", "\342\201\201", "\342\245\216", "\342\250\255", "\342\206\223",
+    "\342\211\246\314\270", "\342\247\217\314\270", "\342\250\257", "\357\254\203", "\342\200\220", "\342\213\265",
+    "\342\210\254", "\321\201", "\313\230", "\342\210\243", "\342\210\217", "\342\213\221", "\342\204\242",
+    "\342\210\265", "\342\251\270", "\342\200\276", "\360\235\224\221", "\342\237\211", "\342\206\220", "\303\261",
+    "\342\200\242", "\342\212\224", "\342\206\221", "\360\235\225\253", "\342\244\267", "\360\235\225\212",
+    "\342\225\231", "\342\251\276\314\270", "\342\224\244", "\303\247", "\342\210\267", "@", "\305\223", "\342\210\213",
+    "\342\211\224", "\303\232", "\342\207\202", "\342\211\262", "\342\211\245", "\342\211\202", "\342\245\237",
+    "\342\213\217", "\303\225", "\360\235\223\207", "\342\247\236", "$", "\305\236", "\342\200\241", "\342\211\277",
+    "\342\204\231", "\360\235\222\271", "\304\251", "\304\215", "\342\225\244", "\342\211\222", "\342\251\224",
+    "\342\206\230", "\305\205", "\317\206", "\342\207\204", "\360\235\223\206", "\342\211\226", "\342\207\224",
+    "\342\247\201", "\342\207\226", "\342\210\240\342\203\222", "\342\207\220", "\342\206\240", "\342\213\215",
+    "\342\207\214", "\342\251\215", "\342\210\214", "\342\246\247", "\342\252\260", "\320\223", "\342\210\252",
+    "\304\233", "\342\252\254\357\270\200", "\342\210\245", "\342\210\277", "\342\211\272", "\342\211\227",
+    "\342\214\226", "\342\225\236", "\342\245\245", "\320\212", "\342\237\272", "\302\270", "\342\226\204",
+    "\342\246\267", "\342\200\265", "\342\207\217", "\317\202", "\342\210\201", "\317\211", "\360\235\224\251",
+    "\342\211\211", "\342\206\242", ":", "\342\213\204", "\342\205\232", "\317\201", "\320\246", "\342\211\215",
+    "\342\204\234", "\342\202\254", "\342\212\202\342\203\222", "\303\243", "\360\235\224\237", "\360\235\222\260",
+    "\360\235\225\216", "\342\213\237", "\342\207\210", "\316\244", "\342\251\267", "\342\217\247", "\342\251\263",
+    "\302\247", "\342\207\233", "\342\252\253", "\342\252\257", "\342\250\201", "\342\247\245", "\342\251\275\314\270",
+    "\302\250", "\342\210\207", "\342\251\233", "\342\206\224", "\342\246\276", "\342\213\252", "\303\253",
+    "\342\247\204", "\342\207\205", "\342\206\273", "\342\226\253", "\313\234", "\342\207\201", "\342\205\224",
+    "\342\206\242", "\342\214\234", "\342\213\271", "\342\252\245", "\342\210\263", "\342\244\205", "\342\212\203",
+    "\360\235\225\225", "\313\235", "\342\250\243", "\320\220", "\317\266", "\342\227\212", "\342\252\202",
+    "\342\211\216\314\270", "\342\210\243", "\342\246\216", "\342\212\264\342\203\222", "\342\204\220", "\342\211\252",
+    "\342\207\201", "\342\245\222", "\342\204\226", "\342\251\214", "\342\204\221", "\342\211\211", "\305\267",
+    "\303\204", "\342\252\221", "\342\213\231", "\342\231\245", "\342\237\251", "\342\210\255", "\360\235\225\233",
+    "\342\207\204", "\305\230", "\360\235\225\220", "\303\205", "\360\235\224\257", "{", "\305\261", "\342\206\266",
+    "\342\207\265", "\342\252\242", "\342\211\226", "\342\214\205", "\342\213\250", "\342\246\222", "\320\272",
+    "\304\241", "\342\244\235", "\316\234", "\342\211\203", "\360\235\224\263", "\304\271", "\342\207\220", "\302\242",
+    "\360\235\225\252", "\342\210\203", "\360\235\224\275", "\342\253\275", "\342\206\255", "\342\207\215",
+    "\342\212\265", "\342\252\201", "\302\261", "\342\206\225", "\342\207\225", "\342\212\272", "\342\210\266",
+    "\342\200\271", "\360\235\225\217", "\342\206\276", "\342\204\217", "\342\211\252", "\342\244\234", "\342\237\272",
+    "\360\235\225\223", "\303\211", "\317\225", "\342\213\255", "\360\235\222\256", "\360\235\225\234",
+    "\342\253\206\314\270", "\342\252\274", "\342\252\254", "\342\211\210", "\342\212\211", "\342\204\221",
+    "\342\206\245", "\321\207", "\342\253\217", "\342\244\215", "\342\213\242", "\342\253\221", "\342\223\210",
+    "\342\251\272", "\305\241", "\321\211", "\342\213\232", "\302\256", "\342\210\240", "\303\220", "\342\251\234",
+    "\342\225\237", "\342\211\253\342\203\222", "\342\212\224\357\270\200", "\342\200\272", "\342\200\235",
+    "\342\213\231\314\270", "\360\235\224\215", "\302\267", "\320\264", "\342\213\271\314\270", "\317\200",
+    "\342\205\207", "\342\204\222", "\360\235\223\217", "\357\254\204", "\342\245\257", "\342\200\241", "\317\205",
+    "\342\252\216", "\342\250\202", "\342\214\214", "\342\204\230", "\360\235\222\267", "\342\211\262", "\342\212\227",
+    "\316\262", "\342\251\200", "\342\206\225", "\305\232", "\342\225\225", "\342\204\266", "\342\224\274", "\317\222",
+    "\342\252\271", "\342\251\252", "\360\235\225\251", "\342\204\202", "\342\213\267", "\342\214\237", "\320\225",
+    "\316\263", "\342\204\212", "\342\234\223", "\342\212\225", "\342\206\247", "\342\226\223", "\360\235\223\203",
+    "\302\240", "\342\245\260", "\320\271", "\360\235\224\270", "\302\245", "\342\211\257", "\342\227\213",
+    "\342\244\250", "\342\226\265", "\320\243", "\320\205", "\342\206\230", "\342\212\212\357\270\200", "\342\211\273",
+    "\305\221", "\342\207\210", "\342\245\266", "\342\210\274", "\342\210\227", "\305\263", "\305\242", "\342\225\233",
+    "\342\244\250", "\342\252\237", "\342\212\266", "\342\212\223", "\342\206\226", "\342\206\253", "\302\262",
+    "\342\226\255", "\342\225\224", "\320\202", "]", "\342\212\231", "\342\224\230", "\342\206\227", "\342\213\220",
+    "\342\211\262", "\342\252\247", "\317\265", "\360\235\224\210", "\342\207\205", "!", "\342\211\240", "\316\236",
+    "\303\276", "\342\245\265", "\304\262", "\342\210\245", "\342\245\251", "\342\251\246", "\342\212\262",
+    "\360\235\222\253", "\342\245\253", "\342\225\253", "\342\245\220", "\342\210\205", "\303\272", "\342\200\245",
+    "\302\251", "\342\227\271", "\320\231", "\360\235\223\216", "\303\270", "\342\250\271", "\342\247\235", "\321\213",
+    "\342\213\203", "\305\215", "\303\263", "\320\207", "\342\211\210", "\360\235\222\263", "\342\213\225", "\320\261",
+    "\342\253\213", "\342\206\230", "\342\226\276", "\342\210\202", "\342\210\211", "\342\211\224", "\305\202",
+    "\342\211\247", "\342\226\241", "\342\210\262", "\342\250\204", "\342\244\226", "\342\207\217", "\302\261",
+    "\342\245\210", "\317\260", "\342\204\254", "\342\204\235", "\342\210\200", "\342\212\202", "\342\245\274",
+    "\342\206\232", "\342\212\244", "\342\207\213", "\342\250\220", "\313\231", "\342\231\240", "\321\203",
+    "\342\245\233", "\342\213\262", "\342\206\220", "\342\210\251\357\270\200", "\303\236", "\342\207\224",
+    "\342\212\220", "\360\235\224\256", "\305\231", "\342\204\234", "\342\250\200", "\342\211\250", "\360\235\224\241",
+    "\360\235\225\203", "\342\212\222", "\316\261", "\342\211\275", "\342\253\261", "\342\234\227", "\342\211\275",
+    "\342\247\266", "\342\206\276", "\342\212\222", "\342\216\265", "\342\204\205", "\342\212\276", "\342\206\223",
+    "\305\203", "\342\225\221", "\320\253", "\342\214\237", "\342\246\250", "\342\213\200", "<", "\320\236",
+    "\342\210\257", "\342\212\265", "\304\276", "\342\206\220", "\321\202", "\303\257", "\342\207\216", "\342\200\236",
+    "\320\237", "\342\211\261", "\342\212\224", "\360\235\224\217", "\342\231\246", "\342\214\242", "\342\245\223",
+    "\342\207\213", "\342\212\210", "\342\253\214\357\270\200", "\342\210\237", "\342\237\277", "\342\206\222", "'",
+    "\342\212\240", "\342\206\252", "\342\211\250\357\270\200", "\342\213\205", "\342\211\265", "\304\211",
+    "\342\247\216", "\342\204\263", "\342\207\220", "\320\224", "\305\234", "\360\235\225\232", "\360\235\224\250",
+    "\313\234", "\316\271", "\342\210\230", "\342\253\222", "\342\210\224", "\342\253\230", "\342\213\201",
+    "\342\200\263", "\342\217\235", "\302\250", "\342\214\277", "\342\252\206", "\320\240", "\321\237", "\342\211\210",
+    "\342\204\217", "\342\245\252", "\342\210\204", "\342\213\213", "\320\267", "\320\273", "\342\252\210",
+    "\342\211\267", "\342\213\257", "\342\206\243", "\317\235", "\342\212\272", "\305\207", "\304\240", "\342\205\206",
+    "\342\252\224", "\342\210\210", "\342\225\230", "\360\235\224\204", "\342\225\234", "\342\213\253", "\342\246\206",
+    "\342\207\227", "\342\211\253\314\270", "\342\246\217", "\320\266", "\342\247\253", "\342\204\225", "\342\200\242",
+    "\303\226", "\342\210\270", "\360\235\225\206", "\342\212\217", "\342\212\242", "\317\261",
+    "\342\212\265\342\203\222", "\304\246", "\342\253\205", "\342\200\211", "\360\235\224\264", "\342\206\274",
+    "\303\205", "\342\214\205", "\342\252\236", "\342\247\220\314\270", "\342\252\227", "\342\212\203", "\342\252\250",
+    "\320\263", "\342\201\204",
+};
+}  // namespace
+
+const char* FindLookupTableSymbol(const char* data, std::size_t size) {
+  if (size == 0 || size > kMaxLookupTableSymbolSize) {
+    return nullptr;
+  }
+
+  const std::size_t slot = FindSlot(kLookupTableSymbolDisplacements, data, size);
+  return Equals(kLookupTableSymbols[slot], data, size) ? kLookupTableSymbolReplacements[slot] : nullptr;
+}
+
+const char* FindHtmlEntity(const char* data, std::size_t size) {
+  if (size == 0 || size > kMaxHtmlEntityNameSize) {
+    return nullptr;
+  }
+
+  const std::size_t slot = FindSlot(kHtmlEntityNameDisplacements, data, size);
+  return Equals(kHtmlEntityNames[slot], data, size) ? kHtmlEntityCharacters[slot] : nullptr;
+}
+
+bool IsHtmlEntityName(const char* data, std::size_t size) {
+  return FindHtmlEntity(data, size) != nullptr;
+}
+
+}  // namespace symbols
+}  // namespace lightex
@@ -0,0 +1,24 @@
+// Generated by utils/generate_symbol_tables.py, do not edit.
+
+#pragma once
+
+#include <cstddef>
+
+namespace lightex {
+namespace symbols {
+
+const std::size_t kMaxLookupTableSymbolSize = 3;
+const std::size_t kMaxHtmlEntityNameSize = 31;
+
+// Returns the HTML replacement of the lookup table symbol, e.g. "&mdash;" for "---", or nullptr if there is no such
+// symbol. Doesn't allocate.
+const char* FindLookupTableSymbol(const char* data, std::size_t size);
+
+// Returns the UTF-8 encoded characters which "&name;" stands for, e.g. "—" for "mdash", or nullptr if it isn't a
+// named character reference of HTML5. |data| holds the name only. Doesn't allocate.
+const char* FindHtmlEntity(const char* data, std::size_t size);
+
+bool IsHtmlEntityName(const char* data, std::size_t size);
+
+}  // namespace symbols
+}  // namespace lightex
@@ -0,0 +1,408 @@
+#include <lightex/text_converter/text_visitor.h>
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+
+#include <lightex/html_converter/html_visitor.h>
+#include <lightex/symbols/symbol_tables.h>
+#include <lightex/utils/text_utils.h>
+
+namespace lightex {
+namespace text_converter {
+namespace {
+
+// Returns the characters of "&name;", or nullptr if |text| is not a single entity.
+const char* FindHtmlEntity(const char* text, std::size_t size) {
+  if (size <= 2 || text[0] != '&' || text[size - 1] != ';') {
+    return nullptr;
+  }
+
+  return symbols::FindHtmlEntity(text + 1, size - 2);
+}
+
+// Drops everything between '<' and '>', so that only text content of the markup remains.
+void AppendTextOfMarkup(const std::string& markup, std::string* output) {
+  std::string text;
+  std::size_t position = 0;
+  while (position < markup.size()) {
+    const std::size_t tag_first = std::min(markup.find('<', position), markup.size());
+    text.append(markup, position, tag_first - position);
+    if (tag_first == markup.size()) {
+      break;
+    }
+
+    const std::size_t tag_last = markup.find('>', tag_first);
+    if (tag_last == std::string::npos) {
+      break;
+    }
+    position = tag_last + 1;
+  }
+
+  utils::AppendCollapsedText(text, output);
+}
+
+template <typename MacroDefinition>
+const std::shared_ptr<const MacroDefinition>* GetMacroDefinition(
+    const std::vector<std::shared_ptr<const MacroDefinition>>& macro_definitions,
+    std::size_t visible_macro_definitions_num,
+    ast::SymbolId name) {
+  for (std::size_t i = std::min(visible_macro_definitions_num, macro_definitions.size()); i > 0; --i) {
+    if (macro_definitions[i - 1]->name == name) {
+      return &macro_definitions[i - 1];
+    }
+  }
+
+  return nullptr;
+}
+}  // namespace
+
+TextVisitor::TextVisitor(const ast::SymbolTable* symbol_table)
+    : symbol_table_(symbol_table), max_expansion_depth_(html_converter::kDefaultMaxExpansionDepth) {}
+
+void TextVisitor::SetSymbolTable(const ast::SymbolTable* symbol_table) {
+  symbol_table_ = symbol_table;
+}
+
+void TextVisitor::SetMaxExpansionDepth(int max_expansion_depth) {
+  max_expansion_depth_ = std::max(max_expansion_depth, 0);
+}
+
+bool TextVisitor::operator()(const ast::Program& program) {
+  return VisitNodes(program.nodes);
+}
+
+bool TextVisitor::operator()(const ast::PlainText& plain_text) {
+  const std::string& text = plain_text.text;
+  if (const char* replacement = symbols::FindLookupTableSymbol(text.data(), text.size())) {
+    AppendDecodedSymbol(replacement);
+  } else {
+    utils::AppendCollapsedText(text, &output_);
+  }
+
+  return true;
+}
+
+bool TextVisitor::operator()(const ast::HtmlEntity& html_entity) {
+  AppendDecodedSymbol(html_entity.text.c_str());
+  return true;
+}
+
+bool TextVisitor::operator()(const ast::Paragraph& paragraph) {
+  const std::size_t output_size = output_.size();
+  if (!VisitNodes(paragraph.nodes)) {
+    return false;
+  }
+
+  // Like HtmlVisitor, which doesn't wrap paragraphs of environment definitions into <p>.
+  if (active_environment_definitions_num_ == 0 && output_.size() > output_size) {
+    EndLine();
+  }
+  return true;
+}
+
+bool TextVisitor::operator()(const ast::ParagraphBreaker& paragraph_breaker) {
+  return true;
+}
+
+bool TextVisitor::operator()(const ast::Argument& argument) {
+  return VisitNodes(argument.nodes);
+}
+
+bool TextVisitor::operator()(const ast::ArgumentRef& argument_ref) {
+  return AppendArgumentByReference(argument_ref.argument_id - 1, false, "Invalid argument reference.");
+}
+
+bool TextVisitor::operator()(const ast::OuterArgumentRef& outer_argument_ref) {
+  return AppendArgumentByReference(outer_argument_ref.argument_id - 1, true, "Invalid outer argument reference.");
+}
+
+bool TextVisitor::operator()(const ast::InlinedMathText& math_text) {
+  output_ += math_text.text;
+  return true;
+}
+
+bool TextVisitor::operator()(const ast::MathText& math_text) {
+  EndLine();
+  output_ += math_text.text;
+  EndLine();
+  return true;
+}
+
+bool TextVisitor::operator()(const ast::CommandMacro& command_macro) {
+  const std::size_t arguments_num = command_macro.arguments_num.get_value_or(0);
+  if (arguments_num < command_macro.default_arguments.size()) {
+    return Fail("Invalid number of arguments for command macro " + GetName(command_macro.name) + ".");
+  }
+
+  defined_command_macros_.push_back(BindDefinition(command_macro));
+  return true;
+}
+
+bool TextVisitor::operator()(const ast::EnvironmentMacro& environment_macro) {
+  const std::size_t arguments_num = environment_macro.arguments_num.get_value_or(0);
+  if (arguments_num < environment_macro.default_arguments.size()) {
+    return Fail("Invalid number of arguments for environment macro " + GetName(environment_macro.name) + ".");
+  }
+
+  defined_environment_macros_.push_back(BindDefinition(environment_macro));
+  return true;
+}
+
+bool TextVisitor::operator()(const ast::Command& command) {
+  const ast::CommandMacro* command_macro_ptr = GetDefinedCommandMacro(command.name);
+  if (!command_macro_ptr) {
+    return Fail("Command macro " + GetName(command.name) + " is not defined yet.");
+  }
+
+  ArgumentsFrame frame;
+  if (!PrepareMacroArguments(command, *command_macro_ptr, &frame)) {
+    return false;
+  }
+  if (IsExpansionDepthExceeded()) {
+    return Fail("Command macro " + GetName(command.name) + " is nested deeper than " +
+                std::to_string(max_expansion_depth_) + " expansions.");
+  }
+
+  PushArgumentsFrame(std::move(frame));
+  const bool is_successful = (*this)(command_macro_ptr->body);
+  PopArgumentsFrame();
+
+  return is_successful;
+}
+
+bool TextVisitor::operator()(const ast::UnescapedCommand& unescaped_command) {
+  std::string output;
+  output.swap(output_);
+  const bool is_successful = (*this)(unescaped_command.body);
+  output.swap(output_);
+
+  if (is_successful) {
+    AppendTextOfMarkup(output, &output_);
+  }
+  return is_successful;
+}
+
+bool TextVisitor::operator()(const ast::NparagraphCommand& nparagraph_command) {
+  return (*this)(nparagraph_command.body);
+}
+
+bool TextVisitor::operator()(const ast::Environment& environment) {
+  if (environment.name != environment.end_name) {
+    return Fail("Environment name doesn't match the end name: " + GetName(environment.name) +
+                " != " + GetName(environment.end_name));
+  }
+
+  const std::shared_ptr<const ast::EnvironmentMacro> environment_macro_ptr =
+      GetDefinedEnvironmentMacro(environment.name);
+  if (!environment_macro_ptr) {
+    return Fail("Environment macro " + GetName(environment.name) + " is not defined yet.");
+  }
+
+  ArgumentsFrame frame;
+  if (!PrepareMacroArguments(environment, *environment_macro_ptr, &frame)) {
+    return false;
+  }
+  if (IsExpansionDepthExceeded()) {
+    return Fail("Environment macro " + GetName(environment.name) + " is nested deeper than " +
+                std::to_string(max_expansion_depth_) + " expansions.");
+  }
+
+  const std::size_t cached_defined_command_macros_num = defined_command_macros_.size();
+  const std::shared_ptr<const void> caller_definitions_owner = definitions_owner_;
+  PushArgumentsFrame(std::move(frame));
+
+  active_environment_definitions_num_ += 1;
+  definitions_owner_ = environment_macro_ptr;
+  bool is_successful = (*this)(environment_macro_ptr->pre_program);
+  definitions_owner_ = caller_definitions_owner;
+  active_environment_definitions_num_ -= 1;
+
+  is_successful = is_successful && (*this)(environment.program);
+
+  active_environment_definitions_num_ += 1;
+  definitions_owner_ = environment_macro_ptr;
+  is_successful = is_successful && (*this)(environment_macro_ptr->post_program);
+  definitions_owner_ = caller_definitions_owner;
+  active_environment_definitions_num_ -= 1;
+
+  while (cached_defined_command_macros_num < defined_command_macros_.size()) {
+    defined_command_macros_.pop_back();
+  }
+  PopArgumentsFrame();
+
+  return is_successful;
+}
+
+bool TextVisitor::operator()(const ast::VerbatimEnvironment& verbatim_environment) {
+  output_ += verbatim_environment.content;
+  EndLine();
+  return true;
+}
+
+std::string TextVisitor::TakeOutput() {
+  std::string output;
+  output.swap(output_);
+  return output;
+}
+
+const std::string& TextVisitor::GetErrorMessage() const {
+  return error_message_;
+}
+
+template <typename Node>
+bool TextVisitor::VisitNodes(const std::list<Node>& nodes) {
+  for (const auto& node : nodes) {
+    if (!boost::apply_visitor(*this, node)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename Macro>
+std::shared_ptr<const Macro> TextVisitor::BindDefinition(const Macro& macro) const {
+  if (definitions_owner_) {
+    return std::shared_ptr<const Macro>(definitions_owner_, &macro);
+  }
+  return std::make_shared<const Macro>(macro);
+}
+
+template <typename Macro, typename MacroDefinition>
+bool TextVisitor::PrepareMacroArguments(const Macro& macro,
+                                        const MacroDefinition& macro_definition,
+                                        ArgumentsFrame* output_frame) {
+  const std::size_t default_args_num = macro_definition.default_arguments.size();
+  const std::size_t redefined_default_args_num = macro.default_arguments.size();
+  if (redefined_default_args_num > default_args_num) {
+    return Fail("Macro " + GetName(macro.name) + " has more default arguments than it's been defined. " +
+                "Expected " + std::to_string(default_args_num) + ", got " +
+                std::to_string(redefined_default_args_num) + ".");
+  }
+
+  const std::size_t args_num = default_args_num + macro.arguments.size();
+  const std::size_t expected_args_num = macro_definition.arguments_num.get_value_or(0);
+  if (args_num != expected_args_num) {
+    return Fail("Macro " + GetName(macro.name) + " has invalid number of arguments. " + "Expected " +
+                std::to_string(expected_args_num) + ", got " + std::to_string(args_num) + ".");
+  }
+
+  // Default arguments given at the call site override the leading default arguments of the definition.
+  std::vector<const ast::Argument*>& args = output_frame->arguments;
+  args.reserve(args_num);
+  for (const auto& argument : macro.default_arguments) {
+    args.push_back(&argument);
+  }
+  auto default_argument_it = std::next(macro_definition.default_arguments.begin(), redefined_default_args_num);
+  for (; default_argument_it != macro_definition.default_arguments.end(); ++default_argument_it) {
+    args.push_back(&(*default_argument_it));
+  }
+  for (const auto& argument : macro.arguments) {
+    args.push_back(&argument);
+  }
+
+  output_frame->texts.resize(args_num);
+  return true;
+}
+
+void TextVisitor::PushArgumentsFrame(ArgumentsFrame&& frame) {
+  frame.caller_frame_index = active_frame_index_;
+  frame.visible_command_macros_num = GetVisibleCommandMacrosNum();
+  frame.visible_environment_macros_num = GetVisibleEnvironmentMacrosNum();
+
+  arguments_stack_.push_back(std::move(frame));
+  active_frame_index_ = static_cast<int>(arguments_stack_.size()) - 1;
+}
+
+void TextVisitor::PopArgumentsFrame() {
+  active_frame_index_ = arguments_stack_.back().caller_frame_index;
+  arguments_stack_.pop_back();
+}
+
+bool TextVisitor::IsExpansionDepthExceeded() const {
+  return arguments_stack_.size() >= max_expansion_depth_;
+}
+
+bool TextVisitor::AppendArgumentByReference(int index, bool is_outer, const char* invalid_reference_error) {
+  int frame_index = active_frame_index_;
+  if (is_outer && frame_index >= 0) {
+    frame_index = arguments_stack_[frame_index].caller_frame_index;
+  }
+  if (index < 0 || frame_index < 0 ||
+      arguments_stack_[frame_index].arguments.size() <= static_cast<std::size_t>(index)) {
+    return Fail(invalid_reference_error);
+  }
+
+  if (!arguments_stack_[frame_index].texts[index]) {
+    // Evaluates the argument at the call site, like HtmlVisitor does, into a buffer of its own.
+    const int cached_active_frame_index = active_frame_index_;
+    const std::size_t cached_command_macros_visibility_limit = command_macros_visibility_limit_;
+    const std::size_t cached_environment_macros_visibility_limit = environment_macros_visibility_limit_;
+    active_frame_index_ = arguments_stack_[frame_index].caller_frame_index;
+    command_macros_visibility_limit_ = arguments_stack_[frame_index].visible_command_macros_num;
+    environment_macros_visibility_limit_ = arguments_stack_[frame_index].visible_environment_macros_num;
+
+    std::string text;
+    text.swap(output_);
+    const bool is_successful = (*this)(*arguments_stack_[frame_index].arguments[index]);
+    text.swap(output_);
+
+    active_frame_index_ = cached_active_frame_index;
+    command_macros_visibility_limit_ = cached_command_macros_visibility_limit;
+    environment_macros_visibility_limit_ = cached_environment_macros_visibility_limit;
+    if (!is_successful) {
+      return false;
+    }
+
+    arguments_stack_[frame_index].texts[index] = std::move(text);
+  }
+
+  output_ += *arguments_stack_[frame_index].texts[index];
+  return true;
+}
+
+void TextVisitor::AppendDecodedSymbol(const char* entity) {
+  const char* characters = FindHtmlEntity(entity, std::strlen(entity));
+  if (characters) {
+    output_ += characters;
+  }
+}
+
+void TextVisitor::EndLine() {
+  if (!output_.empty() && output_.back() == ' ') {
+    output_.back() = '\n';
+  } else if (!output_.empty() && output_.back() != '\n') {
+    output_ += '\n';
+  }
+}
+
+bool TextVisitor::Fail(const std::string& error_message) {
+  error_message_ = error_message;
+  return false;
+}
+
+const std::string& TextVisitor::GetName(ast::SymbolId name) const {
+  return symbol_table_->GetName(name);
+}
+
+const ast::CommandMacro* TextVisitor::GetDefinedCommandMacro(ast::SymbolId name) const {
+  const auto* command_macro = GetMacroDefinition(defined_command_macros_, command_macros_visibility_limit_, name);
+  return command_macro ? command_macro->get() : nullptr;
+}
+
+std::shared_ptr<const ast::EnvironmentMacro> TextVisitor::GetDefinedEnvironmentMacro(ast::SymbolId name) const {
+  const auto* environment_macro =
+      GetMacroDefinition(defined_environment_macros_, environment_macros_visibility_limit_, name);
+  return environment_macro ? *environment_macro : nullptr;
+}
+
+std::size_t TextVisitor::GetVisibleCommandMacrosNum() const {
+  return std::min(command_macros_visibility_limit_, defined_command_macros_.size());
+}
+
+std::size_t TextVisitor::GetVisibleEnvironmentMacrosNum() const {
+  return std::min(environment_macros_visibility_limit_, defined_environment_macros_.size());
+}
+}  // namespace text_converter
+}  // namespace lightex
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <lightex/ast/ast.h>
+#include <lightex/ast/symbol_table.h>
+
+#include <boost/optional/optional.hpp>
+#include <boost/variant/static_visitor.hpp>
+
+namespace lightex {
+namespace text_converter {
+
+// Arguments of a single macro call, see html_converter::ArgumentsFrame.
+struct ArgumentsFrame {
+  std::vector<const ast::Argument*> arguments;  // Not owned.
+  std::vector<boost::optional<std::string>> texts;
+
+  int caller_frame_index = -1;
+  std::size_t visible_command_macros_num = 0;
+  std::size_t visible_environment_macros_num = 0;
+};
+
+// Extracts the visible text of a program, e.g. for full-text search. Macros are expanded the same way HtmlVisitor
+// expands them, but only text content is emitted: markup of unescaped commands is dropped, entities and lookup table
+// symbols are decoded into UTF-8 and math formulas are kept as their source. Paragraphs and display formulas end with
+// a line break.
+//
+// The text is appended to a single buffer as the program is visited. Returns false on failure, see GetErrorMessage().
+class TextVisitor : public boost::static_visitor<bool> {
+ public:
+  // |symbol_table| must be the table the visited programs were parsed with.
+  explicit TextVisitor(const ast::SymbolTable* symbol_table);
+
+  bool operator()(const ast::Program& program);
+  bool operator()(const ast::PlainText& plain_text);
+  bool operator()(const ast::HtmlEntity& html_entity);
+  bool operator()(const ast::Paragraph& paragraph);
+  bool operator()(const ast::ParagraphBreaker& paragraph_breaker);
+  bool operator()(const ast::Argument& argument);
+  bool operator()(const ast::ArgumentRef& argument_ref);
+  bool operator()(const ast::OuterArgumentRef& outer_argument_ref);
+  bool operator()(const ast::InlinedMathText& inlined_math_text);
+  bool operator()(const ast::MathText& math_text);
+  bool operator()(const ast::CommandMacro& command_macro);
+  bool operator()(const ast::EnvironmentMacro& environment_macro);
+  bool operator()(const ast::Command& command);
+  bool operator()(const ast::UnescapedCommand& unescaped_command);
+  bool operator()(const ast::NparagraphCommand& nparagraph_command);
+  bool operator()(const ast::Environment& environment);
+  bool operator()(const ast::VerbatimEnvironment& verbatim_environment);
+
+  // See html_converter::HtmlVisitor::SetSymbolTable().
+  void SetSymbolTable(const ast::SymbolTable* symbol_table);
+
+  // See html_converter::HtmlVisitor::SetMaxExpansionDepth().
+  void SetMaxExpansionDepth(int max_expansion_depth);
+
+  // Moves out the text extracted so far. Macro definitions stay, so a visitor which has visited a style can be copied
+  // to extract text of programs using it.
+  std::string TakeOutput();
+
+  const std::string& GetErrorMessage() const;
+
+ private:
+  template <typename Node>
+  bool VisitNodes(const std::list<Node>& nodes);
+
+  // See html_converter::HtmlVisitor::BindDefinition().
+  template <typename Macro>
+  std::shared_ptr<const Macro> BindDefinition(const Macro& macro) const;
+
+  template <typename Macro, typename MacroDefinition>
+  bool PrepareMacroArguments(const Macro& macro, const MacroDefinition& macro_definition, ArgumentsFrame* output_frame);
+
+  void PushArgumentsFrame(ArgumentsFrame&& frame);
+  void PopArgumentsFrame();
+  bool IsExpansionDepthExceeded() const;
+
+  bool AppendArgumentByReference(int index, bool is_outer, const char* invalid_reference_error);
+  void AppendDecodedSymbol(const char* entity);
+  void EndLine();
+  bool Fail(const std::string& error_message);
+
+  const std::string& GetName(ast::SymbolId name) const;
+  const ast::CommandMacro* GetDefinedCommandMacro(ast::SymbolId name) const;
+  std::shared_ptr<const ast::EnvironmentMacro> GetDefinedEnvironmentMacro(ast::SymbolId name) const;
+  std::size_t GetVisibleCommandMacrosNum() const;
+  std::size_t GetVisibleEnvironmentMacrosNum() const;
+
+  const ast::SymbolTable* symbol_table_;  // Not owned.
+  std::size_t max_expansion_depth_;
+
+  std::string output_;
+  std::string error_message_;
+
+  int active_environment_definitions_num_ = 0;
+
+  std::vector<ArgumentsFrame> arguments_stack_;
+  int active_frame_index_ = -1;
+  std::size_t command_macros_visibility_limit_ = std::numeric_limits<std::size_t>::max();
+  std::size_t environment_macros_visibility_limit_ = std::numeric_limits<std::size_t>::max();
+
+  // Nested definitions share the AST of the enclosing one, see html_converter::HtmlVisitor.
+  std::vector<std::shared_ptr<const ast::CommandMacro>> defined_command_macros_;
+  std::vector<std::shared_ptr<const ast::EnvironmentMacro>> defined_environment_macros_;
+  std::shared_ptr<const void> definitions_owner_;
+};
+
+}  // namespace text_converter
+}  // namespace lightex
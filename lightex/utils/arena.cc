@@ -0,0 +1,111 @@
+#include <lightex/utils/arena.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace lightex {
+namespace utils {
+namespace {
+
+const std::size_t kMinBlockSize = 64 << 10;
+const std::size_t kMaxBlockSize = 4 << 20;
+// Blocks beyond this are released instead of cached, so that a single huge request doesn't pin memory of the thread
+// forever.
+const std::size_t kMaxCachedBytes = 64 << 20;
+
+thread_local Arena* current_arena = nullptr;
+}  // namespace
+
+// Reused by the following arenas of the thread, so a warmed up thread stops allocating from the global heap.
+struct Arena::BlockCache {
+  ~BlockCache() {
+    for (const Block& block : blocks) {
+      std::free(block.data);
+    }
+  }
+
+  std::vector<Block> blocks;
+  std::size_t size_bytes = 0;
+};
+
+thread_local Arena::BlockCache Arena::block_cache_;
+
+Arena::Arena() {}
+
+Arena::~Arena() {
+  for (const Block& block : blocks_) {
+    if (block_cache_.size_bytes + block.size <= kMaxCachedBytes) {
+      block_cache_.blocks.push_back(block);
+      block_cache_.size_bytes += block.size;
+    } else {
+      std::free(block.data);
+    }
+  }
+}
+
+void* Arena::Allocate(std::size_t size, std::size_t alignment) {
+  std::uintptr_t position = reinterpret_cast<std::uintptr_t>(position_);
+  std::uintptr_t aligned_position = (position + alignment - 1) & ~(alignment - 1);
+  if (!position_ || aligned_position + size > reinterpret_cast<std::uintptr_t>(end_)) {
+    // Blocks are allocated with malloc, so their beginning is aligned for any type.
+    AddBlock(size);
+    aligned_position = reinterpret_cast<std::uintptr_t>(position_);
+  }
+
+  position_ = reinterpret_cast<char*>(aligned_position + size);
+  return reinterpret_cast<void*>(aligned_position);
+}
+
+std::size_t Arena::GetReservedBytes() const {
+  std::size_t reserved_bytes = 0;
+  for (const Block& block : blocks_) {
+    reserved_bytes += block.size;
+  }
+  return reserved_bytes;
+}
+
+std::size_t Arena::GetThreadCachedBytes() {
+  return block_cache_.size_bytes;
+}
+
+void Arena::AddBlock(std::size_t min_size) {
+  // Every next block is twice as large, up to kMaxBlockSize.
+  const std::size_t block_size =
+      std::max(min_size, std::min(kMinBlockSize << std::min<std::size_t>(blocks_.size(), 6), kMaxBlockSize));
+
+  auto it = std::find_if(block_cache_.blocks.begin(), block_cache_.blocks.end(),
+                         [block_size](const Block& block) { return block.size >= block_size; });
+  Block block;
+  if (it != block_cache_.blocks.end()) {
+    block = *it;
+    block_cache_.size_bytes -= block.size;
+    block_cache_.blocks.erase(it);
+  } else {
+    block.data = static_cast<char*>(std::malloc(block_size));
+    if (!block.data) {
+      throw std::bad_alloc();
+    }
+    block.size = block_size;
+  }
+
+  blocks_.push_back(block);
+  position_ = block.data;
+  end_ = block.data + block.size;
+}
+
+ArenaScope::ArenaScope(Arena* arena) : previous_arena_(current_arena) {
+  current_arena = arena;
+}
+
+ArenaScope::~ArenaScope() {
+  current_arena = previous_arena_;
+}
+
+Arena* ArenaScope::GetCurrentArena() {
+  return current_arena;
+}
+
+}  // namespace utils
+}  // namespace lightex
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace lightex {
+namespace utils {
+
+// Monotonic memory of a single request, released at once. Must be used and destroyed on the thread that made it.
+class Arena {
+ public:
+  Arena();
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // |alignment| must be a power of two not greater than alignof(std::max_align_t).
+  void* Allocate(std::size_t size, std::size_t alignment);
+
+  // Total size of the blocks held by the arena.
+  std::size_t GetReservedBytes() const;
+  // Total size of the blocks kept for reuse by the following arenas of the thread.
+  static std::size_t GetThreadCachedBytes();
+
+ private:
+  struct Block {
+    char* data;
+    std::size_t size;
+  };
+  // Blocks of destroyed arenas, per thread.
+  struct BlockCache;
+
+  void AddBlock(std::size_t min_size);
+
+  static thread_local BlockCache block_cache_;
+
+  std::vector<Block> blocks_;
+  char* position_ = nullptr;
+  char* end_ = nullptr;
+};
+
+// Makes |arena| the current arena of the thread until the scope is destroyed. Scopes can be nested.
+class ArenaScope {
+ public:
+  explicit ArenaScope(Arena* arena);
+  ~ArenaScope();
+
+  ArenaScope(const ArenaScope&) = delete;
+  ArenaScope& operator=(const ArenaScope&) = delete;
+
+  // nullptr if there is no arena scope on the thread.
+  static Arena* GetCurrentArena();
+
+ private:
+  Arena* previous_arena_;
+};
+
+// Allocates from the arena current when it was made, or from the heap. Copies go to the arena current at copy time.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  ArenaAllocator() : arena_(ArenaScope::GetCurrentArena()) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.GetArena()) {}
+
+  T* allocate(std::size_t n) {
+    if (arena_) {
+      return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) {
+    if (!arena_) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+  Arena* GetArena() const { return arena_; }
+
+ private:
+  Arena* arena_;  // Not owned.
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.GetArena() == b.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return !(a == b);
+}
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace utils
+}  // namespace lightex
@@ -1,9 +1,13 @@
 #include <lightex/utils/file_utils.h>
 
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace lightex {
 namespace utils {
 
@@ -24,5 +28,45 @@ bool ReadDataFromFile(const std::string& path, std::string* output) {
 
   return true;
 }
+
+OutputFile::OutputFile(const std::string& path)
+    : path_(path), temporary_path_(path + ".tmp." + std::to_string(getpid())) {}
+
+OutputFile::~OutputFile() {
+  if (fd_ >= 0) {
+    close(fd_);
+    std::remove(temporary_path_.c_str());
+  }
+}
+
+bool OutputFile::Open() {
+  fd_ = open(temporary_path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    std::cerr << "Error: failed to open output file for writing: " << temporary_path_ << "." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+int OutputFile::GetFd() const {
+  return fd_;
+}
+
+const std::string& OutputFile::GetTemporaryPath() const {
+  return temporary_path_;
+}
+
+bool OutputFile::Commit() {
+  const int fd = fd_;
+  fd_ = -1;
+  if (close(fd) != 0 || std::rename(temporary_path_.c_str(), path_.c_str()) != 0) {
+    std::cerr << "Error: failed to write output file: " << path_ << "." << std::endl;
+    std::remove(temporary_path_.c_str());
+    return false;
+  }
+
+  return true;
+}
 }  // namespace utils
 }  // namespace lightex
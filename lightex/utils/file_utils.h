@@ -7,5 +7,29 @@ namespace utils {
 
 bool ReadDataFromFile(const std::string& path, std::string* output);
 
+// Output file which replaces the file at |path| only once it is committed, so that a failed write leaves an existing
+// file as it was. The output goes into a temporary file next to |path|, which Commit() renames over it and which is
+// removed if the object is destroyed before that.
+class OutputFile {
+ public:
+  explicit OutputFile(const std::string& path);
+  ~OutputFile();
+
+  OutputFile(const OutputFile&) = delete;
+  OutputFile& operator=(const OutputFile&) = delete;
+
+  bool Open();
+  // Valid after Open() until Commit().
+  int GetFd() const;
+  // File written until Commit(), e.g. to write it through a stream of its own, which must be closed before that.
+  const std::string& GetTemporaryPath() const;
+  bool Commit();
+
+ private:
+  std::string path_;
+  std::string temporary_path_;
+  int fd_ = -1;
+};
+
 }  // namespace utils
 }  // namespace lightex
@@ -0,0 +1,42 @@
+#include <lightex/utils/json_utils.h>
+
+#include <cstdio>
+
+namespace lightex {
+namespace utils {
+
+void WriteJsonString(const std::string& s, std::ostream* output) {
+  output->put('"');
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        *output << "\\\"";
+        break;
+
+      case '\\':
+        *output << "\\\\";
+        break;
+
+      case '\n':
+        *output << "\\n";
+        break;
+
+      case '\t':
+        *output << "\\t";
+        break;
+
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+          *output << buffer;
+        } else {
+          output->put(c);
+        }
+    }
+  }
+  output->put('"');
+}
+
+}  // namespace utils
+}  // namespace lightex
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+
+namespace lightex {
+namespace utils {
+
+// Writes |s| as a quoted JSON string. Bytes aren't validated as UTF-8, control characters are escaped.
+void WriteJsonString(const std::string& s, std::ostream* output);
+
+}  // namespace utils
+}  // namespace lightex
@@ -0,0 +1,123 @@
+#include <lightex/utils/output_writer.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace lightex {
+namespace utils {
+namespace {
+
+// Fragments up to this size are copied into the buffer of the writer.
+const std::size_t kMaxCopiedFragmentSize = 512;
+const std::size_t kBufferSize = 64 * 1024;
+// Pending fragments are written once there are this many of them, which writev(2) takes in a single call.
+#if defined(IOV_MAX)
+const std::size_t kMaxFragmentsNum = IOV_MAX;
+#else
+const std::size_t kMaxFragmentsNum = 1024;
+#endif
+}  // namespace
+
+OutputWriter::OutputWriter(int fd) : fd_(fd) {
+  buffer_.reserve(kBufferSize);
+}
+
+OutputWriter::OutputWriter(std::ostream* out) : out_(out) {}
+
+void OutputWriter::Append(const char* data, std::size_t size) {
+  if (!error_message_.empty() || size == 0) {
+    return;
+  }
+
+  if (out_) {
+    if (!out_->write(data, size)) {
+      Fail("Failed to write the output.");
+    }
+    return;
+  }
+
+  const bool is_copied = size <= kMaxCopiedFragmentSize;
+  if (fragments_.size() == kMaxFragmentsNum || (is_copied && buffer_.size() + size > kBufferSize)) {
+    WriteFragments();
+  }
+
+  if (!is_copied) {
+    fragments_.push_back({data, 0, size});
+    return;
+  }
+
+  // Copies which follow each other are written as one fragment.
+  if (fragments_.empty() || fragments_.back().data) {
+    fragments_.push_back({nullptr, buffer_.size(), 0});
+  }
+  buffer_.append(data, size);
+  fragments_.back().size += size;
+}
+
+void OutputWriter::Append(const std::string& data) {
+  Append(data.data(), data.size());
+}
+
+bool OutputWriter::Flush() {
+  if (out_ && error_message_.empty() && !out_->flush()) {
+    Fail("Failed to write the output.");
+  }
+  return WriteFragments();
+}
+
+const std::string& OutputWriter::GetErrorMessage() const {
+  return error_message_;
+}
+
+bool OutputWriter::WriteFragments() {
+  std::vector<iovec> iovecs;
+  iovecs.reserve(fragments_.size());
+  for (const Fragment& fragment : fragments_) {
+    const char* data = fragment.data ? fragment.data : buffer_.data() + fragment.offset;
+    iovecs.push_back({const_cast<char*>(data), fragment.size});
+  }
+  fragments_.clear();
+
+  // Partial writes leave the rest of the batch for the next call.
+  std::size_t first_iovec = 0;
+  while (error_message_.empty() && first_iovec < iovecs.size()) {
+    const int iovecs_num = static_cast<int>(std::min(iovecs.size() - first_iovec, kMaxFragmentsNum));
+    ssize_t written_size = writev(fd_, iovecs.data() + first_iovec, iovecs_num);
+    if (written_size < 0) {
+      if (errno != EINTR) {
+        Fail(std::string("Failed to write the output: ") + std::strerror(errno));
+      }
+      continue;
+    }
+    if (written_size == 0) {
+      Fail("Failed to write the output.");
+      continue;
+    }
+
+    while (first_iovec < iovecs.size() && static_cast<std::size_t>(written_size) >= iovecs[first_iovec].iov_len) {
+      written_size -= iovecs[first_iovec].iov_len;
+      ++first_iovec;
+    }
+    if (first_iovec < iovecs.size()) {
+      iovecs[first_iovec].iov_base = static_cast<char*>(iovecs[first_iovec].iov_base) + written_size;
+      iovecs[first_iovec].iov_len -= written_size;
+    }
+  }
+
+  buffer_.clear();
+  return error_message_.empty();
+}
+
+void OutputWriter::Fail(const std::string& error_message) {
+  if (error_message_.empty()) {
+    error_message_ = error_message;
+  }
+}
+
+}  // namespace utils
+}  // namespace lightex
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace lightex {
+namespace utils {
+
+// Collects the output as fragments and writes them in batches. Fragments given to a writer of a file descriptor are
+// kept by reference and written with a single writev(2) per batch, short ones excepted, which are copied into a buffer
+// of the writer as they cost less to copy than to describe. A writer of a stream writes every fragment through the
+// stream buffer instead. Failures are sticky: once a write fails, the following ones are skipped and Flush() fails.
+class OutputWriter {
+ public:
+  // The descriptor isn't closed by the writer.
+  explicit OutputWriter(int fd);
+  explicit OutputWriter(std::ostream* out);
+
+  OutputWriter(const OutputWriter&) = delete;
+  OutputWriter& operator=(const OutputWriter&) = delete;
+
+  // |data| must stay valid until the next Flush().
+  void Append(const char* data, std::size_t size);
+  void Append(const std::string& data);
+
+  // Writes all pending fragments, returns false if any write has failed.
+  bool Flush();
+
+  const std::string& GetErrorMessage() const;
+
+ private:
+  // Fragment in |buffer_| if |data| is nullptr, at |offset|.
+  struct Fragment {
+    const char* data;
+    std::size_t offset;
+    std::size_t size;
+  };
+
+  bool WriteFragments();
+  void Fail(const std::string& error_message);
+
+  int fd_ = -1;
+  std::ostream* out_ = nullptr;  // Not owned.
+
+  std::vector<Fragment> fragments_;
+  std::string buffer_;
+  std::string error_message_;
+};
+
+}  // namespace utils
+}  // namespace lightex
@@ -0,0 +1,94 @@
+#include <lightex/utils/rope.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <lightex/utils/text_utils.h>
+
+namespace lightex {
+namespace utils {
+namespace {
+
+// Joins up to this size are flattened.
+const std::size_t kMaxFlattenedSize = 256;
+}  // namespace
+
+Rope::Rope(ArenaString text) {
+  auto node = std::allocate_shared<Node>(ArenaAllocator<Node>());
+  node->text = std::move(text);
+  data_ = node->text.data();
+  size_ = node->text.size();
+  node_ = std::move(node);
+}
+
+Rope::Rope(Rope&& other) noexcept
+    : node_(std::move(other.node_)), data_(other.data_), size_(other.size_) {
+  other.data_ = "";
+  other.size_ = 0;
+}
+
+Rope& Rope::operator=(Rope&& other) noexcept {
+  if (this != &other) {
+    node_ = std::move(other.node_);
+    data_ = other.data_;
+    size_ = other.size_;
+    other.data_ = "";
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+Rope Rope::Reference(const char* data, std::size_t size) {
+  Rope rope;
+  rope.data_ = data;
+  rope.size_ = size;
+  return rope;
+}
+
+Rope Rope::Reference(const char* text) {
+  return Reference(text, std::strlen(text));
+}
+
+bool Rope::IsBlank() const {
+  return ForEachFragment([](const char* data, std::size_t size) { return IsBlankText(data, size); });
+}
+
+void RopeBuilder::Append(const Rope& rope) {
+  if (rope.empty()) {
+    return;
+  }
+
+  parts_.push_back(rope);
+  size_ += rope.size();
+  depth_ = std::max(depth_, rope.GetDepth());
+}
+
+Rope RopeBuilder::Build() {
+  Rope rope;
+  if (parts_.size() == 1) {
+    rope = std::move(parts_.front());
+  } else if (size_ <= kMaxFlattenedSize || depth_ >= Rope::kMaxDepth) {
+    ArenaString text;
+    text.reserve(size_);
+    for (const Rope& part : parts_) {
+      part.AppendTo(&text);
+    }
+    rope = Rope(std::move(text));
+  } else if (!parts_.empty()) {
+    auto node = std::allocate_shared<Rope::Node>(ArenaAllocator<Rope::Node>());
+    node->parts = std::move(parts_);
+    node->depth = depth_ + 1;
+    rope.node_ = std::move(node);
+    rope.data_ = nullptr;
+    rope.size_ = size_;
+  }
+
+  parts_.clear();
+  size_ = 0;
+  depth_ = 0;
+  return rope;
+}
+
+}  // namespace utils
+}  // namespace lightex
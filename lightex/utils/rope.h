@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <lightex/utils/arena.h>
+
+namespace lightex {
+namespace utils {
+
+// Immutable string of shared fragments, which copies and joins don't copy. Nodes are allocated like ArenaString.
+class Rope {
+ public:
+  // Joins nested deeper than this are flattened.
+  static constexpr int kMaxDepth = 32;
+
+  Rope() = default;
+  explicit Rope(ArenaString text);
+
+  // Moved-from ropes are empty.
+  Rope(const Rope& other) = default;
+  Rope(Rope&& other) noexcept;
+  Rope& operator=(const Rope& other) = default;
+  Rope& operator=(Rope&& other) noexcept;
+
+  // The referenced text must outlive the rope and its copies, e.g. a string literal.
+  static Rope Reference(const char* data, std::size_t size);
+  static Rope Reference(const char* text);
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool IsBlank() const;
+
+  // Calls |function| with the data and the size of every non-empty fragment in order until it returns false, returns
+  // false if it did. Fragments stay valid as long as the rope does.
+  template <typename Function>
+  bool ForEachFragment(const Function& function) const;
+
+  template <typename String>
+  void AppendTo(String* output) const {
+    output->reserve(output->size() + size_);
+    ForEachFragment([output](const char* data, std::size_t size) {
+      output->append(data, size);
+      return true;
+    });
+  }
+
+ private:
+  friend class RopeBuilder;
+
+  // Owned text of a flat rope or the parts of a join.
+  struct Node {
+    ArenaString text;
+    ArenaVector<Rope> parts;
+    int depth = 0;
+  };
+
+  int GetDepth() const { return data_ ? 0 : node_->depth; }
+
+  std::shared_ptr<const Node> node_;
+  // Text of a flat rope, nullptr for joins.
+  const char* data_ = "";
+  std::size_t size_ = 0;
+};
+
+// Joins ropes. Short and too deep joins are flattened into a copy, which costs less than their fragments.
+class RopeBuilder {
+ public:
+  void Append(const Rope& rope);
+  // Leaves the builder empty.
+  Rope Build();
+
+ private:
+  ArenaVector<Rope> parts_;
+  std::size_t size_ = 0;
+  int depth_ = 0;
+};
+
+template <typename Function>
+bool Rope::ForEachFragment(const Function& function) const {
+  if (data_) {
+    return size_ == 0 || function(data_, size_);
+  }
+
+  // Positions within the joins being traversed, one per level.
+  struct Position {
+    const Node* node;
+    std::size_t part_index;
+  };
+  Position stack[kMaxDepth + 1];
+  int stack_size = 0;
+  stack[stack_size++] = {node_.get(), 0};
+  while (stack_size > 0) {
+    Position& position = stack[stack_size - 1];
+    if (position.part_index == position.node->parts.size()) {
+      --stack_size;
+      continue;
+    }
+
+    const Rope& part = position.node->parts[position.part_index++];
+    if (!part.data_) {
+      stack[stack_size++] = {part.node_.get(), 0};
+    } else if (part.size_ > 0 && !function(part.data_, part.size_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace utils
+}  // namespace lightex
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace lightex {
+namespace utils {
+
+// SHA-256 (FIPS 180-4) of data given in any number of parts.
+class Sha256 {
+ public:
+  Sha256();
+
+  void Update(const char* data, std::size_t size);
+  void Update(const std::string& data);
+
+  // Returns the digest as 64 lowercase hex digits. The hasher can't be updated afterwards.
+  std::string FinishHex();
+
+ private:
+  void ProcessBlock(const unsigned char* block);
+
+  std::uint32_t state_[8];
+  unsigned char block_[64];
+  std::size_t block_size_ = 0;
+  std::uint64_t total_size_ = 0;
+};
+
+}  // namespace utils
+}  // namespace lightex
@@ -0,0 +1,203 @@
+#include <lightex/utils/text_utils.h>
+
+#include <cstddef>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace lightex {
+namespace utils {
+namespace {
+
+const std::size_t kBlockSize = 16;
+
+inline bool IsSpace(char c) {
+  return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+}
+
+inline bool IsSpecial(char c) {
+  switch (c) {
+    case '&':
+    case '\"':
+    case '\'':
+    case '<':
+    case '>':
+      return true;
+
+    default:
+      return IsSpace(c);
+  }
+}
+
+#if defined(__SSE2__)
+// Returns a bit mask with a bit set for every byte of the block that needs either escaping or white space collapsing.
+inline unsigned SpecialSymbolsMask(const char* block) {
+  const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+
+  __m128i special = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('&'));
+  special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\"')));
+  special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\'')));
+  special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('<')));
+  special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('>')));
+  special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')));
+
+  // '\t', '\n', '\v', '\f' and '\r' form a contiguous range, so an unsigned range check covers all of them.
+  const __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+  const __m128i range_limit = _mm_set1_epi8('\r' - '\t');
+  special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(shifted, range_limit), shifted));
+
+  return static_cast<unsigned>(_mm_movemask_epi8(special));
+}
+
+inline unsigned SpaceSymbolsMask(const char* block) {
+  const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+
+  const __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+  const __m128i range_limit = _mm_set1_epi8('\r' - '\t');
+  const __m128i space = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+                                     _mm_cmpeq_epi8(_mm_min_epu8(shifted, range_limit), shifted));
+
+  return static_cast<unsigned>(_mm_movemask_epi8(space));
+}
+#endif
+
+// Returns the position of the first symbol in [from, size) that needs special treatment, or |size| if there is none.
+std::size_t FindSpecialSymbol(const char* data, std::size_t from, std::size_t size) {
+#if defined(__SSE2__)
+  while (from + kBlockSize <= size) {
+    const unsigned mask = SpecialSymbolsMask(data + from);
+    if (mask != 0) {
+      return from + __builtin_ctz(mask);
+    }
+    from += kBlockSize;
+  }
+#endif
+
+  while (from < size && !IsSpecial(data[from])) {
+    ++from;
+  }
+  return from;
+}
+
+// Returns the position of the first space symbol in [from, size), or |size| if there is none.
+std::size_t FindSpaceSymbol(const char* data, std::size_t from, std::size_t size) {
+#if defined(__SSE2__)
+  while (from + kBlockSize <= size) {
+    const unsigned mask = SpaceSymbolsMask(data + from);
+    if (mask != 0) {
+      return from + __builtin_ctz(mask);
+    }
+    from += kBlockSize;
+  }
+#endif
+
+  while (from < size && !IsSpace(data[from])) {
+    ++from;
+  }
+  return from;
+}
+
+// Returns the position of the first non space symbol in [from, size), or |size| if there is none.
+std::size_t SkipSpaceSymbols(const char* data, std::size_t from, std::size_t size) {
+#if defined(__SSE2__)
+  while (from + kBlockSize <= size) {
+    const unsigned mask = SpaceSymbolsMask(data + from);
+    if (mask != 0xffff) {
+      return from + __builtin_ctz(~mask);
+    }
+    from += kBlockSize;
+  }
+#endif
+
+  while (from < size && IsSpace(data[from])) {
+    ++from;
+  }
+  return from;
+}
+}  // namespace
+
+void AppendFormattedHtml(const std::string& text, std::string* output) {
+  if (!output) {
+    return;
+  }
+
+  const char* data = text.data();
+  const std::size_t size = text.size();
+
+  // Escaping is rare in practice, so the unescaped size is a good estimate of the final one.
+  output->reserve(output->size() + size + size / 8);
+
+  std::size_t position = 0;
+  while (position < size) {
+    const std::size_t next_special = FindSpecialSymbol(data, position, size);
+    output->append(data + position, next_special - position);
+    if (next_special == size) {
+      break;
+    }
+
+    position = next_special;
+    switch (data[position]) {
+      case '&':
+        output->append("&amp;");
+        break;
+
+      case '\"':
+        output->append("&quot;");
+        break;
+
+      case '\'':
+        output->append("&apos;");
+        break;
+
+      case '<':
+        output->append("&lt;");
+        break;
+
+      case '>':
+        output->append("&gt;");
+        break;
+
+      default:
+        output->push_back(' ');
+        position = SkipSpaceSymbols(data, position, size);
+        continue;
+    }
+    ++position;
+  }
+}
+
+void AppendCollapsedText(const std::string& text, std::string* output) {
+  if (!output) {
+    return;
+  }
+
+  const char* data = text.data();
+  const std::size_t size = text.size();
+
+  std::size_t position = 0;
+  if (!output->empty() && IsSpace(output->back())) {
+    position = SkipSpaceSymbols(data, position, size);
+  }
+
+  while (position < size) {
+    const std::size_t next_space = FindSpaceSymbol(data, position, size);
+    output->append(data + position, next_space - position);
+    if (next_space == size) {
+      break;
+    }
+
+    output->push_back(' ');
+    position = SkipSpaceSymbols(data, next_space, size);
+  }
+}
+
+bool IsBlankText(const std::string& text) {
+  return IsBlankText(text.data(), text.size());
+}
+
+bool IsBlankText(const char* data, std::size_t size) {
+  return SkipSpaceSymbols(data, 0, size) == size;
+}
+}  // namespace utils
+}  // namespace lightex
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+namespace lightex {
+namespace utils {
+
+// Collapses every run of white space characters into a single space and escapes HTML special characters in one
+// pass, appending the result to |output|.
+void AppendFormattedHtml(const std::string& text, std::string* output);
+
+// Collapses every run of white space characters into a single space, appending the result to |output|. A leading run
+// is dropped altogether if |output| already ends with white space.
+void AppendCollapsedText(const std::string& text, std::string* output);
+
+// Returns true if the text consists of white space characters only (i.e. formats into "" or " ").
+bool IsBlankText(const std::string& text);
+bool IsBlankText(const char* data, std::size_t size);
+
+}  // namespace utils
+}  // namespace lightex
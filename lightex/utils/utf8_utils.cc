@@ -0,0 +1,148 @@
+#include <lightex/utils/utf8_utils.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace lightex {
+namespace utils {
+namespace {
+
+const std::size_t kBlockSize = 16;
+
+inline bool IsContinuationByte(unsigned char c) {
+  return (c & 0xc0) == 0x80;
+}
+
+// Returns the size of the valid multibyte sequence starting at |position|, or 0 if it is invalid.
+std::size_t GetSequenceSize(const unsigned char* data, std::size_t position, std::size_t size) {
+  const unsigned char lead = data[position];
+
+  std::size_t sequence_size;
+  // Allowed range of the second byte, which rules out overlong forms, surrogates and code points beyond U+10FFFF.
+  unsigned char second_min = 0x80;
+  unsigned char second_max = 0xbf;
+  if (lead >= 0xc2 && lead <= 0xdf) {
+    sequence_size = 2;
+  } else if (lead >= 0xe0 && lead <= 0xef) {
+    sequence_size = 3;
+    if (lead == 0xe0) {
+      second_min = 0xa0;
+    } else if (lead == 0xed) {
+      second_max = 0x9f;
+    }
+  } else if (lead >= 0xf0 && lead <= 0xf4) {
+    sequence_size = 4;
+    if (lead == 0xf0) {
+      second_min = 0x90;
+    } else if (lead == 0xf4) {
+      second_max = 0x8f;
+    }
+  } else {
+    return 0;
+  }
+
+  if (position + sequence_size > size || data[position + 1] < second_min || data[position + 1] > second_max) {
+    return 0;
+  }
+  for (std::size_t i = 2; i < sequence_size; ++i) {
+    if (!IsContinuationByte(data[position + i])) {
+      return 0;
+    }
+  }
+
+  return sequence_size;
+}
+
+#if defined(__SSE2__)
+// Returns a bit mask with a bit set for every byte of the block that is either non-ASCII or '\r'.
+inline unsigned SpecialBytesMask(const unsigned char* block) {
+  const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+  const __m128i special = _mm_or_si128(chunk, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')));
+
+  return static_cast<unsigned>(_mm_movemask_epi8(special));
+}
+#endif
+
+// Returns the position of the first non-ASCII or '\r' byte in [from, size), or |size| if there is none.
+std::size_t FindSpecialByte(const unsigned char* data, std::size_t from, std::size_t size) {
+#if defined(__SSE2__)
+  while (from + kBlockSize <= size) {
+    const unsigned mask = SpecialBytesMask(data + from);
+    if (mask != 0) {
+      return from + __builtin_ctz(mask);
+    }
+    from += kBlockSize;
+  }
+#endif
+
+  while (from < size && data[from] < 0x80 && data[from] != '\r') {
+    ++from;
+  }
+  return from;
+}
+}  // namespace
+
+bool NormalizeUtf8Input(const std::string& input, std::string* output, std::size_t* invalid_offset) {
+  if (!output) {
+    return false;
+  }
+
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(input.data());
+  const std::size_t size = input.size();
+
+  output->clear();
+  output->reserve(size);
+
+  // Bytes are copied in runs, which end only at line endings to rewrite.
+  std::size_t run_first = 0;
+  std::size_t position = FindSpecialByte(data, 0, size);
+  while (position < size) {
+    if (data[position] == '\r') {
+      output->append(input, run_first, position - run_first);
+      *output += '\n';
+      ++position;
+      if (position < size && data[position] == '\n') {
+        ++position;
+      }
+      run_first = position;
+    } else {
+      const std::size_t sequence_size = GetSequenceSize(data, position, size);
+      if (sequence_size == 0) {
+        if (invalid_offset) {
+          *invalid_offset = position;
+        }
+        return false;
+      }
+      position += sequence_size;
+    }
+
+    position = FindSpecialByte(data, position, size);
+  }
+  output->append(input, run_first, size - run_first);
+
+  return true;
+}
+
+std::size_t GetNormalizablePrefixSize(const std::string& input) {
+  const std::size_t size = input.size();
+  if (size > 0 && input[size - 1] == '\r') {
+    return size - 1;
+  }
+
+  // Looks for the lead byte of the last sequence among the bytes which could still be continued.
+  for (std::size_t i = 1; i <= 3 && i <= size; ++i) {
+    const unsigned char c = input[size - i];
+    if (IsContinuationByte(c)) {
+      continue;
+    }
+
+    const std::size_t sequence_size = c >= 0xf0 ? 4 : (c >= 0xe0 ? 3 : (c >= 0xc0 ? 2 : 1));
+    return sequence_size > i ? size - i : size;
+  }
+
+  return size;
+}
+
+}  // namespace utils
+}  // namespace lightex
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace lightex {
+namespace utils {
+
+// Checks that the input is well-formed UTF-8 (no overlong forms, surrogates or code points beyond U+10FFFF) and
+// converts "\r\n" and lone "\r" line endings into "\n", writing the result into |output|. On failure stores the byte
+// offset of the first invalid sequence in the input into |invalid_offset|.
+bool NormalizeUtf8Input(const std::string& input, std::string* output, std::size_t* invalid_offset);
+
+// Size of the prefix of |input| that normalizes the same way whatever follows it, i.e. without a trailing "\r" or
+// trailing bytes of an incomplete multibyte sequence. Lets inputs read in pieces be normalized piece by piece.
+std::size_t GetNormalizablePrefixSize(const std::string& input);
+
+}  // namespace utils
+}  // namespace lightex
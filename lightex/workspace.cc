@@ -1,135 +1,105 @@
 #include <lightex/workspace.h>
 
-#include <map>
-#include <mutex>
-
 #include <lightex/ast/ast.h>
-#include <lightex/dot_converter/dot_visitor.h>
-#include <lightex/html_converter/html_visitor.h>
-#include <lightex/grammar/grammar.h>
-#include <lightex/utils/file_utils.h>
-
-#include <boost/spirit/home/x3.hpp>
+#include <lightex/ast/symbol_table.h>
+#include <lightex/backends/backends.h>
+#include <lightex/engine/engine.h>
 
 namespace lightex {
 namespace {
 
-const char kSyntaxParsingError[] = "Error while running syntax analysis! Failed on the following snippet: ";
-const int kFailedSnippetLength = 30;
-
-namespace x3 = boost::spirit::x3;
-
-bool ParseProgramToAst(const std::string& input, std::string* error_message, ast::Program* output) {
-  if (!output) {
-    return false;
-  }
-
-  std::string::const_iterator start = input.begin();
-  std::string::const_iterator iter = start;
-  std::string::const_iterator end = input.end();
-  if (!x3::phrase_parse(iter, end, grammar::program, x3::space, *output) || iter < end) {
-    if (error_message) {
-      std::size_t failed_at = iter - start;
-      *error_message = kSyntaxParsingError;
-      *error_message = input.substr(failed_at, failed_at + kFailedSnippetLength);
-      if (failed_at + kFailedSnippetLength + 1 < input.size()) {
-        *error_message += "...";
-      }
-    }
-    return false;
-  }
-
-  return true;
-}
-
-class DotWorkspace : public Workspace {
+class WorkspaceImpl : public Workspace {
  public:
-  ~DotWorkspace() {}
+  WorkspaceImpl(std::shared_ptr<engine::Engine> engine, std::shared_ptr<const backends::Backend> backend)
+      : engine_(engine), backend_(backend) {}
+  ~WorkspaceImpl() {}
 
   bool LoadStyle(const std::string& style_file_path, std::string* error_message) override {
-    return false;
+    return engine_->LoadStyle(style_file_path, error_message);
   }
 
   bool ParseProgram(const std::string& input, std::string* error_message, std::string* output) override {
-    ast::Program ast;
-    if (!ParseProgramToAst(input, error_message, &ast)) {
+    if (!output) {
       return false;
     }
 
-    *output += "digraph d {\n";
-    dot_converter::DotVisitor visitor(output);
-    visitor(ast);
-    *output += "}\n";
+    std::shared_ptr<const style_cache::CompiledStyle> style = engine_->GetLoadedStyle();
+    ast::SymbolTable symbol_table(style->symbol_table.get());
+    ast::Program ast;
+    if (!engine_->ParseProgramToAst(input, &symbol_table, error_message, &ast)) {
+      return false;
+    }
 
-    return true;
+    return backend_->Render(*engine_, *style, symbol_table, ast, error_message, output);
   }
-};
 
-class HtmlWorkspace : public Workspace {
- public:
-  ~HtmlWorkspace() {}
-
-  bool LoadStyle(const std::string& style_file_path, std::string* error_message) override {
-    std::string input;
-    if (!lightex::utils::ReadDataFromFile(style_file_path, &input)) {
+  bool ParseProgramToWriter(const std::string& input,
+                            utils::OutputWriter* writer,
+                            std::string* error_message) override {
+    if (!writer) {
       return false;
     }
 
+    std::shared_ptr<const style_cache::CompiledStyle> style = engine_->GetLoadedStyle();
+    ast::SymbolTable symbol_table(style->symbol_table.get());
     ast::Program ast;
-    if (!ParseProgramToAst(input, error_message, &ast)) {
-      return false;
-    }
-
-    std::unique_lock<std::mutex> lock(mtx_);
-    html_converter::HtmlVisitor visitor_copy = visitor_;
-    html_converter::Result result = visitor_copy(ast);
-    if (!result.is_successful) {
-      if (error_message) {
-        *error_message = result.error_message;
-      }
+    if (!engine_->ParseProgramToAst(input, &symbol_table, error_message, &ast)) {
       return false;
     }
-    visitor_ = visitor_copy;
 
-    return true;
+    return backend_->RenderToWriter(*engine_, *style, symbol_table, ast, error_message, writer);
   }
 
-  bool ParseProgram(const std::string& input, std::string* error_message, std::string* output) override {
+  bool ParseProgramWithStyle(const std::string& style_file_path,
+                             const std::string& input,
+                             std::string* error_message,
+                             std::string* output) override {
     if (!output) {
       return false;
     }
 
-    ast::Program ast;
-    if (!ParseProgramToAst(input, error_message, &ast)) {
+    std::shared_ptr<const style_cache::CompiledStyle> style = engine_->GetStyle(style_file_path, error_message);
+    if (!style) {
       return false;
     }
 
-    html_converter::HtmlVisitor visitor_copy = visitor_;
-    html_converter::Result result = visitor_copy(ast);
-    if (!result.is_successful) {
-      if (error_message) {
-        *error_message = result.error_message;
-      }
+    ast::SymbolTable symbol_table(style->symbol_table.get());
+    ast::Program ast;
+    if (!engine_->ParseProgramToAst(input, &symbol_table, error_message, &ast)) {
       return false;
     }
 
-    if (output) {
-      *output = result.escaped;
-    }
-    return true;
+    return backend_->Render(*engine_, *style, symbol_table, ast, error_message, output);
   }
 
  private:
-  html_converter::HtmlVisitor visitor_;
-  std::mutex mtx_;
+  std::shared_ptr<engine::Engine> engine_;
+  std::shared_ptr<const backends::Backend> backend_;
 };
 }  // namespace
 
+std::shared_ptr<Workspace> MakeWorkspace(std::shared_ptr<engine::Engine> engine,
+                                         std::shared_ptr<const backends::Backend> backend) {
+  return std::make_shared<WorkspaceImpl>(engine, backend);
+}
+
 std::shared_ptr<Workspace> MakeDotWorkspace() {
-  return std::make_shared<DotWorkspace>();
+  return MakeWorkspace(std::make_shared<engine::Engine>(), backends::MakeDotBackend());
 }
 
 std::shared_ptr<Workspace> MakeHtmlWorkspace() {
-  return std::make_shared<HtmlWorkspace>();
+  return MakeWorkspace(std::make_shared<engine::Engine>(), backends::MakeHtmlBackend());
+}
+
+std::shared_ptr<Workspace> MakeTextWorkspace() {
+  return MakeWorkspace(std::make_shared<engine::Engine>(), backends::MakeTextBackend());
+}
+
+std::shared_ptr<Workspace> MakeJsonAstWorkspace(int max_depth) {
+  return MakeWorkspace(std::make_shared<engine::Engine>(), backends::MakeJsonAstBackend(max_depth));
+}
+
+std::shared_ptr<Workspace> MakeBinaryAstWorkspace(int max_depth) {
+  return MakeWorkspace(std::make_shared<engine::Engine>(), backends::MakeBinaryAstBackend(max_depth));
 }
 }  // namespace lightex
@@ -5,6 +5,15 @@
 #include <string>
 
 namespace lightex {
+namespace backends {
+class Backend;
+}  // namespace backends
+namespace engine {
+class Engine;
+}  // namespace engine
+namespace utils {
+class OutputWriter;
+}  // namespace utils
 
 class Workspace {
  public:
@@ -12,9 +21,32 @@ class Workspace {
 
   virtual bool LoadStyle(const std::string& style_file_path, std::string* error_message) = 0;
   virtual bool ParseProgram(const std::string& input, std::string* error_message, std::string* output) = 0;
+
+  // Same as ParseProgram, but writes the output to |writer| and flushes it.
+  virtual bool ParseProgramToWriter(const std::string& input,
+                                    utils::OutputWriter* writer,
+                                    std::string* error_message) = 0;
+
+  // Same as ParseProgram, but with the style in |style_file_path| instead of the loaded one. Thread safe.
+  virtual bool ParseProgramWithStyle(const std::string& style_file_path,
+                                     const std::string& input,
+                                     std::string* error_message,
+                                     std::string* output) = 0;
 };
 
+// Workspace which parses with |engine| and renders with |backend| (see backends/backends.h). The engine holds the
+// loaded style and the parsing settings, and can be shared with other workspaces and with the stream, patch and
+// fan-out renderers (see stream_renderer/, patch_renderer/ and backends/fan_out.h).
+std::shared_ptr<Workspace> MakeWorkspace(std::shared_ptr<engine::Engine> engine,
+                                         std::shared_ptr<const backends::Backend> backend);
+
+// Workspaces with an engine of their own, whose ParseProgram renders with the given backend.
 std::shared_ptr<Workspace> MakeDotWorkspace();
 std::shared_ptr<Workspace> MakeHtmlWorkspace();
+std::shared_ptr<Workspace> MakeTextWorkspace();
+
+// Workspaces that export the parsed AST, skipping subtrees deeper than |max_depth| (see ast_exporter/ast_exporter.h).
+std::shared_ptr<Workspace> MakeJsonAstWorkspace(int max_depth = -1);
+std::shared_ptr<Workspace> MakeBinaryAstWorkspace(int max_depth = -1);
 
 }  // namespace lightex
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+./build/parse_program_to_ast samples/input.tex samples/output.jsonl
@@ -1,5 +1,26 @@
 #define BOOST_TEST_MAIN
 
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include <lightex/ast/symbol_table.h>
+#include <lightex/backends/backends.h>
+#include <lightex/backends/fan_out.h>
+#include <lightex/c_api/c_api.h>
+#include <lightex/engine/engine.h>
+#include <lightex/html_converter/macro_profiler.h>
+#include <lightex/lexer/lexer.h>
+#include <lightex/lexer/paragraph_splitter.h>
+#include <lightex/patch_renderer/patch_renderer.h>
+#include <lightex/stream_renderer/stream_renderer.h>
+#include <lightex/utils/arena.h>
+#include <lightex/utils/file_utils.h>
+#include <lightex/utils/output_writer.h>
+#include <lightex/utils/rope.h>
+#include <lightex/utils/sha256.h>
 #include <lightex/workspace.h>
 
 #include <boost/test/unit_test.hpp>
@@ -84,3 +105,725 @@ BOOST_AUTO_TEST_CASE(TestEscaping) {
   t.fail("\\a");
   t.check("\\\\", "<p>\\</p>");
 }
+
+BOOST_AUTO_TEST_CASE(TestHtmlEntities) {
+  Tester t;
+  t.check("&mdash;", "<p>&mdash;</p>");
+  t.check("a&nbsp;b&frac12;", "<p>a&nbsp;b&frac12;</p>");
+  t.check("&CounterClockwiseContourIntegral;", "<p>&CounterClockwiseContourIntegral;</p>");
+  t.check("a \\&mdash;", "<p>a &amp;mdash;</p>");
+  t.check("\\&lt;", "<p>&amp;lt;</p>");
+  t.check("\\newcommand{\\x}[1]{#1}\\x{\\&lt;} \\x{&lt;}", "<p>&amp;lt; &lt;</p>");
+  t.fail("&foo;");
+  t.fail("&mdash");
+  t.fail("&;");
+  t.fail("&CounterClockwiseContourIntegralX;");
+}
+
+BOOST_AUTO_TEST_CASE(TestWhitespaceCollapsing) {
+  Tester t;
+  t.check("a \t\n b", "<p>a b</p>");
+  t.check("<a>  \\&  \"b\"", "<p>&lt;a&gt; &amp; &quot;b&quot;</p>");
+  t.check("0123456789abcdef  \t  0123456789abcdef<<0123456789", "<p>0123456789abcdef 0123456789abcdef&laquo;0123456789</p>");
+  t.check("0123456789abcdef                                   x", "<p>0123456789abcdef x</p>");
+}
+
+BOOST_AUTO_TEST_CASE(TestLazyArguments) {
+  Tester t;
+  t.check("\\newcommand{\\first}[2]{#1}\\first{a}{\\undefined}", "<p>a</p>");
+  t.check("\\newcommand{\\twice}[2][x]{#1#2#2}\\twice{y}", "<p>xyy</p>");
+  t.check("\\newcommand{\\twice}[2][x]{#1#2#2}\\twice[z]{y}", "<p>zyy</p>");
+  t.check("\\newcommand{\\x}{outer}\\newenvironment{e}[1]{\\newcommand{\\x}{inner}#1\\x}{}\\begin{e}{\\x}\\end{e}",
+          "outerinner");
+  t.check("\\newcommand{\\inner}[1]{(#1)}\\newcommand{\\outer}[1]{\\inner{#1#1}}\\outer{a}", "<p>(aa)</p>");
+  t.fail("\\newcommand{\\first}[2]{#1#2}\\first{a}{\\undefined}");
+
+  // Math formulas of arguments are numbered when the arguments are first referenced, and not at all if they aren't.
+  std::string error_message;
+  std::string output;
+  BOOST_CHECK(lightex::MakeHtmlWorkspace()->ParseProgram("\\newcommand{\\swap}[3]{#3#2}\\swap{$a$}{$b$}{$c$}",
+                                                         &error_message, &output));
+  BOOST_CHECK(output.find("katex.render(\"c\", document.getElementById(\"mathTextSpan1\")") != std::string::npos);
+  BOOST_CHECK(output.find("katex.render(\"b\", document.getElementById(\"mathTextSpan2\")") != std::string::npos);
+  BOOST_CHECK(output.find("mathTextSpan3") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(TestNestedDefinitions) {
+  Tester t;
+  const std::string definitions =
+      "\\newenvironment{list}{\\newcommand{\\i}{*}}{.}"
+      "\\newenvironment{outer}[1]{\\newenvironment{inner}{\\newcommand{\\x}[1]{#1}##1}{}}{}";
+  t.check(definitions + "\\begin{list}\\i a\\i b\\end{list}\\begin{list}\\i c\\end{list}", "<p>* a* b</p>.<p>* c</p>.");
+  t.check(definitions + "\\begin{outer}{p}\\begin{inner}\\x{1}\\x{2}\\end{inner}\\end{outer}"
+          "\\begin{outer}{q}\\begin{inner}\\x{3}\\end{inner}\\end{outer}", "p<p>12</p>q<p>3</p>");
+  t.fail(definitions + "\\begin{list}\\i\\end{list}\\i");
+}
+
+BOOST_AUTO_TEST_CASE(TestNearMissConstructs) {
+  Tester t;
+  t.check("a-b<c>d", "<p>a-b&lt;c&gt;d</p>");
+  t.check("a--b---c", "<p>a&ndash;b&mdash;c</p>");
+  t.check("a\n--b", "<p>a &ndash;b</p>");
+  t.check(" \\begin{verbatim}v\\end{verbatim}", " <pre>v</pre>");
+  t.check("\\newcommand{\\x}[1]{#1}\\x{a}", "<p>a</p>");
+  t.fail("\\beginx");
+  t.fail("\\newcommandx");
+  t.fail("\\unescapedx");
+  t.fail("$$x");
+
+  // The worst case for a backtracking grammar: every node starts like some other kind of node.
+  std::string input;
+  std::string expected_output;
+  for (int i = 0; i < 1000; ++i) {
+    input += "a-b << c \\unescaped{<d>} %e\n\\begin{verbatim}f\\end{verbatim}\n\n";
+    expected_output += "<p>a-b &laquo; c <d> </p><pre>f</pre>";
+  }
+  t.check(input, expected_output);
+}
+
+BOOST_AUTO_TEST_CASE(TestNestingLimits) {
+  std::string deep_input;
+  for (int i = 0; i < 200; ++i) {
+    deep_input = "\\unescaped{" + deep_input + "}";
+  }
+  deep_input += "x";
+
+  // A chain of 500 macros, each calling the previous one.
+  const auto macro_name = [](int i) {
+    std::string name = "\\m";
+    for (; i > 0; i /= 26) {
+      name += static_cast<char>('a' + i % 26);
+    }
+    return name;
+  };
+  std::string chain_input = "\\newcommand{" + macro_name(0) + "}{x}";
+  for (int i = 1; i < 500; ++i) {
+    chain_input += "\\newcommand{" + macro_name(i) + "}{" + macro_name(i - 1) + "}";
+  }
+  chain_input += macro_name(499);
+
+  auto engine = std::make_shared<lightex::engine::Engine>();
+  std::shared_ptr<lightex::Workspace> workspace = lightex::MakeWorkspace(engine, lightex::backends::MakeHtmlBackend());
+  std::string error_message;
+  std::string output;
+  BOOST_CHECK(workspace->ParseProgram(deep_input, &error_message, &output));
+  BOOST_CHECK_EQUAL(output, "<p>x</p>");
+
+  engine->SetNestingLimits(128, 1024);
+  BOOST_CHECK(!workspace->ParseProgram(deep_input, &error_message, &output));
+  BOOST_CHECK_EQUAL(error_message, "Input is nested deeper than 128 levels at offset 1418.");
+
+  BOOST_CHECK(!workspace->ParseProgram("\\newcommand{\\r}{a\\r}\\r", &error_message, &output));
+  BOOST_CHECK_EQUAL(error_message, "Command macro r is nested deeper than 1024 expansions.");
+  BOOST_CHECK(workspace->ParseProgram(chain_input, &error_message, &output));
+  BOOST_CHECK_EQUAL(output, "<p>x</p>");
+
+  engine->SetNestingLimits(-1, 100);
+  BOOST_CHECK(workspace->ParseProgram(deep_input, &error_message, &output));
+  BOOST_CHECK_EQUAL(output, "<p>x</p>");
+  BOOST_CHECK(!workspace->ParseProgram(chain_input, &error_message, &output));
+  // The 101st expansion of the chain.
+  BOOST_CHECK_EQUAL(error_message,
+                    "Command macro " + macro_name(399).substr(1) + " is nested deeper than 100 expansions.");
+}
+
+BOOST_AUTO_TEST_CASE(TestJsonAstExport) {
+  std::shared_ptr<lightex::Workspace> workspace = lightex::MakeJsonAstWorkspace();
+  std::string error_message;
+  std::string output;
+  BOOST_CHECK(workspace->ParseProgram("a\\textbf{b}", &error_message, &output));
+  BOOST_CHECK_EQUAL(output,
+                    "{\"id\":0,\"parent\":-1,\"role\":\"root\",\"type\":\"PROGRAM\",\"first\":0,\"last\":11}\n"
+                    "{\"id\":1,\"parent\":0,\"role\":\"node\",\"type\":\"PARAGRAPH\",\"first\":0,\"last\":11}\n"
+                    "{\"id\":2,\"parent\":1,\"role\":\"node\",\"type\":\"PLAIN_TEXT\",\"first\":0,\"last\":1,"
+                    "\"text\":\"a\"}\n"
+                    "{\"id\":3,\"parent\":1,\"role\":\"node\",\"type\":\"COMMAND\",\"first\":1,\"last\":11,"
+                    "\"name\":\"textbf\"}\n"
+                    "{\"id\":4,\"parent\":3,\"role\":\"argument\",\"type\":\"ARGUMENT\",\"first\":9,\"last\":10}\n"
+                    "{\"id\":5,\"parent\":4,\"role\":\"node\",\"type\":\"PLAIN_TEXT\",\"first\":9,\"last\":10,"
+                    "\"text\":\"b\"}\n");
+
+  workspace = lightex::MakeJsonAstWorkspace(1);
+  output.clear();
+  BOOST_CHECK(workspace->ParseProgram("a\\textbf{b}", &error_message, &output));
+  BOOST_CHECK_EQUAL(output,
+                    "{\"id\":0,\"parent\":-1,\"role\":\"root\",\"type\":\"PROGRAM\",\"first\":0,\"last\":11}\n"
+                    "{\"id\":1,\"parent\":0,\"role\":\"node\",\"type\":\"PARAGRAPH\",\"first\":0,\"last\":11}\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestSha256) {
+  const auto digest = [](const std::string& data) {
+    lightex::utils::Sha256 hasher;
+    hasher.Update(data);
+    return hasher.FinishHex();
+  };
+
+  BOOST_CHECK_EQUAL(digest(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  BOOST_CHECK_EQUAL(digest("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  BOOST_CHECK_EQUAL(digest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+                    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+  lightex::utils::Sha256 hasher;
+  for (int i = 0; i < 1000; ++i) {
+    hasher.Update(std::string(1000, 'a'));
+  }
+  BOOST_CHECK_EQUAL(hasher.FinishHex(), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+BOOST_AUTO_TEST_CASE(TestAstCache) {
+  const std::string cache_directory = "lightex_test_ast_cache";
+  const std::string input = "\\newcommand{\\x}[2][a]{#1-#2}\\x{b} $y$\n\n\\begin{verbatim}z\\end{verbatim}";
+
+  std::string error_message;
+  std::string expected_output;
+  BOOST_CHECK(lightex::MakeJsonAstWorkspace()->ParseProgram(input, &error_message, &expected_output));
+
+  for (int run = 0; run < 2; ++run) {
+    auto engine = std::make_shared<lightex::engine::Engine>();
+    BOOST_CHECK(engine->EnableAstCache(cache_directory, 1 << 20, &error_message));
+
+    std::string output;
+    BOOST_CHECK(lightex::MakeWorkspace(engine, lightex::backends::MakeJsonAstBackend(-1))
+                    ->ParseProgram(input, &error_message, &output));
+    BOOST_CHECK_EQUAL(output, expected_output);
+  }
+
+  lightex::engine::Engine engine;
+  BOOST_CHECK(!engine.ClearAstCache(&error_message));
+  BOOST_CHECK(engine.EnableAstCache(cache_directory, 1 << 20, &error_message));
+  BOOST_CHECK(engine.ClearAstCache(&error_message));
+  std::remove(cache_directory.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(TestStyleCache) {
+  const std::vector<std::string> style_paths = {"lightex_test_style_a.sty", "lightex_test_style_b.sty"};
+  for (std::size_t i = 0; i < style_paths.size(); ++i) {
+    std::ofstream out(style_paths[i]);
+    out << "\\newcommand{\\x}{" << i << "}";
+  }
+
+  auto engine = std::make_shared<lightex::engine::Engine>();
+  std::shared_ptr<lightex::Workspace> workspace = lightex::MakeWorkspace(engine, lightex::backends::MakeHtmlBackend());
+  std::string error_message;
+  for (int i = 0; i < 6; ++i) {
+    std::string output;
+    BOOST_CHECK(workspace->ParseProgramWithStyle(style_paths[i % 2], "\\x", &error_message, &output));
+    BOOST_CHECK_EQUAL(output, "<p>" + std::to_string(i % 2) + "</p>");
+  }
+
+  std::string output;
+  BOOST_CHECK(!workspace->ParseProgramWithStyle("lightex_test_missing.sty", "\\x", &error_message, &output));
+  BOOST_CHECK(!workspace->ParseProgram("\\x", &error_message, &output));
+
+  lightex::style_cache::Stats stats = engine->GetStyleCacheStats();
+  BOOST_CHECK_EQUAL(stats.hits_num, 4);
+  BOOST_CHECK_EQUAL(stats.misses_num, 3);
+  BOOST_CHECK_EQUAL(stats.styles_num, 2);
+
+  // Only the most recently used style fits.
+  engine->SetStyleCacheMaxSizeBytes(stats.size_bytes / 2);
+  BOOST_CHECK(workspace->ParseProgramWithStyle(style_paths[1], "\\x", &error_message, &output));
+  stats = engine->GetStyleCacheStats();
+  BOOST_CHECK_EQUAL(stats.hits_num, 5);
+  BOOST_CHECK_EQUAL(stats.evictions_num, 1);
+  BOOST_CHECK_EQUAL(stats.styles_num, 1);
+
+  for (const auto& style_path : style_paths) {
+    std::remove(style_path.c_str());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestConstantMacroFolding) {
+  const std::string style_path = "lightex_test_style_folding.sty";
+  {
+    std::ofstream out(style_path);
+    out << "\\newcommand{\\a}{A}\\newcommand{\\s}[1]{(#1)}\\newcommand{\\b}{\\s{\\a}}"
+        << "\\newcommand{\\m}{$x$}\\newenvironment{e}{\\unescaped{<div>}}{\\unescaped{</div>}}";
+  }
+
+  std::shared_ptr<lightex::Workspace> workspace = lightex::MakeHtmlWorkspace();
+  std::string error_message;
+  std::string output;
+  BOOST_CHECK(workspace->ParseProgramWithStyle(style_path, "\\b \\begin{e}\\a\\end{e}", &error_message, &output));
+  BOOST_CHECK_EQUAL(output, "<p>(A) </p><div><p>A</p></div>");
+
+  // Definitions made by the document shadow the ones the stored outputs were rendered with.
+  BOOST_CHECK(workspace->ParseProgramWithStyle(style_path, "\\newcommand{\\a}{Z}\\b", &error_message, &output));
+  BOOST_CHECK_EQUAL(output, "<p>(Z)</p>");
+
+  // Math formulas are numbered, so macros rendering them are expanded every time.
+  BOOST_CHECK(workspace->ParseProgramWithStyle(style_path, "\\m\\m", &error_message, &output));
+  BOOST_CHECK(output.find("mathTextSpan2") != std::string::npos);
+
+  std::remove(style_path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(TestCApi) {
+  BOOST_CHECK_EQUAL(lightex_get_api_version(), LIGHTEX_C_API_VERSION);
+  BOOST_CHECK(!lightex_workspace_create(static_cast<lightex_backend>(-1)));
+
+  lightex_workspace* workspace = lightex_workspace_create(LIGHTEX_BACKEND_HTML);
+  BOOST_REQUIRE(workspace);
+
+  const std::string input = "\\newcommand{\\x}{ab}\\x";
+  char* output = nullptr;
+  std::size_t output_size = 0;
+  char* error_message = nullptr;
+  BOOST_CHECK(lightex_workspace_render(workspace, input.data(), input.size(), &output, &output_size, &error_message));
+  BOOST_CHECK_EQUAL(std::string(output, output_size), "<p>ab</p>");
+  lightex_free(output);
+
+  BOOST_CHECK(!lightex_workspace_render(workspace, "&", 1, &output, &output_size, &error_message));
+  BOOST_CHECK(error_message && *error_message);
+  lightex_free(error_message);
+
+  BOOST_CHECK(lightex_workspace_render_patch(workspace, "doc", "a", 1, &output, &output_size, &error_message));
+  BOOST_CHECK_EQUAL(std::string(output, output_size),
+                    "{\"op\":\"insert\",\"id\":1,\"after\":0,\"html\":\"<p>a</p>\"}\n");
+  lightex_free(output);
+  lightex_workspace_forget_document(workspace, "doc");
+
+  BOOST_CHECK(!lightex_workspace_load_style(workspace, "lightex_test_missing.sty", nullptr));
+  lightex_style_cache_stats stats;
+  lightex_workspace_get_style_cache_stats(workspace, &stats);
+  BOOST_CHECK_EQUAL(stats.styles_num, 0);
+
+  lightex_workspace_free(workspace);
+}
+
+BOOST_AUTO_TEST_CASE(TestArena) {
+  lightex::utils::ArenaString heap_string(100, 'h');
+  BOOST_CHECK(!heap_string.get_allocator().GetArena());
+
+  std::size_t reserved_bytes = 0;
+  {
+    lightex::utils::Arena arena;
+    lightex::utils::ArenaScope arena_scope(&arena);
+
+    lightex::utils::ArenaString arena_string = heap_string;
+    BOOST_CHECK_EQUAL(arena_string.get_allocator().GetArena(), &arena);
+    BOOST_CHECK_EQUAL(arena_string, heap_string);
+
+    lightex::utils::ArenaVector<int> numbers(1 << 20, 1);
+    BOOST_CHECK_EQUAL(numbers.back(), 1);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(numbers.data()) % alignof(int), 0);
+    reserved_bytes = arena.GetReservedBytes();
+    BOOST_CHECK(reserved_bytes >= (1 << 20) * sizeof(int));
+  }
+  BOOST_CHECK(!lightex::utils::ArenaScope::GetCurrentArena());
+
+  // The next arenas of the thread reuse the blocks.
+  const std::size_t cached_bytes = lightex::utils::Arena::GetThreadCachedBytes();
+  BOOST_CHECK(cached_bytes >= reserved_bytes);
+  {
+    lightex::utils::Arena arena;
+    BOOST_CHECK(arena.Allocate(101, 1));
+    BOOST_CHECK(lightex::utils::Arena::GetThreadCachedBytes() < cached_bytes);
+  }
+  BOOST_CHECK_EQUAL(lightex::utils::Arena::GetThreadCachedBytes(), cached_bytes);
+}
+
+BOOST_AUTO_TEST_CASE(TestRope) {
+  const auto to_string = [](const lightex::utils::Rope& rope) {
+    std::string text;
+    rope.AppendTo(&text);
+    return text;
+  };
+
+  const std::string long_text(1000, 'x');
+  const lightex::utils::Rope referenced = lightex::utils::Rope::Reference(long_text.data(), long_text.size());
+  const lightex::utils::Rope owned(lightex::utils::ArenaString(" \n "));
+  BOOST_CHECK(owned.IsBlank());
+
+  // Long joins keep their parts, short ones are flattened.
+  lightex::utils::RopeBuilder builder;
+  builder.Append(referenced);
+  builder.Append(owned);
+  builder.Append(lightex::utils::Rope());
+  builder.Append(lightex::utils::Rope::Reference("y"));
+  lightex::utils::Rope joined = builder.Build();
+  BOOST_CHECK_EQUAL(joined.size(), 1004);
+  BOOST_CHECK_EQUAL(to_string(joined), long_text + " \n y");
+  BOOST_CHECK(!joined.IsBlank());
+  int fragments_num = 0;
+  joined.ForEachFragment([&fragments_num](const char* data, std::size_t size) { return ++fragments_num < 2; });
+  BOOST_CHECK_EQUAL(fragments_num, 2);
+
+  builder.Append(owned);
+  builder.Append(lightex::utils::Rope::Reference("y"));
+  BOOST_CHECK_EQUAL(to_string(builder.Build()), " \n y");
+
+  // Deep joins are flattened, so traversing them takes a bounded stack.
+  for (int i = 0; i < 1000; ++i) {
+    builder.Append(lightex::utils::Rope::Reference("<"));
+    builder.Append(joined);
+    builder.Append(lightex::utils::Rope::Reference(">"));
+    joined = builder.Build();
+  }
+  BOOST_CHECK_EQUAL(joined.size(), 3004);
+  BOOST_CHECK_EQUAL(to_string(joined), std::string(1000, '<') + long_text + " \n y" + std::string(1000, '>'));
+
+  lightex::utils::Rope moved = std::move(joined);
+  BOOST_CHECK(joined.empty());
+  BOOST_CHECK_EQUAL(moved.size(), 3004);
+}
+
+BOOST_AUTO_TEST_CASE(TestLexer) {
+  const std::string input =
+      "\\newcommand{\\x}[1]{#1 ##2}% c\n\\x[a]{\\% $\\$y$}\n \n\n$$z$$ --\\begin{verbatim}{v}$\\end{verbatim}#";
+
+  std::vector<lightex::lexer::Token> tokens;
+  std::string error_message;
+  BOOST_CHECK(lightex::lexer::Tokenize(input, &tokens, &error_message));
+
+  std::string output;
+  std::uint32_t expected_first = 0;
+  for (const auto& token : tokens) {
+    BOOST_CHECK_EQUAL(token.first, expected_first);
+    expected_first = token.last;
+    output += lightex::lexer::GetTokenTypeName(token.type);
+    output += "(" + input.substr(token.first, token.last - token.first) + ") ";
+  }
+  BOOST_CHECK_EQUAL(expected_first, input.size());
+  BOOST_CHECK_EQUAL(output,
+                    "COMMAND_NAME(\\newcommand) OPEN_BRACE({) COMMAND_NAME(\\x) CLOSE_BRACE(}) OPEN_BRACKET([) TEXT(1) "
+                    "CLOSE_BRACKET(]) OPEN_BRACE({) ARGUMENT_REF(#1) TEXT( ) OUTER_ARGUMENT_REF(##2) CLOSE_BRACE(}) "
+                    "COMMENT(% c\n) COMMAND_NAME(\\x) OPEN_BRACKET([) TEXT(a) CLOSE_BRACKET(]) OPEN_BRACE({) "
+                    "CONTROL_SYMBOL(\\%) TEXT( ) MATH_DELIMITER($) MATH_TEXT(\\$y) MATH_DELIMITER($) CLOSE_BRACE(}) "
+                    "PARAGRAPH_BREAK(\n \n\n) DISPLAY_MATH_DELIMITER($$) MATH_TEXT(z) DISPLAY_MATH_DELIMITER($$) "
+                    "TEXT( --) COMMAND_NAME(\\begin) OPEN_BRACE({) TEXT(verbatim) CLOSE_BRACE(}) "
+                    "VERBATIM_TEXT({v}$) COMMAND_NAME(\\end) OPEN_BRACE({) TEXT(verbatim) CLOSE_BRACE(}) TEXT(#) ");
+}
+
+BOOST_AUTO_TEST_CASE(TestParallelParsing) {
+  std::string input = "\\newcommand{\\x}[2][a]{#1-#2}\n\n";
+  for (int i = 0; i < 3000; ++i) {
+    input += "Paragraph " + std::to_string(i) + " with \\x{$y$} and % a comment\n\\x{b}\n \n\n";
+    input += "\\begin{verbatim}\n\n\\end{verbatim}\n\n\\unescaped{\n\n<p>}\\x\n\n{c}\n\n";
+  }
+
+  std::vector<std::size_t> chunk_offsets;
+  BOOST_CHECK(lightex::lexer::SplitAtTopLevelParagraphBreaks(input, 4, 1024, &chunk_offsets));
+  BOOST_CHECK_EQUAL(chunk_offsets.size(), 5);
+
+  std::string error_message;
+  std::string expected_output;
+  BOOST_CHECK(lightex::MakeJsonAstWorkspace()->ParseProgram(input, &error_message, &expected_output));
+
+  auto engine = std::make_shared<lightex::engine::Engine>();
+  engine->SetParsingThreadsNum(4);
+  std::shared_ptr<lightex::Workspace> workspace =
+      lightex::MakeWorkspace(engine, lightex::backends::MakeJsonAstBackend(-1));
+  std::string output;
+  BOOST_CHECK(workspace->ParseProgram(input, &error_message, &output));
+  BOOST_CHECK(output == expected_output);
+
+  // A chunk which fails to parse on its own makes the whole input parse serially.
+  input += "\\x{d}\n\n[e]";
+  std::string expected_error_message;
+  BOOST_CHECK(!lightex::MakeJsonAstWorkspace()->ParseProgram(input, &expected_error_message, &expected_output));
+  BOOST_CHECK(!workspace->ParseProgram(input, &error_message, &output));
+  BOOST_CHECK_EQUAL(error_message, expected_error_message);
+}
+
+BOOST_AUTO_TEST_CASE(TestStreaming) {
+  std::string input = "\\newcommand{\\x}[2][a]{#1-#2}\\newenvironment{e}{(}{)}\r\n\r\n";
+  for (int i = 0; i < 3000; ++i) {
+    input += "Paragraph " + std::to_string(i) + " with \\x{$y$} caf\xc3\xa9 and % a comment\n\\x{b}\n \n\n";
+    input += "\\begin{verbatim}\n\n\\end{verbatim}\r\n\r\n\\unescaped{\n\n<p>}\\x\n\n{c}\n\n";
+    input += "\\begin{e}\n\n\\newcommand{\\z}{z}\\z\n\n\\end{e}\n\n";
+  }
+
+  std::string error_message;
+  std::string expected_output;
+  BOOST_CHECK(lightex::MakeHtmlWorkspace()->ParseProgram(input, &error_message, &expected_output));
+
+  lightex::stream_renderer::StreamRenderer renderer(std::make_shared<lightex::engine::Engine>());
+  std::istringstream in(input);
+  std::ostringstream out;
+  BOOST_CHECK(renderer.Render(&in, &out, &error_message));
+  BOOST_CHECK(out.str() == expected_output);
+
+  // Invalid bytes are reported at their offset in the whole input.
+  std::string expected_error_message;
+  BOOST_CHECK(!lightex::MakeHtmlWorkspace()->ParseProgram(input + "\xff", &expected_error_message, &expected_output));
+  std::istringstream invalid_in(input + "\xff");
+  BOOST_CHECK(!renderer.Render(&invalid_in, &out, &error_message));
+  BOOST_CHECK_EQUAL(error_message, expected_error_message);
+
+  std::istringstream unparsable_in(input + "\\x{d}\n\n[e]");
+  BOOST_CHECK(!renderer.Render(&unparsable_in, &out, &error_message));
+
+  // A block that keeps failing to parse is reported without reading the rest of the input.
+  const std::string long_unparsable_input = "[e]\n\n" + input + input + input + input;
+  std::istringstream long_unparsable_in(long_unparsable_input);
+  BOOST_CHECK(!renderer.Render(&long_unparsable_in, &out, &error_message));
+  BOOST_CHECK(!long_unparsable_in.eof());
+  BOOST_CHECK(long_unparsable_in.tellg() < static_cast<std::streamoff>(long_unparsable_input.size() / 2));
+}
+
+BOOST_AUTO_TEST_CASE(TestBlockPatches) {
+  lightex::patch_renderer::PatchRenderer renderer(std::make_shared<lightex::engine::Engine>());
+  const auto check = [&renderer](const std::string& input, const std::string& expected_patch) {
+    std::string error_message;
+    std::string patch;
+    BOOST_CHECK(renderer.ParseProgramToPatch("doc", input, &error_message, &patch));
+    BOOST_CHECK_EQUAL(patch, expected_patch);
+  };
+
+  check("\\newcommand{\\x}{X}a\n\nb \\x\n\nc",
+        "{\"op\":\"insert\",\"id\":1,\"after\":0,\"html\":\"<p>a</p>\"}\n"
+        "{\"op\":\"insert\",\"id\":2,\"after\":1,\"html\":\"<p>b X</p>\"}\n"
+        "{\"op\":\"insert\",\"id\":3,\"after\":2,\"html\":\"<p>c</p>\"}\n");
+  check("\\newcommand{\\x}{X}a\n\nb \\x\n\nc", "");
+  check("\\newcommand{\\x}{X}a\n\nb \\x\\x\n\nc", "{\"op\":\"replace\",\"id\":2,\"html\":\"<p>b XX</p>\"}\n");
+  check("\\newcommand{\\x}{X}a\n\nb \\x\\x\n\n\\x\n\nc",
+        "{\"op\":\"insert\",\"id\":4,\"after\":2,\"html\":\"<p>X</p>\"}\n");
+  check("\\newcommand{\\x}{X}b \\x\\x\n\n\\x\n\nc", "{\"op\":\"remove\",\"id\":1}\n");
+  check("\\newcommand{\\x}{X}c\n\nb \\x\\x\n\n\\x",
+        "{\"op\":\"remove\",\"id\":3}\n"
+        "{\"op\":\"insert\",\"id\":5,\"after\":0,\"html\":\"<p>c</p>\"}\n");
+
+  // A failed render keeps the previous one, and other documents have renders of their own.
+  std::string error_message;
+  std::string patch;
+  BOOST_CHECK(!renderer.ParseProgramToPatch("doc", "\\undefined", &error_message, &patch));
+  check("\\newcommand{\\x}{X}c\n\nb \\x\\x\n\n\\x", "");
+  BOOST_CHECK(renderer.ParseProgramToPatch("other", "c", &error_message, &patch));
+  BOOST_CHECK_EQUAL(patch, "{\"op\":\"insert\",\"id\":1,\"after\":0,\"html\":\"<p>c</p>\"}\n");
+
+  // Math formulas are numbered within their blocks, so adding one leaves the other blocks as they were.
+  BOOST_CHECK(renderer.ParseProgramToPatch("math", "intro\n\n$a$\n\n$b$", &error_message, &patch));
+  BOOST_CHECK(patch.find("mathTextSpan3-1") != std::string::npos);
+  BOOST_CHECK(renderer.ParseProgramToPatch("math", "intro $x$\n\n$a$\n\n$b$", &error_message, &patch));
+  BOOST_CHECK_EQUAL(patch.find("{\"op\":\"replace\",\"id\":1,"), 0);
+  BOOST_CHECK_EQUAL(patch.find('\n'), patch.size() - 1);
+  BOOST_CHECK(patch.find("mathTextSpan1-1") != std::string::npos);
+  BOOST_CHECK(renderer.ParseProgramToPatch("math", "$y$\n\nintro $x$\n\n$a$\n\n$b$", &error_message, &patch));
+  BOOST_CHECK_EQUAL(patch.find("{\"op\":\"insert\",\"id\":4,\"after\":0,"), 0);
+  BOOST_CHECK_EQUAL(patch.find('\n'), patch.size() - 1);
+  BOOST_CHECK(patch.find("mathTextSpan4-1") != std::string::npos);
+
+  renderer.ForgetDocument("doc");
+  check("c \\&", "{\"op\":\"insert\",\"id\":1,\"after\":0,\"html\":\"<p>c &amp;</p>\"}\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestOutputWriter) {
+  // Short fragments are copied and long ones referenced, in batches larger than a single writev(2) takes.
+  std::vector<std::string> fragments;
+  std::string expected_output;
+  for (int i = 0; i < 5000; ++i) {
+    fragments.push_back(std::string(i % 7 == 0 ? 1000 + i : i % 50, static_cast<char>('a' + i % 26)));
+    expected_output += fragments.back();
+  }
+
+  const std::string output_path = "lightex_test_output.txt";
+  {
+    lightex::utils::OutputFile output_file(output_path);
+    BOOST_REQUIRE(output_file.Open());
+    lightex::utils::OutputWriter writer(output_file.GetFd());
+    for (const std::string& fragment : fragments) {
+      writer.Append(fragment);
+    }
+    BOOST_CHECK(writer.Flush());
+    BOOST_CHECK(output_file.Commit());
+  }
+
+  std::string output;
+  BOOST_CHECK(lightex::utils::ReadDataFromFile(output_path, &output));
+  BOOST_CHECK(output == expected_output);
+
+  // Output files which aren't committed leave the existing file as it was.
+  {
+    lightex::utils::OutputFile output_file(output_path);
+    BOOST_REQUIRE(output_file.Open());
+    lightex::utils::OutputWriter writer(output_file.GetFd());
+    writer.Append(fragments[0]);
+    BOOST_CHECK(writer.Flush());
+  }
+  output.clear();
+  BOOST_CHECK(lightex::utils::ReadDataFromFile(output_path, &output));
+  BOOST_CHECK(output == expected_output);
+  std::remove(output_path.c_str());
+
+  std::ostringstream out;
+  lightex::utils::OutputWriter stream_writer(&out);
+  for (const std::string& fragment : fragments) {
+    stream_writer.Append(fragment);
+  }
+  BOOST_CHECK(stream_writer.Flush());
+  BOOST_CHECK(out.str() == expected_output);
+
+  lightex::utils::OutputWriter failing_writer(-1);
+  failing_writer.Append(fragments[1]);
+  BOOST_CHECK(!failing_writer.Flush());
+  BOOST_CHECK(!failing_writer.GetErrorMessage().empty());
+
+  // Renders written to a writer are the same as the ones returned.
+  const std::string input = "\\newcommand{\\x}[1]{<#1>}\n\na \\x{b} $c$ \\begin{verbatim}d\\end{verbatim}";
+  for (const auto& workspace : {lightex::MakeHtmlWorkspace(), lightex::MakeDotWorkspace()}) {
+    std::string error_message;
+    std::string expected_render;
+    BOOST_CHECK(workspace->ParseProgram(input, &error_message, &expected_render));
+
+    std::ostringstream render_out;
+    lightex::utils::OutputWriter render_writer(&render_out);
+    BOOST_CHECK(workspace->ParseProgramToWriter(input, &render_writer, &error_message));
+    BOOST_CHECK_EQUAL(render_out.str(), expected_render);
+    BOOST_CHECK(!workspace->ParseProgramToWriter("{", &render_writer, &error_message));
+  }
+}
+
+// Outputs the number of top-level nodes of the program.
+class NodesNumBackend : public lightex::backends::Backend {
+ public:
+  bool Render(const lightex::engine::Engine& engine,
+              const lightex::style_cache::CompiledStyle& style,
+              const lightex::ast::SymbolTable& symbol_table,
+              const lightex::ast::Program& ast,
+              std::string* error_message,
+              std::string* output) const override {
+    *output = std::to_string(ast.nodes.size());
+    return true;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(TestMultipleBackends) {
+  const std::string input = "\\newcommand{\\x}[1]{<#1>}\n\na \\x{b} $c$";
+  lightex::backends::FanOut fan_out(std::make_shared<lightex::engine::Engine>());
+  fan_out.AddBackend(lightex::backends::MakeHtmlBackend());
+  fan_out.AddBackend(lightex::backends::MakeDotBackend());
+  fan_out.AddBackend(lightex::backends::MakeJsonAstBackend(-1));
+  fan_out.AddBackend(lightex::backends::MakeHtmlBackend());
+  fan_out.AddBackend(std::make_shared<NodesNumBackend>());
+
+  std::string error_message;
+  std::vector<std::string> expected_outputs(5);
+  BOOST_CHECK(lightex::MakeHtmlWorkspace()->ParseProgram(input, &error_message, &expected_outputs[0]));
+  BOOST_CHECK(lightex::MakeDotWorkspace()->ParseProgram(input, &error_message, &expected_outputs[1]));
+  BOOST_CHECK(lightex::MakeJsonAstWorkspace()->ParseProgram(input, &error_message, &expected_outputs[2]));
+  expected_outputs[3] = expected_outputs[0];
+  expected_outputs[4] = "3";
+
+  for (bool is_parallel : {false, true}) {
+    std::vector<std::string> outputs;
+    BOOST_CHECK(fan_out.ParseProgram(input, is_parallel, &error_message, &outputs));
+    BOOST_CHECK(outputs == expected_outputs);
+  }
+
+  // Rendering fails on an unknown macro, and so does the whole call.
+  std::vector<std::string> outputs;
+  BOOST_CHECK(!fan_out.ParseProgram("\\y", true, &error_message, &outputs));
+  BOOST_CHECK(outputs.empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestTextExtraction) {
+  const auto check = [](const std::string& input, const std::string& expected_output) {
+    std::string error_message;
+    std::string output;
+    BOOST_CHECK(lightex::MakeTextWorkspace()->ParseProgram(input, &error_message, &output));
+    BOOST_CHECK_EQUAL(output, expected_output);
+  };
+
+  check("hello  \n world\n\n\nagain", "hello world\nagain\n");
+  check("a~b --- c &frac12; \\&", "a\u00a0b \u2014 c \u00bd &\n");
+  check("\\&lt; &lt;", "&lt; <\n");
+  check("\\newcommand{\\b}[1]{\\unescaped{<b class=\"x\">}#1\\unescaped{</b>...}}\\b{bold} $x^2$ $$\\sum$$",
+        "bold... x^2\n\\sum\n");
+  check("\\newenvironment{e}[1]{\\newcommand{\\i}{*}(#1)}{.}\\begin{e}{t}\\i x\\end{e}", "(t)* x\n.");
+  check("\\begin{verbatim}  a  b\\end{verbatim}", "  a  b\n");
+
+  std::string error_message;
+  std::string output;
+  BOOST_CHECK(!lightex::MakeTextWorkspace()->ParseProgram("\\undefined", &error_message, &output));
+  BOOST_CHECK_EQUAL(error_message, "Command macro undefined is not defined yet.");
+
+  // Recursive macros fail as they do in HTML renders.
+  BOOST_CHECK(!lightex::MakeTextWorkspace()->ParseProgram("\\newcommand{\\r}{\\r}\\r", &error_message, &output));
+  BOOST_CHECK_EQUAL(error_message, "Command macro r is nested deeper than 1024 expansions.");
+  BOOST_CHECK(!lightex::MakeTextWorkspace()->ParseProgram("\\newenvironment{e}{\\begin{e}\\end{e}}{}\\begin{e}\\end{e}",
+                                                          &error_message, &output));
+  BOOST_CHECK_EQUAL(error_message, "Environment macro e is nested deeper than 1024 expansions.");
+}
+
+BOOST_AUTO_TEST_CASE(TestMacroProfiling) {
+  auto engine = std::make_shared<lightex::engine::Engine>();
+  std::shared_ptr<lightex::Workspace> workspace = lightex::MakeWorkspace(engine, lightex::backends::MakeHtmlBackend());
+  auto macro_profiler = std::make_shared<lightex::html_converter::MacroProfiler>(true);
+  engine->SetMacroProfiler(macro_profiler);
+  std::string error_message;
+  std::string output;
+  BOOST_CHECK(workspace->ParseProgram(
+      "\\newcommand{\\x}[1]{<#1>}\\newenvironment{e}{(}{)}\\begin{e}\\x{a}\\x{b}\\end{e}", &error_message, &output));
+
+  std::ostringstream report;
+  macro_profiler->WriteReport(&report);
+  std::istringstream report_lines(report.str());
+  std::string line;
+  std::map<std::string, std::string> calls_nums;
+  std::getline(report_lines, line);
+  BOOST_CHECK_EQUAL(line, "macro\tcalls\tinclusive_ms\texclusive_ms\tbytes");
+  while (std::getline(report_lines, line)) {
+    std::istringstream fields(line);
+    std::string name;
+    fields >> name >> calls_nums[name];
+  }
+  BOOST_CHECK_EQUAL(calls_nums.size(), 2);
+  BOOST_CHECK_EQUAL(calls_nums["\\x"], "2");
+  BOOST_CHECK_EQUAL(calls_nums["\\begin{e}"], "1");
+
+  std::ostringstream trace;
+  macro_profiler->WriteChromeTrace(&trace);
+  BOOST_CHECK(trace.str().find("{\"name\":\"\\\\begin{e}\",\"ph\":\"X\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(TestUtf8Input) {
+  Tester t;
+  t.check("\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82,  \xe2\x80\x94 \xf0\x9f\x98\x80",
+          "<p>\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82, \xe2\x80\x94 \xf0\x9f\x98\x80</p>");
+  t.check("\\newcommand{\\x}[1]{\xd0\xb0#1}\\x{\xd0\xb1}", "<p>\xd0\xb0\xd0\xb1</p>");
+  t.check("a\r\n\r\nb\rc", "<p>a</p><p>b c</p>");
+
+  t.fail("\x80");
+  t.fail("\xc0\xaf");
+  t.fail("\xed\xa0\x80");
+  t.fail("\xf4\x90\x80\x80");
+  t.fail("\xd0");
+
+  std::shared_ptr<lightex::Workspace> workspace = lightex::MakeHtmlWorkspace();
+  std::string error_message;
+  std::string output;
+  BOOST_CHECK(!workspace->ParseProgram("\xd0\xb0\r\n\xe2\x80", &error_message, &output));
+  BOOST_CHECK_EQUAL(error_message, "Input is not valid UTF-8! Invalid byte sequence at offset 4");
+}
+
+BOOST_AUTO_TEST_CASE(TestSymbolInterning) {
+  lightex::ast::SymbolTable symbol_table;
+  const lightex::ast::SymbolId x = symbol_table.Intern("x");
+  BOOST_CHECK_EQUAL(symbol_table.Intern("y"), x + 1);
+  BOOST_CHECK_EQUAL(symbol_table.Intern("x"), x);
+  BOOST_CHECK_EQUAL(symbol_table.GetName(x), "x");
+  BOOST_CHECK_EQUAL(symbol_table.GetSize(), 2);
+
+  // Tables made on top of another one only store the names the base doesn't have.
+  lightex::ast::SymbolTable request_symbol_table(&symbol_table);
+  BOOST_CHECK_EQUAL(request_symbol_table.Intern("y"), x + 1);
+  const lightex::ast::SymbolId z = request_symbol_table.Intern("z");
+  BOOST_CHECK_EQUAL(z, x + 2);
+  BOOST_CHECK_EQUAL(request_symbol_table.GetName(x), "x");
+  BOOST_CHECK_EQUAL(request_symbol_table.GetName(z), "z");
+  BOOST_CHECK_EQUAL(request_symbol_table.GetSize(), 3);
+  BOOST_CHECK_EQUAL(symbol_table.GetSize(), 2);
+
+  std::string error_message;
+  std::string output;
+  BOOST_CHECK(lightex::MakeDotWorkspace()->ParseProgram("\\begin{a}\\b\\end{a}", &error_message, &output));
+  BOOST_CHECK(output.find("ENVIRONMENT = <name=a end_name=a>") != std::string::npos);
+  BOOST_CHECK(output.find("COMMAND = <name=b>") != std::string::npos);
+
+  std::shared_ptr<lightex::Workspace> workspace = lightex::MakeHtmlWorkspace();
+  BOOST_CHECK(!workspace->ParseProgram("\\begin{a}x\\end{b}", &error_message, &output));
+  BOOST_CHECK_EQUAL(error_message, "Environment name doesn't match the end name: a != b");
+  BOOST_CHECK(!workspace->ParseProgram("\\undefined", &error_message, &output));
+  BOOST_CHECK_EQUAL(error_message, "Command macro undefined is not defined yet.");
+}
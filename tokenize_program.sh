@@ -0,0 +1,3 @@
+#!/bin/bash
+
+./build/tokenize_program samples/input.tex samples/output.tokens.jsonl
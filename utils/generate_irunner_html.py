@@ -1,19 +1,24 @@
 #!/usr/bin/python
 
+import argparse
 import codecs
+import concurrent.futures
 import glob
+import hashlib
+import json
 import os
-import subprocess
 import sys
 
+import lightex
 
-def main():
-  root_path = sys.argv[1]
 
-  data_prefix = u'\\begin{rawproblem}{input.txt}{output.txt}\n'
-  data_suffix = u'\n\\end{rawproblem}\n'
+STYLE_PATH = 'lightex/styles/lightex.sty'
+MANIFEST_FILE_NAME = 'lightex-manifest.json'
+
+DATA_PREFIX = u'\\begin{rawproblem}{input.txt}{output.txt}\n'
+DATA_SUFFIX = u'\n\\end{rawproblem}\n'
 
-  result_template = u'''\
+RESULT_TEMPLATE = u'''\
       <!DOCTYPE html>
       <html>
           <head>
@@ -29,29 +34,124 @@ def main():
       </html>
       '''
 
-  for file_path in glob.glob('{}/**/*.tex'.format(root_path)):
-    file = codecs.open(file_path, 'r', 'utf-8')
-    data = data_prefix + file.read() + data_suffix
-    file.close()
 
-    temporary_tex_file = codecs.open('temp.tex', 'w', 'utf-8')
-    temporary_tex_file.write(data)
-    temporary_tex_file.close()
+def hash_file(file_path):
+  with open(file_path, 'rb') as file:
+    return hashlib.sha1(file.read()).hexdigest()
+
+
+def get_tool_version():
+  # Output depends on the converter library as well as on the way this script wraps its input and output.
+  tool_hash = hashlib.sha1()
+  tool_hash.update(hash_file(lightex.LIBRARY_PATH).encode('utf-8'))
+  tool_hash.update((DATA_PREFIX + DATA_SUFFIX + RESULT_TEMPLATE).encode('utf-8'))
+  return tool_hash.hexdigest()
+
+
+def load_manifest(manifest_path):
+  if not os.path.exists(manifest_path):
+    return {}
+
+  with open(manifest_path, 'r') as manifest_file:
+    try:
+      return json.load(manifest_file)
+    except ValueError:
+      # A broken manifest only means that everything gets rebuilt.
+      return {}
+
+
+def save_manifest(manifest_path, manifest):
+  temporary_manifest_path = manifest_path + '.tmp'
+  with open(temporary_manifest_path, 'w') as manifest_file:
+    json.dump(manifest, manifest_file, indent=2, sort_keys=True)
+  os.rename(temporary_manifest_path, manifest_path)
+
+
+# Returns 0 on success and 1 on failure, as the converter binary this script used to run did.
+def convert(workspace, file_path, html_file_path):
+  file = codecs.open(file_path, 'r', 'utf-8')
+  data = DATA_PREFIX + file.read() + DATA_SUFFIX
+  file.close()
+
+  try:
+    content = workspace.render(data)
+  except lightex.LightexError as error:
+    sys.stderr.write('{}: {}\n'.format(file_path, error))
+    return 1
+
+  problem_id = os.path.split(os.path.dirname(file_path))[1]
+  html_file = codecs.open(html_file_path, 'w', 'utf-8')
+  html_file.write(RESULT_TEMPLATE.format(problem_id=problem_id, content=content))
+  html_file.close()
+
+  return 0
+
+
+def main():
+  parser = argparse.ArgumentParser(description='Converts every problem statement under ROOT_PATH into lightex.html.')
+  parser.add_argument('root_path')
+  parser.add_argument('--dry-run', action='store_true', help='only list outputs that would be rebuilt or deleted')
+  parser.add_argument('--force', action='store_true', help='rebuild every output regardless of the manifest')
+  parser.add_argument('--jobs', type=int, default=os.cpu_count(), help='number of documents converted in parallel')
+  args = parser.parse_args()
+
+  # The manifest maps every output (relative to the root) to the hashes of everything it was built from.
+  manifest_path = os.path.join(args.root_path, MANIFEST_FILE_NAME)
+  manifest = load_manifest(manifest_path)
+
+  style_hash = hash_file(STYLE_PATH)
+  tool_version = get_tool_version()
+
+  source_html_paths = set()
+  conversions = []
+  for file_path in sorted(glob.glob('{}/**/*.tex'.format(args.root_path))):
+    html_file_path = '{}/lightex.html'.format(os.path.dirname(file_path))
+    html_key = os.path.relpath(html_file_path, args.root_path)
+    source_html_paths.add(html_key)
+
+    dependencies = {
+        'input_hash': hash_file(file_path),
+        'style_hash': style_hash,
+        'tool_version': tool_version,
+    }
+    if not args.force and manifest.get(html_key) == dependencies and os.path.exists(html_file_path):
+      continue
+
+    if args.dry_run:
+      print('rebuild {}'.format(file_path))
+      continue
+
+    conversions.append((file_path, html_file_path, html_key, dependencies))
+
+  # Documents are rendered in-process, by a single workspace shared between the threads.
+  if conversions:
+    with lightex.Workspace() as workspace:
+      workspace.load_style(STYLE_PATH)
+      with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        exit_codes = executor.map(lambda conversion: convert(workspace, conversion[0], conversion[1]), conversions)
+        for (file_path, _, html_key, dependencies), exit_code in zip(conversions, exit_codes):
+          if exit_code == 0:
+            manifest[html_key] = dependencies
+          else:
+            # Failed conversions are retried on the next run.
+            manifest.pop(html_key, None)
 
-    exit_code = subprocess.call(['./build/parse_program_to_html', 'temp.tex', 'temp.html'])
+          print('{} {}'.format(file_path, exit_code))
 
-    if exit_code == 0:
-      problem_id = os.path.split(os.path.dirname(file_path))[1]
-      temporary_html_file = codecs.open('temp.html', 'r', 'utf-8')
-      result = result_template.format(problem_id=problem_id, content=temporary_html_file.read())
-      temporary_html_file.close()
+  # Outputs whose source is gone are deleted, but only if they were produced by this script.
+  for html_key in sorted(set(manifest) - source_html_paths):
+    html_file_path = os.path.join(args.root_path, html_key)
+    if args.dry_run:
+      print('delete {}'.format(html_file_path))
+      continue
 
-      html_file_path = '{}/lightex.html'.format(os.path.dirname(file_path))
-      html_file = codecs.open(html_file_path, 'w', 'utf-8')
-      html_file.write(result)
-      html_file.close()
+    if os.path.exists(html_file_path):
+      os.remove(html_file_path)
+    del manifest[html_key]
+    print('{} deleted'.format(html_file_path))
 
-    print file_path, exit_code
+  if not args.dry_run:
+    save_manifest(manifest_path, manifest)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,230 @@
+#!/usr/bin/python
+
+# Generates lightex/symbols/symbol_tables.{h,cc}: minimal perfect hash tables for the lookup table symbols and the
+# named character references of HTML5. Run from the repository root after changing the lists below.
+
+import html.entities
+
+
+HEADER_PATH = 'lightex/symbols/symbol_tables.h'
+SOURCE_PATH = 'lightex/symbols/symbol_tables.cc'
+
+# Symbols replaced with HTML entities when they form a whole plain text node.
+LOOKUP_TABLE_SYMBOLS = [
+    ('\\,', '&thinsp;'),
+    ('~', '&nbsp;'),
+    ('---', '&mdash;'),
+    ('--', '&ndash;'),
+    ('<<', '&laquo;'),
+    ('>>', '&raquo;'),
+]
+
+# Legacy references without the trailing ';' aren't accepted by the grammar, so only the terminated forms are kept.
+HTML_ENTITY_CHARACTERS = {name[:-1]: value for name, value in html.entities.html5.items() if name.endswith(';')}
+HTML_ENTITY_NAMES = sorted(HTML_ENTITY_CHARACTERS)
+
+FNV_OFFSET_BASIS = 0x811c9dc5
+FNV_PRIME = 0x01000193
+
+HEADER_TEMPLATE = '''\
+// Generated by utils/generate_symbol_tables.py, do not edit.
+
+#pragma once
+
+#include <cstddef>
+
+namespace lightex {{
+namespace symbols {{
+
+const std::size_t kMaxLookupTableSymbolSize = {max_lookup_table_symbol_size};
+const std::size_t kMaxHtmlEntityNameSize = {max_html_entity_name_size};
+
+// Returns the HTML replacement of the lookup table symbol, e.g. "&mdash;" for "---", or nullptr if there is no such
+// symbol. Doesn't allocate.
+const char* FindLookupTableSymbol(const char* data, std::size_t size);
+
+// Returns the UTF-8 encoded characters which "&name;" stands for, e.g. "\u2014" for "mdash", or nullptr if it isn't a
+// named character reference of HTML5. |data| holds the name only. Doesn't allocate.
+const char* FindHtmlEntity(const char* data, std::size_t size);
+
+bool IsHtmlEntityName(const char* data, std::size_t size);
+
+}}  // namespace symbols
+}}  // namespace lightex
+'''
+
+SOURCE_TEMPLATE = '''\
+// Generated by utils/generate_symbol_tables.py, do not edit.
+
+#include <lightex/symbols/symbol_tables.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace lightex {{
+namespace symbols {{
+namespace {{
+
+// FNV-1a with a seeded offset basis, followed by the MurmurHash3 finalizer: the low bits of plain FNV-1a depend on
+// too few input bits for keys this short.
+inline std::uint32_t Hash(const char* data, std::size_t size, std::uint32_t seed) {{
+  std::uint32_t hash = 0x{offset_basis:08x}u ^ seed;
+  for (std::size_t i = 0; i < size; ++i) {{
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 0x{prime:08x}u;
+  }}
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}}
+
+// Hash and displace: the first hash picks a displacement, which is either the seed of the second hash or, if
+// negative, -1 - slot for buckets with a single key.
+template <std::size_t Size>
+std::size_t FindSlot(const std::int32_t (&displacements)[Size], const char* data, std::size_t size) {{
+  const std::int32_t displacement = displacements[Hash(data, size, 0) % Size];
+  if (displacement < 0) {{
+    return static_cast<std::size_t>(-1 - displacement);
+  }}
+  return Hash(data, size, static_cast<std::uint32_t>(displacement)) % Size;
+}}
+
+inline bool Equals(const char* key, const char* data, std::size_t size) {{
+  return std::strlen(key) == size && std::memcmp(key, data, size) == 0;
+}}
+'''
+
+SOURCE_FOOTER = '''\
+}}  // namespace
+
+const char* FindLookupTableSymbol(const char* data, std::size_t size) {{
+  if (size == 0 || size > kMaxLookupTableSymbolSize) {{
+    return nullptr;
+  }}
+
+  const std::size_t slot = FindSlot(kLookupTableSymbolDisplacements, data, size);
+  return Equals(kLookupTableSymbols[slot], data, size) ? kLookupTableSymbolReplacements[slot] : nullptr;
+}}
+
+const char* FindHtmlEntity(const char* data, std::size_t size) {{
+  if (size == 0 || size > kMaxHtmlEntityNameSize) {{
+    return nullptr;
+  }}
+
+  const std::size_t slot = FindSlot(kHtmlEntityNameDisplacements, data, size);
+  return Equals(kHtmlEntityNames[slot], data, size) ? kHtmlEntityCharacters[slot] : nullptr;
+}}
+
+bool IsHtmlEntityName(const char* data, std::size_t size) {{
+  return FindHtmlEntity(data, size) != nullptr;
+}}
+
+}}  // namespace symbols
+}}  // namespace lightex
+'''
+
+
+def fnv_hash(key, seed):
+  value = FNV_OFFSET_BASIS ^ seed
+  for byte in key.encode('utf-8'):
+    value ^= byte
+    value = (value * FNV_PRIME) & 0xffffffff
+  value ^= value >> 16
+  value = (value * 0x85ebca6b) & 0xffffffff
+  value ^= value >> 13
+  value = (value * 0xc2b2ae35) & 0xffffffff
+  value ^= value >> 16
+  return value
+
+
+def build_perfect_hash(keys):
+  size = len(keys)
+  buckets = [[] for _ in range(size)]
+  for key in keys:
+    buckets[fnv_hash(key, 0) % size].append(key)
+
+  displacements = [0] * size
+  slots = [None] * size
+  for bucket_index in sorted(range(size), key=lambda index: -len(buckets[index])):
+    bucket = buckets[bucket_index]
+    if len(bucket) <= 1:
+      break
+
+    seed = 1
+    while True:
+      bucket_slots = [fnv_hash(key, seed) % size for key in bucket]
+      if len(set(bucket_slots)) == len(bucket) and all(slots[slot] is None for slot in bucket_slots):
+        break
+      seed += 1
+
+    displacements[bucket_index] = seed
+    for key, slot in zip(bucket, bucket_slots):
+      slots[slot] = key
+
+  free_slots = [slot for slot in range(size) if slots[slot] is None]
+  for bucket_index in range(size):
+    if len(buckets[bucket_index]) == 1:
+      slot = free_slots.pop()
+      displacements[bucket_index] = -1 - slot
+      slots[slot] = buckets[bucket_index][0]
+
+  return displacements, slots
+
+
+def format_string(value):
+  # Octal escapes have at most three digits, so unlike hex ones they can't swallow the characters that follow.
+  result = '"'
+  for byte in value.encode('utf-8'):
+    if byte in b'\\"':
+      result += '\\' + chr(byte)
+    elif 0x20 <= byte < 0x7f:
+      result += chr(byte)
+    else:
+      result += '\\{:03o}'.format(byte)
+  return result + '"'
+
+
+def format_array(declaration, values, width=120):
+  lines = [declaration + ' = {']
+  line = '   '
+  for value in values:
+    item = ' ' + value + ','
+    if len(line) + len(item) > width:
+      lines.append(line)
+      line = '   '
+    line += item
+  lines.append(line)
+  lines.append('};')
+  return '\n'.join(lines) + '\n'
+
+
+def main():
+  lookup_keys = [symbol for symbol, _ in LOOKUP_TABLE_SYMBOLS]
+  replacements = dict(LOOKUP_TABLE_SYMBOLS)
+  lookup_displacements, lookup_slots = build_perfect_hash(lookup_keys)
+  entity_displacements, entity_slots = build_perfect_hash(HTML_ENTITY_NAMES)
+
+  parts = [SOURCE_TEMPLATE.format(offset_basis=FNV_OFFSET_BASIS, prime=FNV_PRIME), '\n']
+  parts.append(format_array('const std::int32_t kLookupTableSymbolDisplacements[]', map(str, lookup_displacements)))
+  parts.append(format_array('const char* const kLookupTableSymbols[]', map(format_string, lookup_slots)))
+  parts.append(format_array('const char* const kLookupTableSymbolReplacements[]',
+                            (format_string(replacements[symbol]) for symbol in lookup_slots)))
+  parts.append('\n')
+  parts.append(format_array('const std::int32_t kHtmlEntityNameDisplacements[]', map(str, entity_displacements)))
+  parts.append(format_array('const char* const kHtmlEntityNames[]', map(format_string, entity_slots)))
+  parts.append(format_array('const char* const kHtmlEntityCharacters[]',
+                            (format_string(HTML_ENTITY_CHARACTERS[name]) for name in entity_slots)))
+  parts.append(SOURCE_FOOTER.format())
+
+  with open(HEADER_PATH, 'w') as header_file:
+    header_file.write(HEADER_TEMPLATE.format(max_lookup_table_symbol_size=max(map(len, lookup_keys)),
+                                             max_html_entity_name_size=max(map(len, HTML_ENTITY_NAMES))))
+  with open(SOURCE_PATH, 'w') as source_file:
+    source_file.write(''.join(parts))
+
+
+if __name__ == '__main__':
+  main()
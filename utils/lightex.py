@@ -0,0 +1,165 @@
+#!/usr/bin/python
+
+# Python binding of the LighTeX C API (lightex/c_api/c_api.h). Renders in-process through liblightex_c, which is
+# looked up in LIGHTEX_LIBRARY or in build/ by default. ctypes releases the GIL during the calls, so one workspace can
+# render on several Python threads in parallel once its style is loaded.
+
+import ctypes
+import json
+import os
+
+
+LIBRARY_PATH = os.environ.get('LIGHTEX_LIBRARY', 'build/liblightex_c.so')
+API_VERSION = 2
+
+BACKEND_HTML = 0
+BACKEND_TEXT = 1
+BACKEND_DOT = 2
+BACKEND_JSON_AST = 3
+BACKEND_BINARY_AST = 4
+
+
+class LightexError(Exception):
+  pass
+
+
+class _StyleCacheStats(ctypes.Structure):
+  _fields_ = [
+      ('hits_num', ctypes.c_uint64),
+      ('misses_num', ctypes.c_uint64),
+      ('evictions_num', ctypes.c_uint64),
+      ('size_bytes', ctypes.c_uint64),
+      ('styles_num', ctypes.c_uint64),
+  ]
+
+
+_library = None
+
+
+def _load_library():
+  global _library
+  if _library is not None:
+    return _library
+
+  library = ctypes.CDLL(LIBRARY_PATH)
+  library.lightex_get_api_version.restype = ctypes.c_int
+  library.lightex_get_api_version.argtypes = []
+  if library.lightex_get_api_version() < API_VERSION:
+    raise LightexError('{} is older than the binding.'.format(LIBRARY_PATH))
+
+  # Returned buffers are declared as void pointers, so that ctypes keeps their address for lightex_free.
+  buffer_ptr = ctypes.POINTER(ctypes.c_void_p)
+  size_ptr = ctypes.POINTER(ctypes.c_size_t)
+
+  library.lightex_workspace_create.restype = ctypes.c_void_p
+  library.lightex_workspace_create.argtypes = [ctypes.c_int]
+  library.lightex_workspace_free.restype = None
+  library.lightex_workspace_free.argtypes = [ctypes.c_void_p]
+  library.lightex_workspace_load_style.restype = ctypes.c_int
+  library.lightex_workspace_load_style.argtypes = [ctypes.c_void_p, ctypes.c_char_p, buffer_ptr]
+  library.lightex_workspace_render.restype = ctypes.c_int
+  library.lightex_workspace_render.argtypes = [
+      ctypes.c_void_p, ctypes.c_char_p, ctypes.c_size_t, buffer_ptr, size_ptr, buffer_ptr]
+  library.lightex_workspace_render_with_style.restype = ctypes.c_int
+  library.lightex_workspace_render_with_style.argtypes = [
+      ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_size_t, buffer_ptr, size_ptr, buffer_ptr]
+  library.lightex_workspace_render_patch.restype = ctypes.c_int
+  library.lightex_workspace_render_patch.argtypes = [
+      ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_size_t, buffer_ptr, size_ptr, buffer_ptr]
+  library.lightex_workspace_forget_document.restype = None
+  library.lightex_workspace_forget_document.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+  library.lightex_workspace_get_style_cache_stats.restype = None
+  library.lightex_workspace_get_style_cache_stats.argtypes = [ctypes.c_void_p, ctypes.POINTER(_StyleCacheStats)]
+  library.lightex_free.restype = None
+  library.lightex_free.argtypes = [ctypes.c_void_p]
+
+  _library = library
+  return _library
+
+
+def _encode(text):
+  return text.encode('utf-8') if isinstance(text, str) else text
+
+
+class Workspace(object):
+  '''Renders TeX programs with one of the BACKEND_* backends, see lightex/workspace.h.'''
+
+  def __init__(self, backend=BACKEND_HTML):
+    self._library = _load_library()
+    self._backend = backend
+    self._workspace = self._library.lightex_workspace_create(backend)
+    if not self._workspace:
+      raise LightexError('Failed to create a workspace with backend {}.'.format(backend))
+
+  def __enter__(self):
+    return self
+
+  def __exit__(self, *args):
+    self.close()
+
+  def __del__(self):
+    self.close()
+
+  def close(self):
+    if getattr(self, '_workspace', None):
+      self._library.lightex_workspace_free(self._workspace)
+      self._workspace = None
+
+  def load_style(self, style_file_path):
+    error_message = ctypes.c_void_p()
+    if not self._library.lightex_workspace_load_style(
+        self._workspace, _encode(style_file_path), ctypes.byref(error_message)):
+      raise LightexError(self._take_string(error_message))
+
+  def render(self, program):
+    '''Returns the output of |program|, which is a str or UTF-8 bytes: bytes for BACKEND_BINARY_AST, str otherwise.'''
+    return self._render(lambda data, output, output_size, error_message: self._library.lightex_workspace_render(
+        self._workspace, data, len(data), output, output_size, error_message), program)
+
+  def render_with_style(self, style_file_path, program):
+    '''Same as render, but with the style in |style_file_path| alone instead of the loaded one.'''
+    return self._render(
+        lambda data, output, output_size, error_message: self._library.lightex_workspace_render_with_style(
+            self._workspace, _encode(style_file_path), data, len(data), output, output_size, error_message), program)
+
+  def render_patch(self, document_id, program):
+    '''Renders |program| as the new version of the document |document_id| and returns the list of operations turning
+    its previous render into the new one, e.g. {'op': 'insert', 'id': 2, 'after': 1, 'html': '<p>a</p>'}. Only for
+    BACKEND_HTML, see PatchRenderer::ParseProgramToPatch.'''
+    patch = self._render(lambda data, output, output_size, error_message: self._library.lightex_workspace_render_patch(
+        self._workspace, _encode(document_id), data, len(data), output, output_size, error_message), program)
+    return [json.loads(line) for line in patch.splitlines()]
+
+  def forget_document(self, document_id):
+    self._library.lightex_workspace_forget_document(self._workspace, _encode(document_id))
+
+  def get_style_cache_stats(self):
+    stats = _StyleCacheStats()
+    self._library.lightex_workspace_get_style_cache_stats(self._workspace, ctypes.byref(stats))
+    return {name: getattr(stats, name) for name, _ in _StyleCacheStats._fields_}
+
+  def _render(self, render_function, program):
+    output = ctypes.c_void_p()
+    output_size = ctypes.c_size_t()
+    error_message = ctypes.c_void_p()
+    if not render_function(_encode(program), ctypes.byref(output), ctypes.byref(output_size),
+                           ctypes.byref(error_message)):
+      raise LightexError(self._take_string(error_message))
+
+    data = self._take_buffer(output, output_size.value)
+    return data if self._backend == BACKEND_BINARY_AST else data.decode('utf-8')
+
+  def _take_buffer(self, buffer, size):
+    try:
+      return ctypes.string_at(buffer, size)
+    finally:
+      self._library.lightex_free(buffer)
+
+  def _take_string(self, buffer):
+    if not buffer:
+      return 'Unknown error.'
+
+    try:
+      return ctypes.string_at(buffer).decode('utf-8', 'replace')
+    finally:
+      self._library.lightex_free(buffer)
@@ -0,0 +1,54 @@
+#!/usr/bin/python
+
+# Writes the seed corpus of the fuzz target (lightex/binaries/fuzz_parse_program.cc) into the given directory: the
+# samples, the bundled styles and every string literal of the unit tests, one input per file named by its hash.
+
+import glob
+import hashlib
+import os
+import re
+import sys
+
+
+STRING_LITERAL_RE = re.compile(rb'"((?:[^"\\\n]|\\.)*)"')
+ESCAPE_SEQUENCE_RE = re.compile(rb'\\(x[0-9a-fA-F]{1,2}|.)')
+SIMPLE_ESCAPE_SEQUENCES = {b'n': b'\n', b'r': b'\r', b't': b'\t', b'0': b'\0'}
+
+
+def read_file(path):
+    with open(path, 'rb') as f:
+        return f.read()
+
+
+def decode_escape_sequence(match):
+    sequence = match.group(1)
+    if sequence.startswith(b'x') and len(sequence) > 1:
+        return bytes([int(sequence[1:], 16)])
+    return SIMPLE_ESCAPE_SEQUENCES.get(sequence, sequence)
+
+
+# Only the escape sequences the tests use are supported, the tests spell non-ASCII characters with \x escapes.
+def decode_string_literal(literal):
+    return ESCAPE_SEQUENCE_RE.sub(decode_escape_sequence, literal)
+
+
+def collect_seeds():
+    seeds = [read_file(path) for path in sorted(glob.glob('samples/*.tex') + glob.glob('lightex/styles/*.sty'))]
+    for path in sorted(glob.glob('tests/*.cc')):
+        seeds.extend(decode_string_literal(match.group(1)) for match in STRING_LITERAL_RE.finditer(read_file(path)))
+    return seeds
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit('Usage: utils/make_fuzz_corpus.py output_directory')
+
+    output_directory = sys.argv[1]
+    os.makedirs(output_directory, exist_ok=True)
+    for seed in collect_seeds():
+        with open(os.path.join(output_directory, hashlib.sha1(seed).hexdigest()), 'wb') as f:
+            f.write(seed)
+
+
+if __name__ == '__main__':
+    main()